@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeHistoryModel.h"
+#include "BikeHistoryStats.h"
+#include "Fillari.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QVector>
+#include <QtTest/QtTest>
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+#  include <QtCore/QRandomGenerator>
+#endif
+
+// ==========================================================================
+// BikeBench
+//
+// Synthetic histories look like the real thing (see BikeHistory.h),
+// newest rides first, spread over the riding seasons (April to October)
+// ending with the season of 2025. The random generator is seeded with
+// the same value every time, the results should be comparable between
+// the runs.
+// ==========================================================================
+
+class BikeBench :
+    public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int LAST_YEAR = 2025;
+    static const int RIDES_PER_DAY = 50;
+    static const int STATION_COUNT = 300;
+
+    class Random;
+
+    const QJsonArray& history(int);
+    static QJsonArray generate(int);
+    static void addCountData();
+
+private Q_SLOTS:
+    void stats_data();
+    void stats();
+    void model_data();
+    void model();
+    void years_data();
+    void years();
+    void format_data();
+    void format();
+
+private:
+    QHash<int,QJsonArray> iHistory;
+};
+
+// Seeded pseudo-random numbers
+class BikeBench::Random
+{
+public:
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    Random(quint32 aSeed) : iGenerator(aSeed) {}
+    int next(int aBound) { return int(iGenerator.bounded(aBound)); }
+private:
+    QRandomGenerator iGenerator;
+#else
+    Random(quint32 aSeed) { qsrand(aSeed); }
+    int next(int aBound) { return qrand() % aBound; }
+#endif
+};
+
+const QJsonArray&
+BikeBench::history(
+    int aCount)
+{
+    // Generating a million of rides takes a while, do it only once
+    if (!iHistory.contains(aCount)) {
+        iHistory.insert(aCount, generate(aCount));
+    }
+    return iHistory[aCount];
+}
+
+// static
+QJsonArray
+BikeBench::generate(
+    int aCount)
+{
+    const QString provider(QStringLiteral("helsinki-espoo"));
+    const QTime dayStart(6, 0);
+    const QDate lastDay(LAST_YEAR, 10, 31);
+    QStringList stations;
+    QDate day(lastDay);
+    QJsonArray history;
+    Random random(aCount);
+
+    stations.reserve(STATION_COUNT);
+    for (int i = 0; i < STATION_COUNT; i++) {
+        stations.append(QString(QStringLiteral("%1 Station %2")).
+            arg(i, 3, 10, QChar('0')).arg(i));
+    }
+
+    for (int i = 0; i < aCount; i++) {
+        if (i && !(i % RIDES_PER_DAY)) {
+            // Next (well, previous) day, skipping the winter
+            day = day.addDays(-1);
+            if (day.month() < 4) {
+                day = QDate(day.year() - 1, 10, 31);
+            }
+        }
+
+        // Rides are sorted, newest first
+        const int slot = RIDES_PER_DAY - 1 - (i % RIDES_PER_DAY);
+        const int duration = 60 + random.next(1800);
+        const QDateTime departure(QDateTime(day, dayStart, Qt::UTC).
+            addSecs(slot * (16 * 3600 / RIDES_PER_DAY) + random.next(60)));
+        QJsonObject entry;
+
+        entry.insert(QStringLiteral("bike"),
+            QString::number(random.next(2000)));
+        entry.insert(QStringLiteral("departureDate"),
+            departure.toString(Qt::ISODate));
+        entry.insert(QStringLiteral("departureStation"),
+            stations.at(random.next(STATION_COUNT)));
+        entry.insert(QStringLiteral("distance"),
+            duration * (2 + random.next(5)));
+        entry.insert(QStringLiteral("duration"), duration);
+        entry.insert(QStringLiteral("providerName"), provider);
+        entry.insert(QStringLiteral("returnDate"),
+            departure.addSecs(duration).toString(Qt::ISODate));
+        entry.insert(QStringLiteral("returnStation"),
+            stations.at(random.next(STATION_COUNT)));
+        history.append(entry);
+    }
+    return history;
+}
+
+// static
+void
+BikeBench::addCountData()
+{
+    QTest::addColumn<int>("count");
+    QTest::newRow("100") << 100;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("1M") << 1000000;
+}
+
+void
+BikeBench::stats_data()
+{
+    addCountData();
+}
+
+void
+BikeBench::stats()
+{
+    QFETCH(int, count);
+    const QJsonArray& all(history(count));
+
+    // Reading the total forces the (otherwise lazy) update. BikeHistoryStats
+    // attaches its index to the history, a fresh BikeHistory (which only
+    // shares the array, that's cheap) makes sure that each iteration
+    // actually aggregates the rides rather than adopting the index.
+    QBENCHMARK {
+        BikeHistory rides(all);
+        BikeHistoryStats stats;
+
+        stats.setYear(LAST_YEAR);
+        stats.setHistory(&rides);
+        QVERIFY(stats.total() > 0);
+    }
+}
+
+void
+BikeBench::model_data()
+{
+    const QVector<int> counts{100, 10000, 1000000};
+    const QVector<int> years{0, LAST_YEAR};
+    const QVector<int> months{0, 6};
+    const QVector<int> maxCounts{0, 3};
+
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("year");
+    QTest::addColumn<int>("month");
+    QTest::addColumn<int>("maxCount");
+
+    // count/year/month/maxCount, zero means no filtering
+    for (int i = 0; i < counts.count(); i++) {
+        for (int y = 0; y < years.count(); y++) {
+            for (int m = 0; m < months.count(); m++) {
+                for (int c = 0; c < maxCounts.count(); c++) {
+                    const QByteArray name(QString(QStringLiteral(
+                        "%1/%2/%3/%4")).arg(counts.at(i)).arg(years.at(y)).
+                        arg(months.at(m)).arg(maxCounts.at(c)).toLatin1());
+
+                    QTest::newRow(name.constData()) << counts.at(i) <<
+                        years.at(y) << months.at(m) << maxCounts.at(c);
+                }
+            }
+        }
+    }
+}
+
+void
+BikeBench::model()
+{
+    QFETCH(int, count);
+    QFETCH(int, year);
+    QFETCH(int, month);
+    QFETCH(int, maxCount);
+    BikeHistory rides(history(count));
+
+    // Filters are set first, while the model is still empty
+    QBENCHMARK {
+        BikeHistoryModel model;
+
+        model.setYear(year);
+        model.setMonth(month);
+        model.setMaxCount(maxCount);
+        model.setHistory(&rides);
+    }
+}
+
+void
+BikeBench::years_data()
+{
+    addCountData();
+}
+
+void
+BikeBench::years()
+{
+    QFETCH(int, count);
+    const QJsonArray& rides(history(count));
+
+    QBENCHMARK {
+        QVERIFY(!Fillari::years(rides).isEmpty());
+    }
+}
+
+void
+BikeBench::format_data()
+{
+    QTest::addColumn<int>("mode");
+    QTest::newRow("Rides") << int(BikeHistoryStats::Rides);
+    QTest::newRow("Distance") << int(BikeHistoryStats::Distance);
+    QTest::newRow("Duration") << int(BikeHistoryStats::Duration);
+}
+
+void
+BikeBench::format()
+{
+    QFETCH(int, mode);
+
+    // Covers all branches of Fillari::format
+    QBENCHMARK {
+        for (int value = 0; value < 100000; value += 7) {
+            Fillari::format(value, (BikeHistoryStats::Mode) mode);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(BikeBench)
+
+#include "BikeBench.moc"
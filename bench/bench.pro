@@ -0,0 +1,56 @@
+# Standalone benchmarks, don't require Sailfish OS SDK:
+#
+#   qmake && make && ./bench -o bench.xml,xml -o -,txt
+#
+# QtTest can also produce csv, lightxml and (since Qt 5.6) tap
+# and junitxml output, see ./bench -help
+
+TEMPLATE = app
+TARGET = bench
+CONFIG += console testcase
+CONFIG -= app_bundle
+QT = core testlib
+
+QMAKE_CXXFLAGS += -Wno-unused-parameter
+
+# Benchmarks are meaningless in debug build
+CONFIG -= debug
+CONFIG += release
+
+SRC_DIR = $${_PRO_FILE_PWD_}/../src
+HARBOUR_LIB_DIR = $${_PRO_FILE_PWD_}/../harbour-lib
+HARBOUR_LIB_INCLUDE = $${HARBOUR_LIB_DIR}/include
+HARBOUR_LIB_SRC = $${HARBOUR_LIB_DIR}/src
+
+INCLUDEPATH += \
+    $${SRC_DIR} \
+    $${HARBOUR_LIB_INCLUDE}
+
+HEADERS += \
+    $${HARBOUR_LIB_INCLUDE}/HarbourDebug.h \
+    $${HARBOUR_LIB_INCLUDE}/HarbourParentSignalQueueObject.h \
+    $${HARBOUR_LIB_INCLUDE}/HarbourTask.h \
+    $${SRC_DIR}/BikeAxisModel.h \
+    $${SRC_DIR}/BikeHistory.h \
+    $${SRC_DIR}/BikeHistoryModel.h \
+    $${SRC_DIR}/BikeHistoryStats.h \
+    $${SRC_DIR}/BikeRideStore.h \
+    $${SRC_DIR}/BikeSearchIndex.h \
+    $${SRC_DIR}/BikeSnapshot.h \
+    $${SRC_DIR}/BikeTimeBuckets.h \
+    $${SRC_DIR}/BikeTrace.h \
+    $${SRC_DIR}/Fillari.h
+
+SOURCES += \
+    $${HARBOUR_LIB_SRC}/HarbourTask.cpp \
+    $${SRC_DIR}/BikeAxisModel.cpp \
+    $${SRC_DIR}/BikeHistory.cpp \
+    $${SRC_DIR}/BikeHistoryModel.cpp \
+    $${SRC_DIR}/BikeHistoryStats.cpp \
+    $${SRC_DIR}/BikeRideStore.cpp \
+    $${SRC_DIR}/BikeSearchIndex.cpp \
+    $${SRC_DIR}/BikeSnapshot.cpp \
+    $${SRC_DIR}/BikeTimeBuckets.cpp \
+    $${SRC_DIR}/BikeTrace.cpp \
+    $${SRC_DIR}/Fillari.cpp \
+    BikeBench.cpp
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeMockServer.h"
+#include "BikeRequest.h"
+#include "BikeSession.h"
+#include "BikeTransport.h"
+
+#include <QtCore/QEventLoop>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTimer>
+#include <QtTest/QtTest>
+
+// ==========================================================================
+// BikeSessionBench
+//
+// Runs BikeSession against the local mock server (see BikeMockServer.h)
+// under each network profile, and with the replay transport which takes
+// the network out of the picture entirely. The fixtures come from
+// mock/data unless FILLARI_MOCK_DATA points elsewhere. Login isn't
+// covered, that requires the real login exchanges recorded with the
+// real credentials (see BikeTransport.h).
+// ==========================================================================
+
+class BikeSessionBench :
+    public QObject
+{
+    Q_OBJECT
+
+public:
+    static const int TIMEOUT = 30000; // ms
+    static const char REPLAY[];
+
+    static bool waitFor(BikeSession*, BikeSession::State);
+    static void addProfileData();
+    void setProfile();
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void coldStart_data();
+    void coldStart();
+    void refresh_data();
+    void refresh();
+
+private:
+    BikeMockServer iServer;
+    QScopedPointer<BikeTransport> iReplay;
+    QString iDataDir;
+};
+
+const char BikeSessionBench::REPLAY[] = "replay";
+
+// static
+bool
+BikeSessionBench::waitFor(
+    BikeSession* aSession,
+    BikeSession::State aState)
+{
+    QEventLoop loop;
+    QTimer timeout;
+
+    timeout.setSingleShot(true);
+    timeout.start(TIMEOUT);
+    connect(&timeout, SIGNAL(timeout()), &loop, SLOT(quit()));
+    connect(aSession, SIGNAL(sessionStateChanged()), &loop, SLOT(quit()));
+    while (aSession->sessionState() != aState && timeout.isActive()) {
+        switch (aSession->sessionState()) {
+        case BikeSession::Unauthorized:
+        case BikeSession::LoginFailed:
+        case BikeSession::LoginNetworkError:
+        case BikeSession::NetworkError:
+            // Not getting anywhere
+            return false;
+        default:
+            loop.exec();
+            break;
+        }
+    }
+    return aSession->sessionState() == aState;
+}
+
+// static
+void
+BikeSessionBench::addProfileData()
+{
+    QTest::addColumn<QString>("profile");
+    for (int i = 0; i < BikeMockServer::PROFILE_COUNT; i++) {
+        const char* name = BikeMockServer::PROFILES[i].iName;
+
+        QTest::newRow(name) << QString::fromLatin1(name);
+    }
+    QTest::newRow(REPLAY) << QString::fromLatin1(REPLAY);
+}
+
+void
+BikeSessionBench::setProfile()
+{
+    QFETCH(QString, profile);
+    if (profile == QLatin1String(REPLAY)) {
+        iReplay.reset(BikeTransport::newReplay(iDataDir));
+        BikeRequest::setTransport(iReplay.data());
+    } else {
+        BikeRequest::setTransport(Q_NULLPTR);
+        iServer.setProfile(BikeMockServer::profile(profile));
+        iServer.rewind();
+    }
+}
+
+void
+BikeSessionBench::initTestCase()
+{
+    iDataDir = QString::fromLocal8Bit(qgetenv("FILLARI_MOCK_DATA"));
+    if (iDataDir.isEmpty()) {
+        iDataDir = QStringLiteral(MOCK_DATA_DIR);
+    }
+    QVERIFY(iServer.load(iDataDir));
+    QVERIFY(iServer.listen());
+    BikeRequest::setServerUrls(iServer.url(), iServer.url());
+}
+
+void
+BikeSessionBench::cleanupTestCase()
+{
+    BikeRequest::setTransport(Q_NULLPTR);
+    iReplay.reset();
+}
+
+void
+BikeSessionBench::coldStart_data()
+{
+    addProfileData();
+}
+
+void
+BikeSessionBench::coldStart()
+{
+    setProfile();
+
+    // From nothing to the history on the screen
+    QBENCHMARK {
+        QTemporaryDir dataDir;
+        BikeSession session;
+
+        session.setDataDir(dataDir.path());
+        QVERIFY(waitFor(&session, BikeSession::Ready));
+    }
+}
+
+void
+BikeSessionBench::refresh_data()
+{
+    addProfileData();
+}
+
+void
+BikeSessionBench::refresh()
+{
+    QTemporaryDir dataDir;
+    BikeSession session;
+
+    setProfile();
+    session.setDataDir(dataDir.path());
+    QVERIFY(waitFor(&session, BikeSession::Ready));
+
+    QBENCHMARK {
+        session.refresh();
+        QVERIFY(waitFor(&session, BikeSession::Ready));
+    }
+    QVERIFY(session.history()->count() > 0);
+}
+
+QTEST_GUILESS_MAIN(BikeSessionBench)
+
+#include "BikeSessionBench.moc"
@@ -0,0 +1,88 @@
+# Headless BikeSession benchmarks against the local mock server,
+# don't require Sailfish OS SDK:
+#
+#   qmake && make && ./session-bench -o -,txt
+#
+# Fixtures are loaded from ../../mock/data, FILLARI_MOCK_DATA
+# environment variable can point to a different directory.
+
+TEMPLATE = app
+TARGET = session-bench
+CONFIG += console testcase
+CONFIG -= app_bundle
+QT = core network testlib
+
+QMAKE_CXXFLAGS += -Wno-unused-parameter
+
+# Benchmarks are meaningless in debug build
+CONFIG -= debug
+CONFIG += release
+
+SRC_DIR = $${_PRO_FILE_PWD_}/../../src
+MOCK_DIR = $${_PRO_FILE_PWD_}/../../mock
+HARBOUR_LIB_DIR = $${_PRO_FILE_PWD_}/../../harbour-lib
+HARBOUR_LIB_INCLUDE = $${HARBOUR_LIB_DIR}/include
+HARBOUR_LIB_SRC = $${HARBOUR_LIB_DIR}/src
+
+DEFINES += MOCK_DATA_DIR=\\\"$${MOCK_DIR}/data\\\"
+
+INCLUDEPATH += \
+    $${SRC_DIR} \
+    $${MOCK_DIR} \
+    $${HARBOUR_LIB_INCLUDE}
+
+HEADERS += \
+    $${HARBOUR_LIB_INCLUDE}/HarbourDebug.h \
+    $${HARBOUR_LIB_INCLUDE}/HarbourParentSignalQueueObject.h \
+    $${HARBOUR_LIB_INCLUDE}/HarbourTask.h \
+    $${MOCK_DIR}/BikeMockServer.h \
+    $${SRC_DIR}/BikeApp.h \
+    $${SRC_DIR}/BikeAxisModel.h \
+    $${SRC_DIR}/BikeConnection.h \
+    $${SRC_DIR}/BikeHistory.h \
+    $${SRC_DIR}/BikeHistoryModel.h \
+    $${SRC_DIR}/BikeHistoryQuery.h \
+    $${SRC_DIR}/BikeHistoryStats.h \
+    $${SRC_DIR}/BikeLatencyHistogram.h \
+    $${SRC_DIR}/BikeLogin.h \
+    $${SRC_DIR}/BikeLogout.h \
+    $${SRC_DIR}/BikeObjectQuery.h \
+    $${SRC_DIR}/BikeRecording.h \
+    $${SRC_DIR}/BikeRequest.h \
+    $${SRC_DIR}/BikeRideStore.h \
+    $${SRC_DIR}/BikeSearchIndex.h \
+    $${SRC_DIR}/BikeSession.h \
+    $${SRC_DIR}/BikeSessionLog.h \
+    $${SRC_DIR}/BikeSessionSummary.h \
+    $${SRC_DIR}/BikeSnapshot.h \
+    $${SRC_DIR}/BikeTimeBuckets.h \
+    $${SRC_DIR}/BikeTrace.h \
+    $${SRC_DIR}/BikeTransport.h \
+    $${SRC_DIR}/Fillari.h
+
+SOURCES += \
+    $${HARBOUR_LIB_SRC}/HarbourTask.cpp \
+    $${MOCK_DIR}/BikeMockServer.cpp \
+    $${SRC_DIR}/BikeAxisModel.cpp \
+    $${SRC_DIR}/BikeConnection.cpp \
+    $${SRC_DIR}/BikeHistory.cpp \
+    $${SRC_DIR}/BikeHistoryModel.cpp \
+    $${SRC_DIR}/BikeHistoryQuery.cpp \
+    $${SRC_DIR}/BikeHistoryStats.cpp \
+    $${SRC_DIR}/BikeLatencyHistogram.cpp \
+    $${SRC_DIR}/BikeLogin.cpp \
+    $${SRC_DIR}/BikeLogout.cpp \
+    $${SRC_DIR}/BikeObjectQuery.cpp \
+    $${SRC_DIR}/BikeRecording.cpp \
+    $${SRC_DIR}/BikeRequest.cpp \
+    $${SRC_DIR}/BikeRideStore.cpp \
+    $${SRC_DIR}/BikeSearchIndex.cpp \
+    $${SRC_DIR}/BikeSession.cpp \
+    $${SRC_DIR}/BikeSessionLog.cpp \
+    $${SRC_DIR}/BikeSessionSummary.cpp \
+    $${SRC_DIR}/BikeSnapshot.cpp \
+    $${SRC_DIR}/BikeTimeBuckets.cpp \
+    $${SRC_DIR}/BikeTrace.cpp \
+    $${SRC_DIR}/BikeTransport.cpp \
+    $${SRC_DIR}/Fillari.cpp \
+    BikeSessionBench.cpp
@@ -2,7 +2,7 @@ PREFIX = harbour
 NAME = fillari
 
 TARGET = $${PREFIX}-$${NAME}
-CONFIG += sailfishapp link_pkgconfig
+CONFIG += sailfishapp sailfishapp_no_deploy_qml link_pkgconfig
 PKGCONFIG += sailfishapp glib-2.0 gobject-2.0 gio-unix-2.0
 QT += network qml quick dbus
 
@@ -147,9 +147,11 @@ INCLUDEPATH += \
 
 HEADERS += \
     $${HARBOUR_LIB_INCLUDE}/HarbourDebug.h \
-    $${HARBOUR_LIB_INCLUDE}/HarbourParentSignalQueueObject.h
+    $${HARBOUR_LIB_INCLUDE}/HarbourParentSignalQueueObject.h \
+    $${HARBOUR_LIB_INCLUDE}/HarbourTask.h
 
 SOURCES += \
+    $${HARBOUR_LIB_SRC}/HarbourTask.cpp
 
 HARBOUR_QML_COMPONENTS = \
     $${HARBOUR_LIB_QML}/HarbourHighlightIcon.qml \
@@ -157,40 +159,81 @@ HARBOUR_QML_COMPONENTS = \
 
 OTHER_FILES += $${HARBOUR_QML_COMPONENTS}
 
-qml_components.files = $${HARBOUR_QML_COMPONENTS}
-qml_components.path = $${TARGET_DATA_DIR}/qml/harbour
-INSTALLS += qml_components
-
 # App
 
 HEADERS += \
     src/BikeApp.h \
+    src/BikeAxisModel.h \
+    src/BikeConnection.h \
+    src/BikeExport.h \
+    src/BikeHistory.h \
     src/BikeHistoryModel.h \
     src/BikeHistoryQuery.h \
     src/BikeHistoryStats.h \
+    src/BikeLatencyHistogram.h \
     src/BikeLogin.h \
     src/BikeLogout.h \
     src/BikeObjectQuery.h \
+    src/BikeRecording.h \
+    src/BikeRecords.h \
     src/BikeRequest.h \
+    src/BikeRideStore.h \
+    src/BikeRouteStats.h \
+    src/BikeSearchIndex.h \
     src/BikeSession.h \
+    src/BikeSessionLog.h \
+    src/BikeSessionSummary.h \
+    src/BikeSnapshot.h \
+    src/BikeTimeBuckets.h \
+    src/BikeTrace.h \
+    src/BikeTransport.h \
     src/BikeUser.h \
-    src/ToolTipItem.h \
-    src/Fillari.h
+    src/Fillari.h \
+    src/HistogramItem.h \
+    src/ToolTipItem.h
 
 SOURCES += \
+    src/BikeAxisModel.cpp \
+    src/BikeConnection.cpp \
+    src/BikeExport.cpp \
+    src/BikeHistory.cpp \
     src/BikeHistoryModel.cpp \
     src/BikeHistoryQuery.cpp \
     src/BikeHistoryStats.cpp \
+    src/BikeLatencyHistogram.cpp \
     src/BikeLogin.cpp \
     src/BikeLogout.cpp \
     src/BikeObjectQuery.cpp \
+    src/BikeRecording.cpp \
+    src/BikeRecords.cpp \
     src/BikeRequest.cpp \
+    src/BikeRideStore.cpp \
+    src/BikeRouteStats.cpp \
+    src/BikeSearchIndex.cpp \
     src/BikeSession.cpp \
+    src/BikeSessionLog.cpp \
+    src/BikeSessionSummary.cpp \
+    src/BikeSnapshot.cpp \
+    src/BikeTimeBuckets.cpp \
+    src/BikeTrace.cpp \
+    src/BikeTransport.cpp \
     src/BikeUser.cpp \
     src/Fillari.cpp \
+    src/HistogramItem.cpp \
     src/ToolTipItem.cpp \
     src/main.cpp
 
+# QML files and images are compiled into the executable. If the Qt Quick
+# compiler is available, QML gets compiled to native code at build time,
+# otherwise it's at least not loaded from the file system at startup.
+
+RESOURCES += \
+    $${TARGET}.qrc
+
+exists($$[QT_HOST_DATA]/mkspecs/features/qtquickcompiler.prf) {
+    CONFIG += qtquickcompiler
+}
+
 # Icons
 
 ICON_SIZES = 86 108 128 172 256
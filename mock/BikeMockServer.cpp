@@ -0,0 +1,426 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeMockServer.h"
+
+#include "BikeApp.h"
+#include "BikeRecording.h"
+
+#include <QtCore/QRegularExpression>
+#include <QtCore/QTimer>
+#include <QtNetwork/QHostAddress>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+#include "HarbourDebug.h"
+
+const BikeMockServer::Profile BikeMockServer::PROFILES[] = {
+    { "local", 0, 0 },
+    { "lte", 50, 1500000 },     // 12 Mbit/s
+    { "3g", 300, 200000 },      // 1.6 Mbit/s
+    { "recorded", -1, 0 }
+};
+
+const int BikeMockServer::PROFILE_COUNT =
+    sizeof(BikeMockServer::PROFILES)/sizeof(BikeMockServer::PROFILES[0]);
+
+// ==========================================================================
+// BikeMockServer::Private
+// ==========================================================================
+
+class BikeMockServer::Private :
+    public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef BikeRecording::Exchange Exchange;
+    typedef BikeRecording::Header Header;
+
+    Private(BikeMockServer*);
+
+    static QByteArray reasonPhrase(int);
+    static QByteArray stripCookie(const QByteArray&);
+
+    QByteArray url() const;
+    QByteArray rewrite(const QByteArray&) const;
+    QByteArray response(const Exchange*) const;
+    const Exchange* next(const QByteArray&, const QByteArray&);
+
+private Q_SLOTS:
+    void onNewConnection();
+
+public:
+    QTcpServer* iServer;
+    BikeRecording iRecording;
+    int iLatency;
+    int iBandwidth;
+    int iRequestCount;
+};
+
+BikeMockServer::Private::Private(
+    BikeMockServer* aParent) :
+    QObject(aParent),
+    iServer(new QTcpServer(this)),
+    iLatency(0),
+    iBandwidth(0),
+    iRequestCount(0)
+{
+    connect(iServer, SIGNAL(newConnection()), SLOT(onNewConnection()));
+}
+
+// static
+QByteArray
+BikeMockServer::Private::reasonPhrase(
+    int aStatus)
+{
+    switch (aStatus) {
+    case 200: return "OK";
+    case 302: return "Found";
+    case 401: return "Unauthorized";
+    case 403: return "Forbidden";
+    case 404: return "Not Found";
+    }
+    return "Unknown";
+}
+
+// static
+QByteArray
+BikeMockServer::Private::stripCookie(
+    const QByteArray& aCookie)
+{
+    // The mock server is plain http on localhost
+    static const QRegularExpression attributes("; *(Domain=[^;]*|Secure)",
+        QRegularExpression::CaseInsensitiveOption);
+
+    return QString::fromLatin1(aCookie).remove(attributes).toLatin1();
+}
+
+QByteArray
+BikeMockServer::Private::url() const
+{
+    return "http://127.0.0.1:" + QByteArray::number(iServer->serverPort());
+}
+
+QByteArray
+BikeMockServer::Private::rewrite(
+    const QByteArray& aData) const
+{
+    const QByteArray ourUrl(url());
+
+    return QByteArray(aData).
+        replace(BIKE_WWW_URL, ourUrl).
+        replace(BIKE_ID_URL, ourUrl);
+}
+
+QByteArray
+BikeMockServer::Private::response(
+    const Exchange* aExchange) const
+{
+    const int status = aExchange ? aExchange->iStatus : 404;
+    const QByteArray body(aExchange ? rewrite(aExchange->iBody) :
+        QByteArray("Not found"));
+    QByteArray out("HTTP/1.1 " + QByteArray::number(status) + ' ' +
+        reasonPhrase(status) + "\r\n");
+
+    if (aExchange) {
+        for (int i = 0; i < aExchange->iHeaders.count(); i++) {
+            const Header& header = aExchange->iHeaders.at(i);
+            const QByteArray name(header.first.toLower());
+
+            // These are recomputed (the recorded body is decoded)
+            if (name != "content-length" &&
+                name != "content-encoding" &&
+                name != "transfer-encoding" &&
+                name != "connection") {
+                QByteArray value(rewrite(header.second));
+
+                if (name == "set-cookie") {
+                    value = stripCookie(value);
+                }
+                out += header.first + ": " + value + "\r\n";
+            }
+        }
+    }
+
+    out += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    out += "Connection: keep-alive\r\n\r\n";
+    out += body;
+    return out;
+}
+
+const BikeMockServer::Private::Exchange*
+BikeMockServer::Private::next(
+    const QByteArray& aMethod,
+    const QByteArray& aTarget)
+{
+    iRequestCount++;
+    return iRecording.next(aMethod, aTarget);
+}
+
+// ==========================================================================
+// BikeMockServer::Connection
+// ==========================================================================
+
+class BikeMockServer::Connection :
+    public QObject
+{
+    Q_OBJECT
+
+public:
+    // Throttled output is written in chunks at this interval
+    static const int WRITE_INTERVAL = 50;
+
+    Connection(QTcpSocket*, Private*);
+
+    void processRequest();
+    void finishResponse();
+
+private Q_SLOTS:
+    void onReadyRead();
+    void onStartResponse();
+    void onWriteTimer();
+
+public:
+    Private* iServer;
+    QTcpSocket* iSocket;
+    QTimer* iWriteTimer;
+    QByteArray iInput;
+    QByteArray iOutput;
+    bool iBusy;
+};
+
+BikeMockServer::Connection::Connection(
+    QTcpSocket* aSocket,
+    Private* aServer) :
+    QObject(aSocket),
+    iServer(aServer),
+    iSocket(aSocket),
+    iWriteTimer(new QTimer(this)),
+    iBusy(false)
+{
+    iWriteTimer->setInterval(WRITE_INTERVAL);
+    connect(iWriteTimer, SIGNAL(timeout()), SLOT(onWriteTimer()));
+    connect(aSocket, SIGNAL(readyRead()), SLOT(onReadyRead()));
+}
+
+void
+BikeMockServer::Connection::onReadyRead()
+{
+    iInput.append(iSocket->readAll());
+    processRequest();
+}
+
+void
+BikeMockServer::Connection::processRequest()
+{
+    // One request at a time
+    const int headerEnd = iBusy ? -1 : iInput.indexOf("\r\n\r\n");
+
+    if (headerEnd >= 0) {
+        const QList<QByteArray> lines(iInput.left(headerEnd).split('\n'));
+        const QList<QByteArray> request(lines.first().trimmed().split(' '));
+        int contentLength = 0;
+
+        for (int i = 1; i < lines.count(); i++) {
+            const QByteArray line(lines.at(i).trimmed());
+            const int colon = line.indexOf(':');
+
+            if (colon > 0 && line.left(colon).trimmed().toLower() ==
+                "content-length") {
+                contentLength = line.mid(colon + 1).trimmed().toInt();
+            }
+        }
+
+        const int total = headerEnd + 4 + contentLength;
+
+        if (iInput.size() >= total) {
+            iInput.remove(0, total);
+            if (request.count() >= 2) {
+                const Private::Exchange* exchange =
+                    iServer->next(request.at(0), request.at(1));
+                const int latency = (iServer->iLatency >= 0) ?
+                    iServer->iLatency : exchange ? exchange->iTime : 0;
+
+                iBusy = true;
+                iOutput = iServer->response(exchange);
+                QTimer::singleShot(latency, this, SLOT(onStartResponse()));
+            } else {
+                HWARN("Bad request" << lines.first().constData());
+                iSocket->disconnectFromHost();
+            }
+        }
+    }
+}
+
+void
+BikeMockServer::Connection::onStartResponse()
+{
+    if (iServer->iBandwidth > 0) {
+        onWriteTimer();
+        if (iBusy) {
+            iWriteTimer->start();
+        }
+    } else {
+        iSocket->write(iOutput);
+        finishResponse();
+    }
+}
+
+void
+BikeMockServer::Connection::onWriteTimer()
+{
+    const int chunk = qMax(iServer->iBandwidth * WRITE_INTERVAL / 1000, 1);
+
+    iSocket->write(iOutput.constData(), qMin(chunk, iOutput.size()));
+    iOutput.remove(0, chunk);
+    if (iOutput.isEmpty()) {
+        iWriteTimer->stop();
+        finishResponse();
+    }
+}
+
+void
+BikeMockServer::Connection::finishResponse()
+{
+    iBusy = false;
+    iOutput.clear();
+    // The next request may already be there
+    processRequest();
+}
+
+// ==========================================================================
+// BikeMockServer::Private (continued)
+// ==========================================================================
+
+void
+BikeMockServer::Private::onNewConnection()
+{
+    while (iServer->hasPendingConnections()) {
+        QTcpSocket* socket = iServer->nextPendingConnection();
+
+        connect(socket, SIGNAL(disconnected()), socket, SLOT(deleteLater()));
+        new Connection(socket, this);
+    }
+}
+
+// ==========================================================================
+// BikeMockServer
+// ==========================================================================
+
+BikeMockServer::BikeMockServer(
+    QObject* aParent) :
+    QObject(aParent),
+    iPrivate(new Private(this))
+{}
+
+// static
+const BikeMockServer::Profile*
+BikeMockServer::profile(
+    const QString& aName)
+{
+    for (int i = 0; i < PROFILE_COUNT; i++) {
+        if (aName == QLatin1String(PROFILES[i].iName)) {
+            return PROFILES + i;
+        }
+    }
+    return Q_NULLPTR;
+}
+
+bool
+BikeMockServer::load(
+    const QString& aDir)
+{
+    if (iPrivate->iRecording.load(aDir)) {
+        rewind();
+        return true;
+    }
+    return false;
+}
+
+bool
+BikeMockServer::listen(
+    quint16 aPort)
+{
+    return iPrivate->iServer->listen(QHostAddress::LocalHost, aPort);
+}
+
+QString
+BikeMockServer::url() const
+{
+    return QString::fromLatin1(iPrivate->url());
+}
+
+void
+BikeMockServer::setProfile(
+    const Profile* aProfile)
+{
+    if (aProfile) {
+        iPrivate->iLatency = aProfile->iLatency;
+        iPrivate->iBandwidth = aProfile->iBandwidth;
+    }
+}
+
+void
+BikeMockServer::setLatency(
+    int aLatency)
+{
+    iPrivate->iLatency = aLatency;
+}
+
+void
+BikeMockServer::setBandwidth(
+    int aBandwidth)
+{
+    iPrivate->iBandwidth = qMax(aBandwidth, 0);
+}
+
+void
+BikeMockServer::rewind()
+{
+    iPrivate->iRecording.rewind();
+    iPrivate->iRequestCount = 0;
+}
+
+int
+BikeMockServer::requestCount() const
+{
+    return iPrivate->iRequestCount;
+}
+
+#include "BikeMockServer.moc"
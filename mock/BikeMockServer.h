@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_MOCK_SERVER_H
+#define BIKE_MOCK_SERVER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+// Local stand-in for the HSL servers. Serves the exchanges recorded in
+// the given directory (see BikeRecording.h for the format). The real
+// server URLs in the headers and bodies are replaced with the URL of
+// this server, cookies lose their Domain and Secure attributes.
+//
+// Latency (delay before the response starts) and bandwidth (bytes per
+// second, zero means unlimited) simulate the network. Negative latency
+// means to use the recorded response times.
+
+class BikeMockServer :
+    public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Profile {
+        const char* iName;
+        int iLatency;   // milliseconds
+        int iBandwidth; // bytes per second
+    };
+
+    static const Profile PROFILES[];
+    static const int PROFILE_COUNT;
+    static const Profile* profile(const QString&);
+
+    BikeMockServer(QObject* aParent = Q_NULLPTR);
+
+    bool load(const QString&);
+    bool listen(quint16 aPort = 0);
+    QString url() const;
+
+    void setProfile(const Profile*);
+    void setLatency(int);
+    void setBandwidth(int);
+    void rewind();
+
+    int requestCount() const;
+
+private:
+    class Connection;
+    class Private;
+    Private* iPrivate;
+};
+
+#endif // BIKE_MOCK_SERVER_H
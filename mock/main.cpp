@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeMockServer.h"
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QStringList>
+
+#include <stdio.h>
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCommandLineParser parser;
+    QStringList profiles;
+
+    for (int i = 0; i < BikeMockServer::PROFILE_COUNT; i++) {
+        profiles.append(QLatin1String(BikeMockServer::PROFILES[i].iName));
+    }
+
+    const QCommandLineOption portOption(QStringList() << "p" << "port",
+        "Listen on this port (default is any free port)", "port");
+    const QCommandLineOption profileOption(QStringList() << "n" << "network",
+        "Network profile: " + profiles.join(", "), "profile");
+    const QCommandLineOption latencyOption(QStringList() << "l" << "latency",
+        "Latency in milliseconds (overrides the profile)", "ms");
+    const QCommandLineOption bandwidthOption(QStringList() << "b" << "bandwidth",
+        "Bandwidth in bytes per second (overrides the profile)", "bps");
+
+    parser.setApplicationDescription("Local stand-in for the HSL servers. "
+        "Run harbour-fillari with FILLARI_WWW_URL and FILLARI_ID_URL "
+        "pointing to the printed URL.");
+    parser.addHelpOption();
+    parser.addOption(portOption);
+    parser.addOption(profileOption);
+    parser.addOption(latencyOption);
+    parser.addOption(bandwidthOption);
+    parser.addPositionalArgument("dir", "Directory containing index.json");
+    parser.process(app);
+
+    const QStringList args(parser.positionalArguments());
+
+    if (args.count() != 1) {
+        parser.showHelp(1);
+    }
+
+    BikeMockServer server;
+
+    if (parser.isSet(profileOption)) {
+        const QString name(parser.value(profileOption));
+        const BikeMockServer::Profile* profile = BikeMockServer::profile(name);
+
+        if (!profile) {
+            fprintf(stderr, "Unknown profile '%s'\n", qPrintable(name));
+            return 1;
+        }
+        server.setProfile(profile);
+    }
+    if (parser.isSet(latencyOption)) {
+        server.setLatency(parser.value(latencyOption).toInt());
+    }
+    if (parser.isSet(bandwidthOption)) {
+        server.setBandwidth(parser.value(bandwidthOption).toInt());
+    }
+
+    if (!server.load(args.first())) {
+        fprintf(stderr, "Failed to load %s\n", qPrintable(args.first()));
+        return 1;
+    }
+    if (!server.listen(parser.value(portOption).toUShort())) {
+        fprintf(stderr, "Failed to start the server\n");
+        return 1;
+    }
+
+    printf("%s\n", qPrintable(server.url()));
+    fflush(stdout);
+    return app.exec();
+}
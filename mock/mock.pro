@@ -0,0 +1,39 @@
+# Local stand-in for the HSL servers, doesn't require Sailfish OS SDK:
+#
+#   qmake && make && ./fillari-mock data
+#
+# and then run the app (or the benchmarks) against the printed URL:
+#
+#   FILLARI_WWW_URL=http://127.0.0.1:NNNN \
+#   FILLARI_ID_URL=http://127.0.0.1:NNNN harbour-fillari
+
+TEMPLATE = app
+TARGET = fillari-mock
+CONFIG += console
+CONFIG -= app_bundle
+QT = core network
+
+QMAKE_CXXFLAGS += -Wno-unused-parameter
+
+CONFIG(debug, debug|release) {
+    DEFINES += DEBUG HARBOUR_DEBUG
+}
+
+SRC_DIR = $${_PRO_FILE_PWD_}/../src
+HARBOUR_LIB_DIR = $${_PRO_FILE_PWD_}/../harbour-lib
+HARBOUR_LIB_INCLUDE = $${HARBOUR_LIB_DIR}/include
+
+INCLUDEPATH += \
+    $${SRC_DIR} \
+    $${HARBOUR_LIB_INCLUDE}
+
+HEADERS += \
+    $${HARBOUR_LIB_INCLUDE}/HarbourDebug.h \
+    $${SRC_DIR}/BikeApp.h \
+    $${SRC_DIR}/BikeRecording.h \
+    BikeMockServer.h
+
+SOURCES += \
+    $${SRC_DIR}/BikeRecording.cpp \
+    BikeMockServer.cpp \
+    main.cpp
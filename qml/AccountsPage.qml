@@ -0,0 +1,85 @@
+import QtQuick 2.0
+import Sailfish.Silica 1.0
+
+Page {
+    id: thisPage
+
+    property var user
+
+    SilicaListView {
+        id: list
+
+        anchors.fill: parent
+        model: user.userIds
+
+        PullDownMenu {
+            MenuItem {
+                //: Menu item
+                //% "Add account"
+                text: qsTrId("fillari-accounts-menu-add")
+                onClicked: {
+                    var userId = user.addUser()
+                    if (userId !== "") {
+                        user.userId = userId
+                        pageStack.pop()
+                    }
+                }
+            }
+        }
+
+        header: PageHeader {
+            //: Page header
+            //% "Accounts"
+            title: qsTrId("fillari-accounts-header")
+        }
+
+        delegate: ListItem {
+            id: item
+
+            readonly property bool current: modelData === user.userId
+            readonly property string login: user.login(modelData)
+
+            function remove() {
+                //: Remorse popup text
+                //% "Removing account"
+                remorseDelete(function() { user.removeUser(modelData) },
+                    qsTrId("fillari-accounts-remorse-remove"))
+            }
+
+            menu: current ? null : contextMenuComponent
+            onClicked: {
+                if (!current) {
+                    user.userId = modelData
+                }
+                pageStack.pop()
+            }
+
+            Label {
+                x: Theme.horizontalPageMargin
+                width: parent.width - 2 * x
+                anchors.verticalCenter: parent.verticalCenter
+                truncationMode: TruncationMode.Fade
+                color: (item.highlighted || item.current) ? Theme.highlightColor : Theme.primaryColor
+                text: item.login !== "" ? item.login :
+                    //: Account without a saved login
+                    //% "New account"
+                    qsTrId("fillari-accounts-new")
+            }
+
+            Component {
+                id: contextMenuComponent
+
+                ContextMenu {
+                    MenuItem {
+                        //: Context menu item
+                        //% "Remove"
+                        text: qsTrId("fillari-accounts-menu-remove")
+                        onClicked: item.remove()
+                    }
+                }
+            }
+        }
+
+        VerticalScrollDecorator { }
+    }
+}
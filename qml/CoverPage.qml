@@ -7,6 +7,7 @@ import "harbour"
 CoverBackground {
     property var session
 
+    readonly property var _summary: session.summary
     readonly property real _opacityLow: 0.4
     readonly property color _hslYellow: "#fcb919"
     readonly property bool _darkOnLight: ('colorScheme' in Theme) && Theme.colorScheme === 1
@@ -19,16 +20,6 @@ CoverBackground {
                                         session.sessionState === BikeSession.NetworkError ||
                                         session.sessionState === BikeSession.LoginNetworkError
 
-    BikeHistoryStats {
-        id: stats
-
-        // Make sure that the year is set first, to avoid unnecessary
-        // recalculation of the statistics for the entire history
-        year: session.thisYear
-        history: year ? session.history : {}
-        mode: BikeHistoryStats.Distance
-    }
-
     Item {
         width: parent.width
         anchors {
@@ -84,11 +75,11 @@ CoverBackground {
             }
             verticalAlignment: Text.AlignVCenter
             horizontalAlignment: Text.AlignHCenter
-            visible: session.rideInProgress || (session.lastYear && session.thisYear === session.lastYear)
-            text: session.rideInProgress ?
-                Fillari.format(session.rideDuration, BikeHistoryStats.Duration) :
-                Fillari.format(stats.total, stats.mode)
-            color: session.rideInProgress ? Theme.highlightColor : Theme.primaryColor
+            visible: _summary.rideInProgress || _summary.rides > 0
+            text: _summary.rideInProgress ?
+                Fillari.format(_summary.rideDuration, BikeHistoryStats.Duration) :
+                Fillari.format(_summary.distance, BikeHistoryStats.Distance)
+            color: _summary.rideInProgress ? Theme.highlightColor : Theme.primaryColor
             font {
                 pixelSize: Theme.fontSizeLarge
                 bold: true
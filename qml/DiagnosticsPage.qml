@@ -0,0 +1,88 @@
+import QtQuick 2.0
+import Sailfish.Silica 1.0
+
+// Hidden page (long press on the logo in the main page header), not
+// meant for end users and therefore not translated.
+Page {
+    id: thisPage
+
+    property var session
+
+    readonly property var _log: session.log
+
+    SilicaListView {
+        id: list
+
+        anchors.fill: parent
+        model: _log
+
+        PullDownMenu {
+            MenuItem {
+                text: "Clear"
+                onClicked: _log.clear()
+            }
+        }
+
+        header: Component {
+            Column {
+                width: list.width
+
+                PageHeader {
+                    title: "Diagnostics"
+                }
+
+                SectionHeader {
+                    text: "LoginCheck to Ready"
+                }
+
+                LatencyView {
+                    x: Theme.horizontalPageMargin
+                    width: parent.width - 2 * x
+                    histogram: _log.loginLatency
+                }
+
+                SectionHeader {
+                    text: "History query"
+                }
+
+                LatencyView {
+                    x: Theme.horizontalPageMargin
+                    width: parent.width - 2 * x
+                    histogram: _log.historyLatency
+                }
+
+                SectionHeader {
+                    text: "Errors"
+                }
+
+                Repeater {
+                    model: _log.errorRates
+
+                    Label {
+                        x: Theme.horizontalPageMargin
+                        width: parent.width - 2 * x
+                        text: modelData.state + ": " + modelData.errors + "/" + modelData.requests +
+                            " (" + Math.round(modelData.rate * 100) + "%)"
+                        font.pixelSize: Theme.fontSizeExtraSmall
+                    }
+                }
+
+                SectionHeader {
+                    text: "Transitions"
+                }
+            }
+        }
+
+        delegate: Label {
+            x: Theme.horizontalPageMargin
+            width: list.width - 2 * x
+            text: model.time.toLocaleString(Qt.locale(), "dd.MM HH:mm:ss") + " " +
+                model.previous + " => " + model.state + " " + model.duration + " ms" +
+                (model.httpStatus ? (" (" + model.httpStatus + ")") : "")
+            font.pixelSize: Theme.fontSizeExtraSmall
+            truncationMode: TruncationMode.Fade
+        }
+
+        VerticalScrollDecorator { }
+    }
+}
@@ -0,0 +1,82 @@
+import QtQuick 2.0
+import Sailfish.Silica 1.0
+import harbour.fillari 1.0
+
+Page {
+    id: thisPage
+
+    property var history
+
+    property bool _failed
+
+    BikeExport {
+        id: exporter
+
+        history: thisPage.history
+        onDone: _failed = false
+        onFailed: _failed = true
+    }
+
+    SilicaFlickable {
+        anchors.fill: parent
+        contentHeight: column.height
+
+        Column {
+            id: column
+
+            width: parent.width
+            spacing: Theme.paddingLarge
+
+            PageHeader {
+                //: Page header
+                //% "Export history"
+                title: qsTrId("fillari-export-header")
+            }
+
+            Button {
+                //: Button label
+                //% "CSV"
+                text: qsTrId("fillari-export-button-csv")
+                enabled: !exporter.busy
+                anchors.horizontalCenter: parent.horizontalCenter
+                onClicked: exporter.start(BikeExport.CSV)
+            }
+
+            Button {
+                //: Button label
+                //% "JSON Lines"
+                text: qsTrId("fillari-export-button-jsonl")
+                enabled: !exporter.busy
+                anchors.horizontalCenter: parent.horizontalCenter
+                onClicked: exporter.start(BikeExport.JSONLines)
+            }
+
+            ProgressBar {
+                width: parent.width
+                value: exporter.progress
+                opacity: exporter.busy ? 1 : 0
+                Behavior on opacity { FadeAnimation { } }
+            }
+
+            Button {
+                //: Button label
+                //% "Cancel"
+                text: qsTrId("fillari-export-button-cancel")
+                visible: exporter.busy
+                anchors.horizontalCenter: parent.horizontalCenter
+                onClicked: exporter.cancel()
+            }
+
+            InfoLabel {
+                visible: !exporter.busy && (_failed || exporter.lastFile !== "")
+                text: _failed ?
+                    //: Info label
+                    //% "Export failed"
+                    qsTrId("fillari-export-info-failed") :
+                    //: Info label, %1 is the file name
+                    //% "Saved %1"
+                    qsTrId("fillari-export-info-saved").arg(exporter.lastFile)
+            }
+        }
+    }
+}
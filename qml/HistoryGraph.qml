@@ -17,6 +17,8 @@ Item {
     readonly property color _lineColor: Theme.rgba(Theme.primaryColor, _opacityLow)
     readonly property color _hslYellow: "#fcb919"
     readonly property int _maxValue: model.maxValue
+    readonly property bool _weekly: model.resolution === BikeHistoryStats.Weeks
+    readonly property int _barSpacing: _weekly ? 0 : Theme.paddingLarge
 
     ModeSwitch {
         id: buttons
@@ -49,10 +51,24 @@ Item {
             y: Theme.paddingMedium
             width: parent.width - 2 * x
 
-            //: Graph header
-            //% "Per month"
-            text: qsTrId("fillari-graph-per_month_header")
+            text: _weekly ?
+                //: Graph header
+                //% "Per week"
+                qsTrId("fillari-graph-per_week_header") :
+                //: Graph header
+                //% "Per month"
+                qsTrId("fillari-graph-per_month_header")
             font.bold: true
+            color: headerArea.pressed ? Theme.highlightColor : Theme.primaryColor
+
+            MouseArea {
+                id: headerArea
+
+                anchors.fill: parent
+                enabled: !busy
+                onClicked: thisItem.model.resolution = _weekly ?
+                    BikeHistoryStats.Months : BikeHistoryStats.Weeks
+            }
         }
 
         BusyIndicator {
@@ -78,14 +94,15 @@ Item {
         Repeater {
             id: grid
 
-            readonly property int _step: Fillari.step(_maxValue, Math.min((histogramRow.height - header.height) / Theme.itemSizeSmall, 5), thisItem.mode)
-            readonly property int _ystep: _maxValue ? histogramRow.height * _step / _maxValue : 0
-
-            model:  _step ? Math.floor(_maxValue / _step) : 0
+            model: BikeAxisModel {
+                mode: thisItem.mode
+                maxValue: _maxValue
+                maxCount: Math.min((histogramRow.height - header.height) / Theme.itemSizeSmall, 5)
+            }
 
             Column {
                 x: _margin
-                y: horizontalAxis.y - (model.modelData + 1) * grid._ystep - height
+                y: horizontalAxis.y - model.position * histogramRow.height - height
                 width: thisItem.width - 2 * x
                 visible: opacity > 0
                 opacity: busy ? 0 : 1
@@ -95,7 +112,7 @@ Item {
                 Label {
                     font.pixelSize: Theme.fontSizeSmall
                     color: _lineColor
-                    text: Fillari.format((model.modelData + 1) * grid._step, thisItem.mode)
+                    text: model.text
                     opacity: parent.y > (header.y + header.height + Theme.paddingMedium) ? 1 : 0
                 }
 
@@ -107,15 +124,15 @@ Item {
             }
         }
 
-        Row {
+        HistogramItem {
             id: histogramRow
 
-            readonly property int count: histogramBars.count
-            readonly property int delegateWidth: count ? ((thisItem.width - x - _rightGraphMargin + spacing) / count - spacing) : 0
-            readonly property int barWidth: Math.ceil(Math.min(thisItem.width / 40, delegateWidth))
-
             x: _leftGraphMargin
-            spacing: Theme.paddingLarge
+            width: thisItem.width - x - _rightGraphMargin
+            model: thisItem.model
+            color: _hslYellow
+            spacing: _barSpacing
+            barWidth: Math.ceil(Math.min(thisItem.width / 40, _weekly ? (delegateWidth * 2 / 3) : delegateWidth))
             opacity: 1 - busyIndicator.opacity
             visible: opacity > 0
             anchors {
@@ -124,59 +141,24 @@ Item {
                 bottom: horizontalAxis.top
             }
 
-            Repeater {
-                id: histogramBars
-
-                model: thisItem.model
-                delegate: Component {
-                    MouseArea {
-                        width: histogramRow.delegateWidth
-                        height: histogramRow.height
-
-                        ShaderEffectSource {
-                            width: histogramRow.delegateWidth
-                            height: histogramRow.height + histogramRow.y
-                            anchors.bottom: parent.bottom
-                            visible: model.value && _maxValue > 0
-
-                            sourceItem: Item {
-                                width: histogramRow.delegateWidth
-                                height: histogramRow.height + histogramRow.y
-
-                                Item {
-                                    id: cap
-
-                                    x: bar.x
-                                    y: bar.y - height/2
-                                    width: bar.width
-                                    height: width
-                                    clip: true
-
-                                    Rectangle {
-                                        width: parent.width
-                                        height: width
-                                        radius: width/2
-                                        color: bar.color
-                                    }
-                                }
-
-                                Rectangle {
-                                    id: bar
-
-                                    color: _hslYellow
-                                    width: histogramRow.barWidth
-                                    height: Math.max(histogramRow.height * model.value / _maxValue - cap.height / 2, 0)
-                                    anchors {
-                                        horizontalCenter: parent.horizontalCenter
-                                        bottom: parent.bottom
-                                    }
+            MouseArea {
+                property Item _toolTip
 
-                                    Behavior on height { SmoothedAnimation { duration: 250 } }
-                                }
-                            }
-                        }
+                anchors.fill: parent
+                onPressed: {
+                    var index = histogramRow.indexAt(mouse.x)
+                    _toolTip = (index >= 0) ? toolTips.itemAt(index) : null
+                    if (_toolTip) {
+                        _toolTip.shouldBeVisible = _toolTip.value > 0 && _maxValue > 0
+                    }
+                }
+                onReleased: hideToolTip()
+                onCanceled: hideToolTip()
 
-                        onPressedChanged: toolTips.itemAt(model.index).shouldBeVisible = pressed && model.value > 0 && _maxValue
+                function hideToolTip() {
+                    if (_toolTip) {
+                        _toolTip.shouldBeVisible = false
+                        _toolTip = null
                     }
                 }
             }
@@ -201,6 +183,7 @@ Item {
                         width: histogramRow.delegateWidth
                         height: histogramRow.height
 
+                        readonly property int value: model.value
                         property bool shouldBeVisible
 
                         onShouldBeVisibleChanged: {
@@ -223,7 +206,7 @@ Item {
 
                             sourceComponent: Component {
                                 ToolTip {
-                                    text: Fillari.format(model.value, thisItem.mode)
+                                    text: model.text
                                 }
                             }
 
@@ -252,9 +235,11 @@ Item {
 
             readonly property int count: monthLabels.count
             readonly property int labelWidth: count ? ((thisItem.width - x - _rightGraphMargin + spacing) / count - spacing) : 0
+            // Label every n-th week, so that the labels don't overlap
+            readonly property int labelStep: _weekly ? Math.ceil(Theme.itemSizeExtraSmall / Math.max(labelWidth, 1)) : 1
 
             x: _leftGraphMargin
-            spacing: Theme.paddingLarge
+            spacing: _barSpacing
             anchors {
                 bottom: parent.bottom
                 bottomMargin: Theme.paddingMedium
@@ -267,6 +252,7 @@ Item {
                 delegate: Component {
                     Label {
                         width: monthLabelsRow.labelWidth
+                        opacity: (model.index % monthLabelsRow.labelStep) ? 0 : 1
                         horizontalAlignment: Text.AlignHCenter
                         verticalAlignment: Text.AlignVCenter
                         minimumPixelSize: Theme.fontSizeTiny
@@ -276,7 +262,7 @@ Item {
                             pixelSize: Theme.fontSizeSmall
                         }
                         color: _lineColor
-                        text: model.month
+                        text: model.label
                     }
                 }
             }
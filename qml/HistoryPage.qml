@@ -12,10 +12,8 @@ Page {
     BikeHistoryStats {
         id: stats
 
-        // Make sure that the year is set first, to avoid unnecessary
-        // recalculation of the statistics for the entire history
         year: _years.length > 0 ? _years[_years.length - 1] : 0
-        history: year ? session.history : undefined
+        history: session.history
     }
 
     SilicaListView {
@@ -23,7 +21,8 @@ Page {
 
         anchors.fill: parent
         model: BikeHistoryModel {
-            year: stats.year
+            // Search covers the entire history
+            year: searchText.length > 0 ? 0 : stats.year
             history: stats.history
         }
 
@@ -117,12 +116,70 @@ Page {
                     }
                 }
 
+                ComboBox {
+                    id: orderSelector
+
+                    //: Combo box label
+                    //% "Sort by"
+                    label: qsTrId("fillari-history-order-label")
+                    menu: ContextMenu {
+                        MenuItem {
+                            readonly property int order: BikeHistoryModel.Newest
+                            //: Combo box value (sort order)
+                            //% "Date"
+                            text: qsTrId("fillari-history-order-newest")
+                        }
+                        MenuItem {
+                            readonly property int order: BikeHistoryModel.Distance
+                            //: Combo box value (sort order)
+                            //% "Distance"
+                            text: qsTrId("fillari-history-order-distance")
+                        }
+                        MenuItem {
+                            readonly property int order: BikeHistoryModel.Duration
+                            //: Combo box value (sort order)
+                            //% "Duration"
+                            text: qsTrId("fillari-history-order-duration")
+                        }
+                        MenuItem {
+                            readonly property int order: BikeHistoryModel.Speed
+                            //: Combo box value (sort order)
+                            //% "Speed"
+                            text: qsTrId("fillari-history-order-speed")
+                        }
+                        MenuItem {
+                            readonly property int order: BikeHistoryModel.Station
+                            //: Combo box value (sort order)
+                            //% "Station"
+                            text: qsTrId("fillari-history-order-station")
+                        }
+                    }
+
+                    onCurrentItemChanged: {
+                        if (currentItem) {
+                            list.model.sortOrder = currentItem.order
+                        }
+                    }
+                }
+
+                SearchField {
+                    width: parent.width
+                    //: Search field placeholder
+                    //% "Station, bike, month or year"
+                    placeholderText: qsTrId("fillari-history-search-placeholder")
+                    inputMethodHints: Qt.ImhNoPredictiveText
+                    onTextChanged: list.model.searchText = text
+                    EnterKey.iconSource: "image://theme/icon-m-enter-close"
+                    EnterKey.onClicked: focus = false
+                }
+
                 DummyItem { height: Theme.paddingLarge }
             }
         }
 
         section {
-            property: "month"
+            // Month sections only make sense in the chronological order
+            property: list.model.sortOrder === BikeHistoryModel.Newest ? "month" : ""
             criteria: ViewSection.FullString
             delegate: Component {
                 HistorySection {
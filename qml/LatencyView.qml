@@ -0,0 +1,51 @@
+import QtQuick 2.0
+import Sailfish.Silica 1.0
+
+Column {
+    id: thisView
+
+    property var histogram
+
+    readonly property real _labelWidth: Theme.itemSizeMedium
+
+    function _msText(ms) {
+        return ms < 1000 ? (ms + " ms") : ((ms / 1000) + " s")
+    }
+
+    Label {
+        width: parent.width
+        text: histogram.count + " samples, average " + histogram.average + " ms, last " + histogram.last + " ms"
+        font.pixelSize: Theme.fontSizeExtraSmall
+        color: Theme.secondaryColor
+    }
+
+    Repeater {
+        model: histogram
+
+        Row {
+            spacing: Theme.paddingMedium
+
+            Label {
+                width: _labelWidth
+                anchors.verticalCenter: parent.verticalCenter
+                horizontalAlignment: Text.AlignRight
+                text: model.limit ? ("< " + _msText(model.limit)) : ("≥ " + _msText(model.minimum))
+                font.pixelSize: Theme.fontSizeExtraSmall
+            }
+
+            Rectangle {
+                width: histogram.maxCount ? Math.max(1, (thisView.width - 2 * (_labelWidth + parent.spacing)) * model.samples / histogram.maxCount) : 1
+                height: Theme.paddingMedium
+                anchors.verticalCenter: parent.verticalCenter
+                color: Theme.highlightColor
+                opacity: model.samples ? 1 : 0.2
+            }
+
+            Label {
+                anchors.verticalCenter: parent.verticalCenter
+                text: model.samples
+                font.pixelSize: Theme.fontSizeExtraSmall
+            }
+        }
+    }
+}
@@ -6,17 +6,59 @@ Page {
     id: thisPage
 
     property var session
+    property var user
+
+    // Updated once per change set rather than on every property change
+    property int _view
+    readonly property int _viewWait: 1
+    readonly property int _viewLoginError: 2
+    readonly property int _viewLogin: 3
+    readonly property int _viewMain: 4
+
+    function currentView() {
+        switch (session.sessionState) {
+        case BikeSession.LoginCheck:
+            // Cached data are shown while the login is being checked
+            return session.cached ? _viewMain : _viewWait
+        case BikeSession.LoggingIn:
+        case BikeSession.LoggingOut:
+            return _viewWait
+        case BikeSession.LoginNetworkError:
+            return _viewLoginError
+        case BikeSession.Unauthorized:
+        case BikeSession.LoginFailed:
+            return _viewLogin
+        case BikeSession.UserInfoQuery:
+        case BikeSession.HistoryQuery:
+        case BikeSession.Ready:
+        case BikeSession.NetworkError:
+            return _viewMain
+        }
+        return 0
+    }
+
+    function httpErrorVisible() {
+        return session.httpError && (session.sessionState === BikeSession.NetworkError ||
+                                     session.sessionState === BikeSession.LoginNetworkError)
+    }
+
+    Component.onCompleted: {
+        _view = currentView()
+        httpErrorPanel.opacity = httpErrorVisible() ? 1 : 0
+    }
 
     Connections {
         target: session
-        onSessionStateChanged: {
-            if (session.sessionState === BikeSession.Unauthorized) {
+        onChanged: {
+            if (changes & (BikeSession.SessionStateChange | BikeSession.CachedChange)) {
+                _view = currentView()
+            }
+            if ((changes & BikeSession.SessionStateChange) &&
+                session.sessionState === BikeSession.Unauthorized) {
                 pageStack.pop(thisPage, PageStackAction.Immediate)
             }
-        }
-        onHttpErrorChanged: {
-            if (session.httpError) {
-                httpErrorPanel.opacity = 1
+            if (changes & (BikeSession.HttpErrorChange | BikeSession.SessionStateChange)) {
+                httpErrorPanel.opacity = httpErrorVisible() ? 1 : 0
             }
         }
     }
@@ -25,12 +67,24 @@ Page {
         anchors.fill: parent
         contentHeight: height
 
+        // MainView has its own menu
+        PullDownMenu {
+            visible: _view === _viewLogin
+
+            MenuItem {
+                //: Menu item
+                //% "Accounts"
+                text: qsTrId("fillari-menu-accounts")
+                onClicked: pageStack.push(Qt.resolvedUrl("AccountsPage.qml"), {
+                    allowedOrientations: thisPage.allowedOrientations,
+                    user: thisPage.user})
+            }
+        }
+
         Loader {
             anchors.fill: parent
             active: opacity > 0
-            opacity: (session.sessionState === BikeSession.LoginCheck ||
-                      session.sessionState === BikeSession.LoggingIn ||
-                      session.sessionState === BikeSession.LoggingOut) ? 1 : 0
+            opacity: (_view === _viewWait) ? 1 : 0
             sourceComponent: Component { WaitView { } }
             Behavior on opacity { FadeAnimation { } }
         }
@@ -38,7 +92,7 @@ Page {
         Loader {
             anchors.fill: parent
             active: opacity > 0
-            opacity: (session.sessionState === BikeSession.LoginNetworkError) ? 1 : 0
+            opacity: (_view === _viewLoginError) ? 1 : 0
             sourceComponent: Component {
                 LoginNetworkErrorView {
                     isLandscape: thisPage.isLandscape
@@ -51,8 +105,7 @@ Page {
         Loader {
             anchors.fill: parent
             active: opacity > 0
-            opacity: (session.sessionState === BikeSession.Unauthorized ||
-                      session.sessionState === BikeSession.LoginFailed) ? 1 : 0
+            opacity: (_view === _viewLogin) ? 1 : 0
             sourceComponent: Component {
                 LoginView {
                     isLandscape: thisPage.isLandscape
@@ -67,31 +120,31 @@ Page {
         Loader {
             anchors.fill: parent
             active: opacity > 0
-            opacity: (session.sessionState === BikeSession.UserInfoQuery ||
-                      session.sessionState === BikeSession.HistoryQuery ||
-                      session.sessionState === BikeSession.Ready ||
-                      session.sessionState === BikeSession.NetworkError) ? 1 : 0
+            opacity: (_view === _viewMain) ? 1 : 0
             sourceComponent: Component {
                 MainView {
                     isLandscape: thisPage.isLandscape
                     allowedOrientations: thisPage.allowedOrientations
                     session: thisPage.session
+                    user: thisPage.user
                 }
             }
             Behavior on opacity { FadeAnimation { } }
         }
     }
 
-    HttpError {
+    Loader {
         id: httpErrorPanel
 
         anchors.fill: parent
-
-        error: session.httpError
-        visible: opacity > 0
-        opacity: session.httpError && (session.sessionState === BikeSession.NetworkError ||
-                                       session.sessionState === BikeSession.LoginNetworkError) ? 1 : 0
-        onClicked: opacity = 0
+        active: opacity > 0
+        opacity: 0
+        sourceComponent: Component {
+            HttpError {
+                error: session.httpError
+                onClicked: httpErrorPanel.opacity = 0
+            }
+        }
         Behavior on opacity { FadeAnimation { } }
     }
 }
@@ -8,14 +8,51 @@ Item {
     property int allowedOrientations
     property bool isLandscape
     property var session
+    property var user
 
     property var _remorsePopup
     readonly property real _opacityLow: 0.4
     readonly property bool _remorsePopupVisible: _remorsePopup ? _remorsePopup.visible : false
     readonly property color _hslYellow: "#fcb919"
-    readonly property bool _busy: session.sessionState === BikeSession.UserInfoQuery ||
+    readonly property bool _busy: session.sessionState === BikeSession.LoginCheck ||
+                                  session.sessionState === BikeSession.UserInfoQuery ||
                                   session.sessionState === BikeSession.HistoryQuery
 
+    // Depends on more than one session property, updated once per change set
+    property string _status
+
+    function statusText() {
+        switch (session.sessionState) {
+        case BikeSession.LoginCheck:
+        case BikeSession.UserInfoQuery:
+            //: Main page status text
+            //% "Loading account information..."
+            return qsTrId("fillari-main-status-loading_user_info")
+        case BikeSession.HistoryQuery:
+            //: Main page status text
+            //% "Loading history..."
+            return qsTrId("fillari-main-status-loading_history")
+        case BikeSession.NetworkError:
+            //: Main page status text
+            //% "Network error"
+            return qsTrId("fillari-main-status-loading_network_error")
+        }
+        //: Main page status text
+        //% "Last update %1"
+        return qsTrId("fillari-main-status-last_update_time").
+            arg(session.lastUpdate.toLocaleString(Qt.locale(), "dd.MM.yyyy HH:mm"))
+    }
+
+    Component.onCompleted: _status = statusText()
+
+    Connections {
+        target: session
+        onChanged: {
+            if (changes & (BikeSession.SessionStateChange | BikeSession.LastUpdateChange)) {
+                _status = statusText()
+            }
+        }
+    }
 
     BikeHistoryStats {
         id: stats
@@ -31,6 +68,13 @@ Item {
         maxCount: 3
     }
 
+    BikeRecords {
+        id: records
+
+        history: stats.history
+        season: recordsPeriod.currentIndex ? session.thisYear : 0
+    }
+
     Component {
         id: remorsePopupComponent
 
@@ -78,6 +122,25 @@ Item {
                 onClicked: pulleyMenu.logoutRequested = true
             }
 
+            MenuItem {
+                //: Menu item
+                //% "Accounts"
+                text: qsTrId("fillari-menu-accounts")
+                onClicked: pageStack.push(Qt.resolvedUrl("AccountsPage.qml"), {
+                    allowedOrientations: thisView.allowedOrientations,
+                    user: thisView.user})
+            }
+
+            MenuItem {
+                //: Menu item
+                //% "Export"
+                text: qsTrId("fillari-menu-export")
+                visible: session.history.count > 0
+                onClicked: pageStack.push(Qt.resolvedUrl("ExportPage.qml"), {
+                    allowedOrientations: thisView.allowedOrientations,
+                    history: session.history})
+            }
+
             MenuItem {
                 //: Menu item
                 //% "Pick up"
@@ -98,23 +161,7 @@ Item {
             id: header
 
             title: session.fullName
-            description: session.sessionState === BikeSession.UserInfoQuery ?
-                //: Main page status text
-                //% "Loading account information..."
-                qsTrId("fillari-main-status-loading_user_info") :
-                session.sessionState === BikeSession.HistoryQuery ?
-                //: Main page status text
-                //% "Loading history..."
-                qsTrId("fillari-main-status-loading_history") :
-                session.sessionState === BikeSession.NetworkError ?
-                //: Main page status text
-                //% "Network error"
-                qsTrId("fillari-main-status-loading_network_error") :
-                //: Main page status text
-                //% "Last update %1"
-                qsTrId("fillari-main-status-last_update_time").
-                    arg(session.lastUpdate.toLocaleString(Qt.locale(),
-                    "dd.MM.yyyy HH:mm"))
+            description: _status
 
             Rectangle {
                 width: fillariImage.width + 2 * Theme.paddingMedium
@@ -133,6 +180,13 @@ Item {
                     source: "images/fillari.svg"
                     sourceSize.width: Theme.itemSizeLarge
                 }
+
+                MouseArea {
+                    anchors.fill: parent
+                    onPressAndHold: pageStack.push(Qt.resolvedUrl("DiagnosticsPage.qml"), {
+                        allowedOrientations: thisView.allowedOrientations,
+                        session: thisView.session})
+                }
             }
         }
 
@@ -242,19 +296,63 @@ Item {
                 horizontalAlignment: Text.AlignRight
                 opacity: _opacityLow
             }
+
+            SectionTitle {
+                //: Section header
+                //% "Records"
+                text: qsTrId("fillari-main-section-records")
+                visible: recordsPeriod.visible
+            }
+
+            ComboBox {
+                id: recordsPeriod
+
+                x: -content.x // Fill the entire flickable (horizontally)
+                width: parent.width + 2 * content.x
+                visible: records.count > 0 || currentIndex > 0
+                //: Combo box label (period of time for the records)
+                //% "Period"
+                label: qsTrId("fillari-main-records-period")
+                menu: ContextMenu {
+                    MenuItem {
+                        //: Combo box value (period of time for the records)
+                        //% "All time"
+                        text: qsTrId("fillari-main-records-all_time")
+                    }
+                    MenuItem {
+                        text: session.thisYear
+                    }
+                }
+            }
+
+            Repeater {
+                model: records
+                delegate: RecordItem {
+                    record: model.record
+                    value: model.value
+                    date: model.date
+                    endDate: model.endDate
+                    departureStation: model.departureStation
+                    returnStation: model.returnStation
+                }
+            }
         }
 
         VerticalScrollDecorator {}
     }
 
-    PickUpView {
+    Loader {
         id: pickUp
 
-        nfcid: session.nfcid1
         anchors.fill: parent
-        visible: opacity > 0
+        active: opacity > 0
         opacity: 0
-        onDone: opacity = 0
+        sourceComponent: Component {
+            PickUpView {
+                nfcid: session.nfcid1
+                onDone: pickUp.opacity = 0
+            }
+        }
         Behavior on opacity { FadeAnimation { } }
     }
 }
@@ -0,0 +1,105 @@
+import QtQuick 2.0
+import Sailfish.Silica 1.0
+import harbour.fillari 1.0
+
+Column {
+    property int record
+    property var value
+    property date date
+    property date endDate
+    property string departureStation
+    property string returnStation
+
+    readonly property bool _rideRecord: record === BikeRecords.LongestRide || record === BikeRecords.FastestRide
+
+    width: parent.width
+
+    function dateToString(date) {
+        return date.toLocaleString(Qt.locale(), "dd.MM.yyyy")
+    }
+
+    function titleText() {
+        switch (record) {
+        case BikeRecords.LongestRide:
+            //: Record title
+            //% "Longest ride"
+            return qsTrId("fillari-records-longest_ride")
+        case BikeRecords.FastestRide:
+            //: Record title
+            //% "Fastest ride"
+            return qsTrId("fillari-records-fastest_ride")
+        case BikeRecords.LongestStreak:
+            //: Record title (consecutive days with rides)
+            //% "Longest streak"
+            return qsTrId("fillari-records-longest_streak")
+        case BikeRecords.BusiestDay:
+            //: Record title
+            //% "Most rides in a day"
+            return qsTrId("fillari-records-busiest_day")
+        }
+        return ""
+    }
+
+    function valueText() {
+        switch (record) {
+        case BikeRecords.LongestRide:
+            return Fillari.format(value, BikeHistoryStats.Distance)
+        case BikeRecords.FastestRide:
+            //: Average speed of the ride
+            //% "%1 km/h"
+            return qsTrId("fillari-records-value-speed").arg(value.toLocaleString(Qt.locale(), 'f', 1))
+        case BikeRecords.LongestStreak:
+            //: Length of the streak
+            //% "%n day(s)"
+            return qsTrId("fillari-records-value-days", value)
+        case BikeRecords.BusiestDay:
+            //: Number of rides in a day
+            //% "%n ride(s)"
+            return qsTrId("fillari-records-value-rides", value)
+        }
+        return ""
+    }
+
+    function detailsText() {
+        if (_rideRecord) {
+            return dateToString(date) + "  " + departureStation + " → " + returnStation
+        } else if (record === BikeRecords.LongestStreak && value > 1) {
+            return dateToString(date) + " – " + dateToString(endDate)
+        } else {
+            return dateToString(date)
+        }
+    }
+
+    Item {
+        width: parent.width
+        height: Math.max(titleLabel.height, valueLabel.height)
+
+        Label {
+            id: titleLabel
+
+            anchors {
+                left: parent.left
+                right: valueLabel.left
+                rightMargin: Theme.paddingMedium
+            }
+            text: titleText()
+            truncationMode: TruncationMode.Fade
+        }
+
+        Label {
+            id: valueLabel
+
+            anchors.right: parent.right
+            text: valueText()
+            font.bold: true
+        }
+    }
+
+    Label {
+        width: parent.width
+        text: detailsText()
+        font.pixelSize: Theme.fontSizeSmall
+        color: Theme.secondaryColor
+        truncationMode: TruncationMode.Fade
+    }
+}
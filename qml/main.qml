@@ -11,6 +11,7 @@ ApplicationWindow {
         MainPage {
             allowedOrientations: appWindow.allowedOrientations
             session: bikeSession
+            user: bikeUser
         }
     }
 
@@ -21,14 +22,15 @@ ApplicationWindow {
     }
 
     BikeUser {
-        id: user
+        id: bikeUser
 
-        userId: "0000"
+        userId: lastUserId
+        onUserIdsChanged: bikeSession.forgetRemovedAccounts()
     }
 
     BikeSession {
         id: bikeSession
 
-        dataDir: user.dataDir
+        dataDir: bikeUser.dataDir
     }
 }
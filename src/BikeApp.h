@@ -44,7 +44,22 @@
 #define BIKE_CONF_DIR   "harbour/fillari/"
 #define BIKE_DCONF_ROOT "/apps/" BIKE_APP_NAME "/"
 
-#define BIKE_DEFAULT_REFERER "https://www.hsl.fi/omat-tiedot/kaupunkipyorat?fromLogin=true"
-#define BIKE_API_URL(x) "https://www.hsl.fi/user/api/v1/" x
+// Per-account files
+#define BIKE_LOGIN_FILE "Login"
+
+// The servers can be redirected with environment variables, e.g. to
+// a local mock server (see the mock directory)
+#define BIKE_WWW_URL "https://www.hsl.fi"
+#define BIKE_WWW_URL_ENV "FILLARI_WWW_URL"
+#define BIKE_ID_URL "https://id.hsl.fi"
+#define BIKE_ID_URL_ENV "FILLARI_ID_URL"
+
+// Directories for recording and replaying the network traffic
+// (see BikeTransport.h)
+#define BIKE_RECORD_DIR_ENV "FILLARI_RECORD"
+#define BIKE_REPLAY_DIR_ENV "FILLARI_REPLAY"
+
+#define BIKE_API_PATH "/user/api/v1/"
+#define BIKE_DEFAULT_REFERER_PATH "/omat-tiedot/kaupunkipyorat?fromLogin=true"
 
 #endif // BIKE_APP_H
@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeAxisModel.h"
+#include "Fillari.h"
+
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include <algorithm>
+
+#include "HarbourDebug.h"
+#include "HarbourParentSignalQueueObject.h"
+
+// s(SignalName,signalName)
+#define QUEUED_SIGNALS(s) \
+    s(Mode,mode) \
+    s(MaxValue,maxValue) \
+    s(MaxCount,maxCount) \
+    s(Step,step) \
+    s(Count,count)
+
+// ==========================================================================
+// BikeAxisModel::Private
+// ==========================================================================
+
+enum BikeAxisModelSignal {
+    #define SIGNAL_ENUM_(Name,name) Signal##Name##Changed,
+    QUEUED_SIGNALS(SIGNAL_ENUM_)
+    #undef  SIGNAL_ENUM_
+    BikeAxisModelSignalCount
+};
+
+typedef HarbourParentSignalQueueObject<BikeAxisModel,
+    BikeAxisModelSignal, BikeAxisModelSignalCount>
+    BikeAxisModelPrivateBase;
+
+class BikeAxisModel::Private :
+    public BikeAxisModelPrivateBase
+{
+    static const SignalEmitter gSignalEmitters[];
+
+public:
+    static const int gRideSteps[];
+    static const int gDistanceSteps[];
+    static const int gDurationSteps[];
+
+    enum Role {
+        RoleValue = Qt::UserRole,
+        RoleText,
+        RolePosition
+    };
+
+    Private(BikeAxisModel*);
+
+    void update();
+
+public:
+    BikeHistoryStats::Mode iMode;
+    int iMaxValue;
+    int iMaxCount;
+    int iStep;
+    int iCount;
+    QStringList iTexts;
+};
+
+/* static */
+const BikeAxisModel::Private::SignalEmitter
+BikeAxisModel::Private::gSignalEmitters [] = {
+    #define SIGNAL_EMITTER_(Name,name) &BikeAxisModel::name##Changed,
+    QUEUED_SIGNALS(SIGNAL_EMITTER_)
+    #undef SIGNAL_EMITTER_
+};
+
+// Nice numbers, in the units of BikeHistoryStats::Mode
+const int BikeAxisModel::Private::gRideSteps[] = {
+    1, 5, 10, 50, 100
+};
+const int BikeAxisModel::Private::gDistanceSteps[] = {
+    1, 10, 100, 500, 1000, 5000, 10000, 50000, 100000
+};
+const int BikeAxisModel::Private::gDurationSteps[] = {
+    1, 5, 60, 5*60, 10*60, 60*60
+};
+
+BikeAxisModel::Private::Private(
+    BikeAxisModel* aParent) :
+    BikeAxisModelPrivateBase(aParent, gSignalEmitters),
+    iMode(BikeHistoryStats::Distance),
+    iMaxValue(0),
+    iMaxCount(0),
+    iStep(0),
+    iCount(0)
+{}
+
+void
+BikeAxisModel::Private::update()
+{
+    BikeAxisModel* model = parentObject();
+    const int step = BikeAxisModel::step(iMaxValue, iMaxCount, iMode);
+    const int count = step ? (iMaxValue / step) : 0;
+    QVector<int> values;
+
+    values.reserve(count);
+    for (int i = 1; i <= count; i++) {
+        values.append(i * step);
+    }
+
+    if (iCount != count) {
+        HDEBUG(count << "tick(s)");
+        model->beginResetModel();
+        iStep = step;
+        iCount = count;
+        iTexts = Fillari::format(values, iMode);
+        model->endResetModel();
+        queueSignal(SignalStepChanged);
+        queueSignal(SignalCountChanged);
+    } else {
+        if (iStep != step) {
+            iStep = step;
+            queueSignal(SignalStepChanged);
+        }
+        // Positions change together with maxValue
+        if (count) {
+            iTexts = Fillari::format(values, iMode);
+            Q_EMIT model->dataChanged(model->index(0), model->index(count - 1));
+        }
+    }
+}
+
+// ==========================================================================
+// BikeAxisModel
+// ==========================================================================
+
+BikeAxisModel::BikeAxisModel(
+    QObject* aParent) :
+    QAbstractListModel(aParent),
+    iPrivate(new Private(this))
+{}
+
+// static
+int
+BikeAxisModel::step(
+    int aMaxValue,
+    int aMaxCount,
+    BikeHistoryStats::Mode aMode)
+{
+    const int* begin = Q_NULLPTR;
+    const int* end = Q_NULLPTR;
+
+    #define STEPS_(table) \
+        begin = Private::table; \
+        end = begin + sizeof(Private::table)/sizeof(Private::table[0])
+
+    switch (aMode) {
+    case BikeHistoryStats::Rides: STEPS_(gRideSteps); break;
+    case BikeHistoryStats::Distance: STEPS_(gDistanceSteps); break;
+    case BikeHistoryStats::Duration: STEPS_(gDurationSteps); break;
+    }
+
+    #undef STEPS_
+
+    if (begin && aMaxCount > 0 && aMaxValue > 0) {
+        // The largest table entry d with d * maxCount <= maxValue
+        // (or the smallest one if there's none)
+        const int* upper = std::upper_bound(begin, end, aMaxValue / aMaxCount);
+        const int d = (upper == begin) ? *begin : upper[-1];
+
+        if (d <= aMaxValue) {
+            // The smallest multiple of d (s) for which maxValue/s
+            // doesn't exceed maxCount
+            const int s = d * (aMaxValue / (d * (aMaxCount + 1)) + 1);
+
+            HDEBUG(aMaxValue << aMaxCount << aMode << "=>" << s);
+            return s;
+        }
+    }
+    return 0;
+}
+
+BikeHistoryStats::Mode
+BikeAxisModel::mode() const
+{
+    return iPrivate->iMode;
+}
+
+void
+BikeAxisModel::setMode(
+    BikeHistoryStats::Mode aMode)
+{
+    if (iPrivate->iMode != aMode) {
+        iPrivate->iMode = aMode;
+        HDEBUG(aMode);
+        iPrivate->queueSignal(SignalModeChanged);
+        iPrivate->update();
+        iPrivate->emitQueuedSignals();
+    }
+}
+
+int
+BikeAxisModel::maxValue() const
+{
+    return iPrivate->iMaxValue;
+}
+
+void
+BikeAxisModel::setMaxValue(
+    int aMaxValue)
+{
+    if (iPrivate->iMaxValue != aMaxValue) {
+        iPrivate->iMaxValue = aMaxValue;
+        HDEBUG(aMaxValue);
+        iPrivate->queueSignal(SignalMaxValueChanged);
+        iPrivate->update();
+        iPrivate->emitQueuedSignals();
+    }
+}
+
+int
+BikeAxisModel::maxCount() const
+{
+    return iPrivate->iMaxCount;
+}
+
+void
+BikeAxisModel::setMaxCount(
+    int aMaxCount)
+{
+    if (iPrivate->iMaxCount != aMaxCount) {
+        iPrivate->iMaxCount = aMaxCount;
+        HDEBUG(aMaxCount);
+        iPrivate->queueSignal(SignalMaxCountChanged);
+        iPrivate->update();
+        iPrivate->emitQueuedSignals();
+    }
+}
+
+int
+BikeAxisModel::step() const
+{
+    return iPrivate->iStep;
+}
+
+int
+BikeAxisModel::count() const
+{
+    return iPrivate->iCount;
+}
+
+QHash<int,QByteArray>
+BikeAxisModel::roleNames() const
+{
+    QHash<int,QByteArray> roles;
+
+    roles.insert(Private::RoleValue, "value");
+    roles.insert(Private::RoleText, "text");
+    roles.insert(Private::RolePosition, "position");
+    return roles;
+}
+
+int
+BikeAxisModel::rowCount(
+    const QModelIndex&) const
+{
+    return iPrivate->iCount;
+}
+
+QVariant
+BikeAxisModel::data(
+    const QModelIndex& aIndex,
+    int aRole) const
+{
+    const int row = aIndex.row();
+
+    if (row >= 0 && row < iPrivate->iCount) {
+        const int value = (row + 1) * iPrivate->iStep;
+
+        switch ((Private::Role)aRole) {
+        case Private::RoleValue:
+            return value;
+        case Private::RoleText:
+            return iPrivate->iTexts.at(row);
+        case Private::RolePosition:
+            // Relative to maxValue
+            return qreal(value) / iPrivate->iMaxValue;
+        }
+    }
+    return QVariant();
+}
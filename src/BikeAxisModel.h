@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_AXIS_MODEL_H
+#define BIKE_AXIS_MODEL_H
+
+#include "BikeHistoryStats.h"
+
+// Grid lines of the vertical axis. Tick step is chosen from the table
+// of nice numbers for the unit (rides, meters or seconds) so that there
+// are no more than maxCount ticks between zero and maxValue. The step
+// is computed in constant time, the rows are ticks from the bottom up
+// (excluding zero) with their values, labels and relative positions.
+
+class BikeAxisModel :
+    public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(BikeHistoryStats::Mode mode READ mode WRITE setMode NOTIFY modeChanged)
+    Q_PROPERTY(int maxValue READ maxValue WRITE setMaxValue NOTIFY maxValueChanged)
+    Q_PROPERTY(int maxCount READ maxCount WRITE setMaxCount NOTIFY maxCountChanged)
+    Q_PROPERTY(int step READ step NOTIFY stepChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    BikeAxisModel(QObject* aParent = Q_NULLPTR);
+
+    BikeHistoryStats::Mode mode() const;
+    void setMode(BikeHistoryStats::Mode);
+
+    int maxValue() const;
+    void setMaxValue(int);
+
+    int maxCount() const;
+    void setMaxCount(int);
+
+    int step() const;
+    int count() const;
+
+    static int step(int, int, BikeHistoryStats::Mode);
+
+    // QAbstractItemModel
+    QHash<int,QByteArray> roleNames() const Q_DECL_OVERRIDE;
+    int rowCount(const QModelIndex&) const Q_DECL_OVERRIDE;
+    QVariant data(const QModelIndex&, int) const Q_DECL_OVERRIDE;
+
+Q_SIGNALS:
+    void modeChanged();
+    void maxValueChanged();
+    void maxCountChanged();
+    void stepChanged();
+    void countChanged();
+
+private:
+    class Private;
+    Private* iPrivate;
+};
+
+#endif // BIKE_AXIS_MODEL_H
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeConnection.h"
+
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkCookieJar>
+
+#include "HarbourDebug.h"
+
+// ==========================================================================
+// BikeConnection::NullCookieJar
+//
+// Keeps QNetworkAccessManager from mixing up the cookies of different
+// accounts. BikeRequest adds and stores cookies by itself.
+// ==========================================================================
+
+class BikeConnection::NullCookieJar :
+    public QNetworkCookieJar
+{
+public:
+    NullCookieJar(QObject* aParent) : QNetworkCookieJar(aParent) {}
+
+    QList<QNetworkCookie> cookiesForUrl(const QUrl&) const Q_DECL_OVERRIDE
+        { return QList<QNetworkCookie>(); }
+    bool setCookiesFromUrl(const QList<QNetworkCookie>&, const QUrl&)
+        Q_DECL_OVERRIDE { return false; }
+};
+
+// ==========================================================================
+// BikeConnection::Private
+// ==========================================================================
+
+class BikeConnection::Private
+{
+public:
+    Private(BikeConnection*);
+    ~Private();
+
+    static QNetworkAccessManager* gSharedNetworkAccessManager;
+    static int gSharedRefCount;
+
+public:
+    QNetworkAccessManager* iNetworkAccessManager;
+    QNetworkCookieJar* iCookieJar;
+};
+
+QNetworkAccessManager*
+BikeConnection::Private::gSharedNetworkAccessManager = Q_NULLPTR;
+int BikeConnection::Private::gSharedRefCount = 0;
+
+BikeConnection::Private::Private(
+    BikeConnection* aParent) :
+    iCookieJar(new QNetworkCookieJar(aParent))
+{
+    // The shared manager lives as long as there are connections using it
+    if (!gSharedRefCount++) {
+        HDEBUG("Creating shared network access manager");
+        gSharedNetworkAccessManager = new QNetworkAccessManager;
+        gSharedNetworkAccessManager->setCookieJar(new
+            NullCookieJar(gSharedNetworkAccessManager));
+    }
+    iNetworkAccessManager = gSharedNetworkAccessManager;
+}
+
+BikeConnection::Private::~Private()
+{
+    if (!--gSharedRefCount) {
+        HDEBUG("Deleting shared network access manager");
+        delete gSharedNetworkAccessManager;
+        gSharedNetworkAccessManager = Q_NULLPTR;
+    }
+}
+
+// ==========================================================================
+// BikeConnection
+// ==========================================================================
+
+BikeConnection::BikeConnection(
+    QObject* aParent) :
+    QObject(aParent),
+    iPrivate(new Private(this))
+{}
+
+BikeConnection::~BikeConnection()
+{
+    delete iPrivate;
+}
+
+QNetworkAccessManager*
+BikeConnection::networkAccessManager() const
+{
+    return iPrivate->iNetworkAccessManager;
+}
+
+QNetworkCookieJar*
+BikeConnection::cookieJar() const
+{
+    return iPrivate->iCookieJar;
+}
+
+void
+BikeConnection::setCookieJar(
+    QNetworkCookieJar* aCookieJar)
+{
+    // Takes the ownership, like QNetworkAccessManager::setCookieJar does
+    if (aCookieJar && iPrivate->iCookieJar != aCookieJar) {
+        delete iPrivate->iCookieJar;
+        iPrivate->iCookieJar = aCookieJar;
+        aCookieJar->setParent(this);
+    }
+}
@@ -0,0 +1,418 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeExport.h"
+#include "BikeRideStore.h"
+#include "BikeTrace.h"
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QPointer>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTextStream>
+#include <QtCore/QThreadPool>
+
+#include "HarbourDebug.h"
+#include "HarbourTask.h"
+
+// ==========================================================================
+// BikeExport::Private
+// ==========================================================================
+
+class BikeExport::Private :
+    public QObject
+{
+    Q_OBJECT
+
+public:
+    class Task;
+
+    Private(BikeExport*);
+    ~Private();
+
+    BikeExport* parentObject();
+    void releaseTask();
+    void setProgress(qreal);
+
+private Q_SLOTS:
+    void onTaskProgress(int, int);
+    void onTaskDone();
+
+public:
+    QThreadPool* iThreadPool;
+    QPointer<BikeHistory> iHistory;
+    Task* iTask;
+    qreal iProgress;
+    QString iLastFile;
+};
+
+// ==========================================================================
+// BikeExport::Private::Task
+// ==========================================================================
+
+class BikeExport::Private::Task :
+    public HarbourTask
+{
+    Q_OBJECT
+
+public:
+    static const int PROGRESS_STEPS = 100;
+
+    Task(QThreadPool*, Format, const QString&, const BikeHistory::Index&,
+        const QJsonArray&);
+
+    static QString time(qint64);
+    static QString csv(const QString&);
+
+    void cancel();
+
+protected:
+    void performTask() Q_DECL_OVERRIDE;
+
+private:
+    void writeCsv(QTextStream&, const BikeRideStore::Ride&);
+    void writeJson(QTextStream&, const BikeRideStore::Ride&);
+
+Q_SIGNALS:
+    void progress(int, int);
+
+public:
+    const Format iFormat;
+    const QString iFile;
+    const QJsonArray iHistory;
+    const bool iHaveStore;
+    BikeRideStore iStore;
+    QAtomicInt iCancelled;
+    bool iOk;
+};
+
+BikeExport::Private::Task::Task(
+    QThreadPool* aPool,
+    Format aFormat,
+    const QString& aFile,
+    const BikeHistory::Index& aIndex,
+    const QJsonArray& aHistory) :
+    HarbourTask(aPool),
+    iFormat(aFormat),
+    iFile(aFile),
+    iHistory(aHistory),
+    iHaveStore(aIndex.iValid),
+    iStore(aIndex.iStore),
+    iCancelled(0),
+    iOk(false)
+{}
+
+// static
+QString
+BikeExport::Private::Task::time(
+    qint64 aTime)
+{
+    return aTime ? QDateTime::fromMSecsSinceEpoch(aTime * 1000, Qt::UTC).
+        toString(Qt::ISODate) : QString();
+}
+
+// static
+QString
+BikeExport::Private::Task::csv(
+    const QString& aText)
+{
+    // RFC 4180 quoting, only if necessary
+    if (aText.contains(QChar(',')) || aText.contains(QChar('"')) ||
+        aText.contains(QChar('\n'))) {
+        QString quoted(aText);
+
+        return QChar('"') + quoted.replace(QChar('"'), QStringLiteral("\"\"")) +
+            QChar('"');
+    }
+    return aText;
+}
+
+void
+BikeExport::Private::Task::cancel()
+{
+    iCancelled.storeRelease(1);
+}
+
+void
+BikeExport::Private::Task::writeCsv(
+    QTextStream& aOut,
+    const BikeRideStore::Ride& aRide)
+{
+    aOut << time(aRide.iDepartureTime) << ',' <<
+        time(aRide.iReturnTime) << ',' <<
+        csv(iStore.string(aRide.iBike)) << ',' <<
+        csv(iStore.string(aRide.iDepartureStation)) << ',' <<
+        csv(iStore.string(aRide.iReturnStation)) << ',' <<
+        aRide.iDistance << ',' << aRide.iDuration << '\n';
+}
+
+void
+BikeExport::Private::Task::writeJson(
+    QTextStream& aOut,
+    const BikeRideStore::Ride& aRide)
+{
+    aOut << QString::fromUtf8(QJsonDocument(iStore.toJson(aRide)).
+        toJson(QJsonDocument::Compact)) << '\n';
+}
+
+void
+BikeExport::Private::Task::performTask()
+{
+    BikeTrace::Span span("BikeExport::Task");
+
+    // The store is implicitly shared with the one the statistics are
+    // using. If there's none, build a compact one from the history.
+    if (!iHaveStore) {
+        iStore.update(iHistory);
+    }
+
+    const int n = iStore.count();
+    const int step = qMax(n / PROGRESS_STEPS, 1);
+    QSaveFile file(iFile);
+
+    QDir().mkpath(QFileInfo(iFile).absolutePath());
+    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QTextStream out(&file);
+        int i;
+
+        // QTextStream writes to the file in small chunks
+        out.setCodec("UTF-8");
+        if (iFormat == CSV) {
+            out << "departureDate,returnDate,bike,departureStation,"
+                "returnStation,distance,duration\n";
+        }
+        for (i = 0; i < n && !iCancelled.loadAcquire(); i++) {
+            if (iFormat == CSV) {
+                writeCsv(out, iStore.at(i));
+            } else {
+                writeJson(out, iStore.at(i));
+            }
+            if (!((i + 1) % step)) {
+                Q_EMIT progress(i + 1, n);
+            }
+        }
+        out.flush();
+        if (i < n) {
+            HDEBUG("Cancelled at" << i << "of" << n);
+        } else if (out.status() == QTextStream::Ok && file.commit()) {
+            HDEBUG("Wrote" << n << "ride(s) to" << qPrintable(iFile));
+            iOk = true;
+        } else {
+            HWARN("Failed to write" << qPrintable(iFile));
+        }
+    } else {
+        HWARN("Can't open" << qPrintable(iFile));
+    }
+}
+
+// ==========================================================================
+// BikeExport::Private
+// ==========================================================================
+
+BikeExport::Private::Private(
+    BikeExport* aParent) :
+    QObject(aParent),
+    iThreadPool(new QThreadPool(this)),
+    iTask(Q_NULLPTR),
+    iProgress(0)
+{
+    iThreadPool->setMaxThreadCount(1);
+}
+
+BikeExport::Private::~Private()
+{
+    releaseTask();
+}
+
+inline
+BikeExport*
+BikeExport::Private::parentObject()
+{
+    return qobject_cast<BikeExport*>(parent());
+}
+
+void
+BikeExport::Private::releaseTask()
+{
+    if (iTask) {
+        // The partially written file gets discarded
+        iTask->cancel();
+        iTask->release(this);
+        iTask = Q_NULLPTR;
+    }
+}
+
+void
+BikeExport::Private::setProgress(
+    qreal aProgress)
+{
+    if (iProgress != aProgress) {
+        iProgress = aProgress;
+        Q_EMIT parentObject()->progressChanged();
+    }
+}
+
+void
+BikeExport::Private::onTaskProgress(
+    int aDone,
+    int aTotal)
+{
+    if (sender() == iTask) {
+        setProgress(qreal(aDone) / aTotal);
+    }
+}
+
+void
+BikeExport::Private::onTaskDone()
+{
+    Task* task = qobject_cast<Task*>(sender());
+
+    if (task == iTask) {
+        BikeExport* obj = parentObject();
+
+        iTask = Q_NULLPTR;
+        if (task->iOk) {
+            setProgress(1);
+            if (iLastFile != task->iFile) {
+                iLastFile = task->iFile;
+                Q_EMIT obj->lastFileChanged();
+            }
+            Q_EMIT obj->busyChanged();
+            Q_EMIT obj->done(task->iFile);
+        } else {
+            Q_EMIT obj->busyChanged();
+            Q_EMIT obj->failed();
+        }
+    }
+    task->release(this);
+}
+
+// ==========================================================================
+// BikeExport
+// ==========================================================================
+
+BikeExport::BikeExport(
+    QObject* aParent) :
+    QObject(aParent),
+    iPrivate(new Private(this))
+{}
+
+BikeHistory*
+BikeExport::history() const
+{
+    return iPrivate->iHistory;
+}
+
+void
+BikeExport::setHistory(
+    BikeHistory* aHistory)
+{
+    if (iPrivate->iHistory != aHistory) {
+        iPrivate->iHistory = aHistory;
+        Q_EMIT historyChanged();
+    }
+}
+
+bool
+BikeExport::busy() const
+{
+    return iPrivate->iTask != Q_NULLPTR;
+}
+
+qreal
+BikeExport::progress() const
+{
+    return iPrivate->iProgress;
+}
+
+QString
+BikeExport::lastFile() const
+{
+    return iPrivate->iLastFile;
+}
+
+bool
+BikeExport::start(
+    Format aFormat)
+{
+    if (iPrivate->iTask) {
+        HDEBUG("Export is already in progress");
+        return false;
+    } else {
+        const QDir dir(QStandardPaths::writableLocation(QStandardPaths::
+            DocumentsLocation));
+        const QString name(QStringLiteral("fillari-") +
+            QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss") +
+            ((aFormat == CSV) ? QStringLiteral(".csv") :
+            QStringLiteral(".jsonl")));
+        const BikeHistory::Index index(BikeHistory::index(iPrivate->
+            iHistory));
+
+        // The rides may not even be loaded if the index is there
+        Private::Task* task = new Private::Task(iPrivate->iThreadPool,
+            aFormat, dir.filePath(name), index, index.iValid ? QJsonArray() :
+            BikeHistory::rides(iPrivate->iHistory));
+
+        HDEBUG("Exporting to" << qPrintable(task->iFile));
+        iPrivate->iTask = task;
+        iPrivate->connect(task, SIGNAL(progress(int,int)),
+            SLOT(onTaskProgress(int,int)));
+        task->submit(iPrivate, SLOT(onTaskDone()));
+        iPrivate->setProgress(0);
+        Q_EMIT busyChanged();
+        return true;
+    }
+}
+
+void
+BikeExport::cancel()
+{
+    if (iPrivate->iTask) {
+        HDEBUG("Cancelling export");
+        iPrivate->releaseTask();
+        iPrivate->setProgress(0);
+        Q_EMIT busyChanged();
+    }
+}
+
+#include "BikeExport.moc"
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_EXPORT_H
+#define BIKE_EXPORT_H
+
+#include "BikeHistory.h"
+
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+// Writes the completed rides from BikeHistory into a file in the
+// documents folder, oldest first. The rides are streamed from the ride
+// store on a worker thread, one line at a time.
+//
+// CSV has a header line followed by one line per ride. JSON Lines has
+// one object per line, with the same keys as the objects in the history.
+
+class BikeExport :
+    public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(BikeHistory* history READ history WRITE setHistory NOTIFY historyChanged)
+    Q_PROPERTY(bool busy READ busy NOTIFY busyChanged)
+    Q_PROPERTY(qreal progress READ progress NOTIFY progressChanged)
+    Q_PROPERTY(QString lastFile READ lastFile NOTIFY lastFileChanged)
+    Q_ENUMS(Format)
+
+public:
+    enum Format {
+        CSV,
+        JSONLines
+    };
+
+    BikeExport(QObject* aParent = Q_NULLPTR);
+
+    BikeHistory* history() const;
+    void setHistory(BikeHistory*);
+
+    bool busy() const;
+    qreal progress() const;
+    QString lastFile() const;
+
+    Q_INVOKABLE bool start(Format);
+    Q_INVOKABLE void cancel();
+
+Q_SIGNALS:
+    void historyChanged();
+    void busyChanged();
+    void progressChanged();
+    void lastFileChanged();
+    void done(QString aFile);
+    void failed();
+
+private:
+    class Private;
+    Private* iPrivate;
+};
+
+#endif // BIKE_EXPORT_H
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeHistory.h"
+#include "BikeTrace.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+
+#include "HarbourDebug.h"
+
+BikeHistory::Index::Index() :
+    iValid(false)
+{}
+
+BikeHistory::BikeHistory(
+    QObject* aParent) :
+    QObject(aParent),
+    iVersion(0),
+    iIndexVersion(0)
+{}
+
+BikeHistory::BikeHistory(
+    const QJsonArray& aRides,
+    QObject* aParent) :
+    QObject(aParent),
+    iRides(aRides),
+    iVersion(aRides.isEmpty() ? 0 : 1),
+    iIndexVersion(0)
+{}
+
+// static
+int
+BikeHistory::version(
+    const BikeHistory* aHistory)
+{
+    return aHistory ? aHistory->iVersion : 0;
+}
+
+// static
+QJsonArray
+BikeHistory::rides(
+    const BikeHistory* aHistory)
+{
+    return aHistory ? aHistory->rides() : QJsonArray();
+}
+
+// static
+BikeHistory::Index
+BikeHistory::index(
+    const BikeHistory* aHistory)
+{
+    return aHistory ? aHistory->index() : Index();
+}
+
+int
+BikeHistory::version() const
+{
+    return iVersion;
+}
+
+int
+BikeHistory::count() const
+{
+    // The index is always there if the rides haven't been loaded yet
+    return iRidesFile.isEmpty() ? iRides.count() : (iIndex.iStore.count() +
+        (iIndex.iStore.inProgress() ? 1 : 0));
+}
+
+const QJsonArray&
+BikeHistory::rides() const
+{
+    if (!iRidesFile.isEmpty()) {
+        loadRides();
+    }
+    return iRides;
+}
+
+void
+BikeHistory::loadRides() const
+{
+    BikeTrace::Span span("BikeHistory::loadRides");
+    QFile file(iRidesFile);
+
+    if (file.open(QIODevice::ReadOnly)) {
+        iRides = QJsonDocument::fromJson(file.readAll()).array();
+        HDEBUG("Loaded" << iRides.count() << "ride(s) from" <<
+            qPrintable(iRidesFile));
+    } else {
+        HWARN("Failed to open" << qPrintable(iRidesFile));
+    }
+    iRidesFile.clear();
+}
+
+void
+BikeHistory::setRides(
+    const QJsonArray& aRides)
+{
+    // This is the only place where the arrays get compared
+    if (rides() != aRides) {
+        const int prevCount = iRides.count();
+
+        iRides = aRides;
+        iVersion++;
+        HDEBUG("version" << iVersion << "," << iRides.count() << "ride(s)");
+        Q_EMIT versionChanged();
+        if (iRides.count() != prevCount) {
+            Q_EMIT countChanged();
+        }
+    }
+}
+
+void
+BikeHistory::setRides(
+    const QJsonArray& aRides,
+    const Index& aIndex)
+{
+    // Attach the index before anyone gets notified
+    if (rides() != aRides) {
+        iIndex = aIndex;
+        iIndexVersion = iVersion + 1;
+        setRides(aRides);
+        if (aIndex.iValid) {
+            Q_EMIT indexChanged();
+        }
+    } else if (aIndex.iValid && !index().iValid) {
+        setIndex(iVersion, aIndex);
+    }
+}
+
+void
+BikeHistory::setRides(
+    const QString& aFile,
+    const Index& aIndex)
+{
+    // Without comparing anything. The file is expected to match the
+    // index, there's no point in loading the rides if it doesn't.
+    const int prevCount = count();
+
+    HASSERT(aIndex.iValid);
+    iRides = QJsonArray();
+    iRidesFile = aFile;
+    iIndex = aIndex;
+    iIndexVersion = ++iVersion;
+    HDEBUG("version" << iVersion << "," << count() << "ride(s) in" <<
+        qPrintable(aFile));
+    Q_EMIT versionChanged();
+    if (count() != prevCount) {
+        Q_EMIT countChanged();
+    }
+    Q_EMIT indexChanged();
+}
+
+void
+BikeHistory::invalidate()
+{
+    // Same rides but whatever has been built from them (including the
+    // index) is no good. Bumping the version makes everyone rebuild.
+    const int prevCount = count();
+
+    rides();
+    iVersion++;
+    HDEBUG("version" << iVersion << "," << iRides.count() << "ride(s)");
+    Q_EMIT versionChanged();
+    if (iRides.count() != prevCount) {
+        Q_EMIT countChanged();
+    }
+}
+
+BikeHistory::Index
+BikeHistory::index() const
+{
+    return (iIndexVersion == iVersion) ? iIndex : Index();
+}
+
+void
+BikeHistory::setIndex(
+    int aVersion,
+    const Index& aIndex)
+{
+    // Index built for an older version is useless
+    if (aVersion == iVersion) {
+        iIndex = aIndex;
+        iIndexVersion = aVersion;
+        Q_EMIT indexChanged();
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_HISTORY_H
+#define BIKE_HISTORY_H
+
+#include "BikeRideStore.h"
+#include "BikeTimeBuckets.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QObject>
+
+// Shared handle to the ride history. The object is owned by whoever
+// fetches the history (normally BikeSession) and is passed around by
+// pointer, the version gets incremented every time the contents change.
+// That allows the consumers to detect changes without comparing arrays
+// and keeps the array out of the QML engine.
+//
+// The JSON array contains objects like this:
+//
+// {
+//   "bike": "XXXX",
+//   "departureDate": "2025-05-30T01:24:21Z",
+//   "departureStation": "XXX yyyyyyyyy",
+//   "distance": 1341,
+//   "duration": 509,
+//   "providerName": "helsinki-espoo",
+//   "returnDate": "2025-05-30T01:32:56Z",
+//   "returnStation": "XXX yyyyyyyyy"
+// }
+//
+// Most recent rides come first.
+//
+// BikeHistoryStats attaches the aggregates it builds to the history
+// (see Index). Those remain valid until the next change. The owner may
+// carry them along with the rides and give them back to setRides(),
+// saving the next user of the history a rebuild.
+//
+// If the owner has a valid index, the rides themselves may be left in
+// a file (containing the JSON array) and only parsed when someone asks
+// for them. Consumers which can work off the index shouldn't ask.
+
+class BikeHistory :
+    public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int version READ version NOTIFY versionChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    struct Index {
+        Index();
+
+        bool iValid;
+        BikeRideStore iStore;
+        BikeTimeBuckets iBuckets;
+    };
+
+    BikeHistory(QObject* aParent = Q_NULLPTR);
+    BikeHistory(const QJsonArray&, QObject* aParent = Q_NULLPTR);
+
+    int version() const;
+    int count() const;
+    const QJsonArray& rides() const;
+
+    void setRides(const QJsonArray&);
+    void setRides(const QJsonArray&, const Index&);
+    void setRides(const QString&, const Index&);
+    void invalidate();
+
+    Index index() const;
+    void setIndex(int, const Index&);
+
+    static int version(const BikeHistory*);
+    static QJsonArray rides(const BikeHistory*);
+    static Index index(const BikeHistory*);
+
+Q_SIGNALS:
+    void versionChanged();
+    void countChanged();
+    void indexChanged();
+
+private:
+    void loadRides() const;
+
+private:
+    mutable QJsonArray iRides;
+    mutable QString iRidesFile;
+    int iVersion;
+    Index iIndex;
+    int iIndexVersion;
+};
+
+#endif // BIKE_HISTORY_H
@@ -37,13 +37,22 @@
  */
 
 #include "BikeHistoryModel.h"
+#include "BikeRideStore.h"
+#include "BikeSearchIndex.h"
 
+#include <QtCore/QBitArray>
 #include <QtCore/QDateTime>
 #include <QtCore/QJsonObject>
+#include <QtCore/QPair>
+#include <QtCore/QPointer>
 #include <QtCore/QTimer>
+#include <QtCore/QVector>
 
 #include "HarbourDebug.h"
 
+#include <algorithm>
+#include <iterator>
+
 #define ROLES_(first,role,last) \
     first(Bike,bike) \
     role(DepartureDate,departureDate) \
@@ -57,68 +66,6 @@
 #define ROLES(role) \
     ROLES_(role,role,role)
 
-// ==========================================================================
-// BikeHistoryModel::Ride
-// ==========================================================================
-
-class BikeHistoryModel::Ride
-{
-public:
-    // e.g. static const QString BikeKey;
-    #define KEY_(X) X##Key
-    #define ROLE(X,x) static const QString KEY_(X);
-    ROLES(ROLE)
-    #undef ROLE
-
-    Ride(const QJsonObject&);
-
-    static QDateTime date(const QJsonObject&, const QString&);
-    bool inProgress() const;
-
-public:
-    QString iBike;
-    QDateTime iDepartureDate;
-    QString iDepartureStation;
-    QDateTime iReturnDate;
-    QString iReturnStation;
-    int iMonth;
-    int iDistance;
-    int iDuration;
-};
-
-// e.g. const QString BikeHistoryModel::Ride::BikeKey("bike");
-#define ROLE(X,x) const QString BikeHistoryModel::Ride::KEY_(X)(#x);
-ROLES(ROLE)
-#undef ROLE
-
-//static
-inline
-QDateTime BikeHistoryModel::Ride::date(
-    const QJsonObject& aJson,
-    const QString& aKey)
-{
-    return QDateTime::fromString(aJson.value(aKey).toString(), Qt::ISODate);
-}
-
-BikeHistoryModel::Ride::Ride(
-    const QJsonObject& aJson) :
-    iBike(aJson.value(BikeKey).toString()),
-    iDepartureDate(date(aJson, DepartureDateKey)),
-    iDepartureStation(aJson.value(DepartureStationKey).toString()),
-    iReturnDate(date(aJson, ReturnDateKey)),
-    iReturnStation(aJson.value(ReturnStationKey).toString()),
-    iMonth(iDepartureDate.date().month()),
-    iDistance(aJson.value(DistanceKey).toInt()),
-    iDuration(aJson.value(DurationKey).toInt())
-{}
-
-bool
-BikeHistoryModel::Ride::inProgress() const
-{
-    return iDepartureDate.isValid() && !iDepartureStation.isEmpty() &&
-        !iReturnDate.isValid() && iReturnStation.isEmpty();
-}
-
 // ==========================================================================
 // BikeHistoryModel::Private
 // ==========================================================================
@@ -144,19 +91,63 @@ public:
     // Somehow this stupid enum unconfuses it :/
     enum { _ };
 
+    enum { SortOrderCount = BikeHistoryModel::Station + 1 };
+
+    // Orders store indices by the sort key
+    class KeyLess {
+    public:
+        KeyLess(const QVector<qint64>& aKeys) : iKeys(aKeys) {}
+        bool operator()(int aFirst, int aSecond) const
+            { return iKeys.at(aFirst) < iKeys.at(aSecond); }
+    private:
+        const QVector<qint64>& iKeys;
+    };
+
     Private(BikeHistoryModel*);
 
+    static QVariant dateTime(qint64);
+
     BikeHistoryModel* parentModel();
-    bool acceptEntry(const QJsonObject&);
-    void updateHistory();
+    bool acceptRide(const BikeRideStore::Ride&);
+    bool full() const;
+    bool recent() const;
+    int rowCount() const;
+    int storeIndex(int) const;
+    void appendRange(const BikeRideStore::Range&);
+    void appendSearchResults();
+    void invalidateOrder();
+    void mergeOrder(int);
+    QVector<qint64> sortKeys(BikeHistoryModel::SortOrder) const;
+    const QVector<int>& sortedOrder();
+    void sortRows();
+    void setHistory(BikeHistory*);
+    bool updateStore();
+    void updateRows();
+    void updateRecent();
+    void updateRideDuration();
+    void updateRideDurationTimer();
+    QVariant data(int, Role) const;
 
 private Q_SLOTS:
+    void onHistoryVersionChanged();
     void onRideDurationTimer();
 
 public:
     QTimer* iRideDurationTimer;
-    QJsonArray iHistory;
-    QList<Ride> iRides;
+    QPointer<BikeHistory> iHistory;
+    int iHistoryVersion;
+    BikeRideStore iStore;
+    QVector<int> iRows;     // Store indices, -1 is the ride in progress
+    bool iRecent;           // The newest rides, iRows isn't used
+    bool iCurrentRow;       // Recent rides start with the ride in progress
+    int iTop;               // Store index after the newest recent ride
+    int iWindow;            // Number of recent rides (not counting current)
+    BikeSearchIndex iSearchIndex;
+    BikeSearchIndex::Query iQuery;
+    QString iSearchText;
+    BikeHistoryModel::SortOrder iSortOrder;
+    QVector<int> iOrder[SortOrderCount];    // Permutations of the store
+    int iRideDuration;      // Of the ride in progress
     int iYear;
     int iMonth; // 1=Jan etc.
     int iMaxCount;
@@ -166,11 +157,26 @@ BikeHistoryModel::Private::Private(
     BikeHistoryModel* aParent) :
     QObject(aParent),
     iRideDurationTimer(Q_NULLPTR),
+    iHistoryVersion(0),
+    iRecent(false),
+    iCurrentRow(false),
+    iTop(0),
+    iWindow(0),
+    iSortOrder(BikeHistoryModel::Newest),
+    iRideDuration(0),
     iYear(0),
     iMonth(0),
     iMaxCount(0)
 {}
 
+// static
+QVariant
+BikeHistoryModel::Private::dateTime(
+    qint64 aTime)
+{
+    return aTime ? QDateTime::fromMSecsSinceEpoch(aTime * 1000) : QDateTime();
+}
+
 inline
 BikeHistoryModel*
 BikeHistoryModel::Private::parentModel()
@@ -179,13 +185,13 @@ BikeHistoryModel::Private::parentModel()
 }
 
 bool
-BikeHistoryModel::Private::acceptEntry(
-    const QJsonObject& aEntry)
+BikeHistoryModel::Private::acceptRide(
+    const BikeRideStore::Ride& aRide)
 {
     if (!iYear && !iMonth) {
         return true;
     } else {
-        QDate date(Ride::date(aEntry, Ride::DepartureDateKey).date());
+        const QDate date(aRide.date());
 
         if (date.isValid()) {
             if (iYear) {
@@ -200,42 +206,408 @@ BikeHistoryModel::Private::acceptEntry(
     return false;
 }
 
+inline
+bool
+BikeHistoryModel::Private::full() const
+{
+    // When sorting, the limit is applied to the sorted rows
+    return iMaxCount && iSortOrder == BikeHistoryModel::Newest &&
+        iRows.count() >= iMaxCount;
+}
+
+inline
+bool
+BikeHistoryModel::Private::recent() const
+{
+    // The newest maxCount rides, no filtering, no sorting
+    return iMaxCount > 0 && !iYear && !iMonth && iQuery.isEmpty() &&
+        iSortOrder == BikeHistoryModel::Newest;
+}
+
+inline
+int
+BikeHistoryModel::Private::rowCount() const
+{
+    return iRecent ? (iCurrentRow ? 1 : 0) + iWindow : iRows.count();
+}
+
+int
+BikeHistoryModel::Private::storeIndex(
+    int aRow) const
+{
+    if (iRecent) {
+        // The window is the tail of the store, newest first
+        const int first = iCurrentRow ? 1 : 0;
+
+        return (aRow < first) ? -1 : (iTop - 1 - (aRow - first));
+    } else {
+        return iRows.at(aRow);
+    }
+}
+
+void
+BikeHistoryModel::Private::appendRange(
+    const BikeRideStore::Range& aRange)
+{
+    // Most recent rides come first
+    for (int i = aRange.iEnd - 1; i >= aRange.iFirst && !full(); i--) {
+        iRows.append(i);
+    }
+}
+
+void
+BikeHistoryModel::Private::appendSearchResults()
+{
+    // The index is only built once it's needed, and then kept up to date
+    iSearchIndex.update(iStore);
+
+    const QVector<int> found(iSearchIndex.find(iStore, iQuery));
+
+    for (int i = found.count() - 1; i >= 0 && !full(); i--) {
+        const int pos = found.at(i);
+
+        if (acceptRide(iStore.at(pos))) {
+            iRows.append(pos);
+        }
+    }
+}
+
 void
-BikeHistoryModel::Private::updateHistory()
+BikeHistoryModel::Private::invalidateOrder()
+{
+    for (int i = 0; i < SortOrderCount; i++) {
+        iOrder[i].clear();
+    }
+}
+
+void
+BikeHistoryModel::Private::mergeOrder(
+    int aKept)
+{
+    // The rides at and after aKept are new. They get sorted separately and
+    // merged into the permutations which have already been computed, which
+    // is O(n) rather than O(n log n) of sorting everything from scratch.
+    // Adding strings doesn't change the relative order of the existing
+    // ones, so that works for the station order too.
+    const int n = iStore.count();
+
+    for (int i = 0; i < SortOrderCount; i++) {
+        QVector<int>& order = iOrder[i];
+
+        if (!aKept || order.count() != aKept) {
+            order.clear();
+        } else if (n > aKept) {
+            const QVector<qint64> keys(sortKeys((BikeHistoryModel::
+                SortOrder)i));
+            QVector<int> added;
+            QVector<int> merged;
+
+            // Most recent first, so that it's the tie breaker
+            added.reserve(n - aKept);
+            for (int k = n - 1; k >= aKept; k--) {
+                added.append(k);
+            }
+            std::stable_sort(added.begin(), added.end(), KeyLess(keys));
+
+            // std::merge takes the equivalent elements from the first range
+            // first, the new rides are more recent than the old ones
+            merged.reserve(n);
+            std::merge(added.constBegin(), added.constEnd(),
+                order.constBegin(), order.constEnd(),
+                std::back_inserter(merged), KeyLess(keys));
+            order = merged;
+            HDEBUG("Merged" << (n - aKept) << "ride(s) into sort order" << i);
+        }
+    }
+}
+
+QVector<qint64>
+BikeHistoryModel::Private::sortKeys(
+    BikeHistoryModel::SortOrder aOrder) const
+{
+    const int n = iStore.count();
+    QVector<qint64> keys(n);
+    QVector<int> ranks;
+
+    if (aOrder == BikeHistoryModel::Station) {
+        // Rank the strings alphabetically
+        const int strings = iStore.stringCount();
+        QVector<QPair<QString,int> > sorted;
+
+        sorted.reserve(strings);
+        for (int i = 0; i < strings; i++) {
+            sorted.append(qMakePair(iStore.string(i), i));
+        }
+        std::sort(sorted.begin(), sorted.end(),
+            [] (const QPair<QString,int>& a, const QPair<QString,int>& b) {
+                return QString::localeAwareCompare(a.first, b.first) < 0;
+            });
+        ranks.resize(strings);
+        for (int i = 0; i < strings; i++) {
+            ranks[sorted.at(i).second] = i;
+        }
+    }
+
+    // Descending orders use negative keys
+    for (int i = 0; i < n; i++) {
+        const BikeRideStore::Ride& ride = iStore.at(i);
+
+        switch (aOrder) {
+        case BikeHistoryModel::Newest:
+            keys[i] = -i;
+            break;
+        case BikeHistoryModel::Distance:
+            keys[i] = -ride.iDistance;
+            break;
+        case BikeHistoryModel::Duration:
+            keys[i] = -ride.iDuration;
+            break;
+        case BikeHistoryModel::Speed:
+            // mm/s
+            keys[i] = ride.iDuration > 0 ?
+                -(qint64(ride.iDistance) * 1000 / ride.iDuration) : 0;
+            break;
+        case BikeHistoryModel::Station:
+            keys[i] = ranks.value(ride.iDepartureStation);
+            break;
+        }
+    }
+    return keys;
+}
+
+const QVector<int>&
+BikeHistoryModel::Private::sortedOrder()
+{
+    // Computed once per sort order, then kept up to date by mergeOrder()
+    QVector<int>& order = iOrder[iSortOrder];
+    const int n = iStore.count();
+
+    if (order.count() != n) {
+        const QVector<qint64> keys(sortKeys(iSortOrder));
+
+        // Start with the most recent first, so that it's the tie breaker
+        order.resize(n);
+        for (int i = 0; i < n; i++) {
+            order[i] = n - 1 - i;
+        }
+        std::stable_sort(order.begin(), order.end(), KeyLess(keys));
+        HDEBUG("Sort order" << iSortOrder << "for" << n << "ride(s)");
+    }
+    return order;
+}
+
+void
+BikeHistoryModel::Private::sortRows()
+{
+    // O(n) pass over the precomputed permutation
+    const QVector<int>& order = sortedOrder();
+    const int first = (!iRows.isEmpty() && iRows.first() < 0) ? 1 : 0;
+    QBitArray selected(iStore.count());
+
+    for (int i = first; i < iRows.count(); i++) {
+        selected.setBit(iRows.at(i));
+    }
+    iRows.resize(first);
+    for (int i = 0; i < order.count() &&
+         (!iMaxCount || iRows.count() < iMaxCount); i++) {
+        const int pos = order.at(i);
+
+        if (selected.testBit(pos)) {
+            iRows.append(pos);
+        }
+    }
+}
+
+void
+BikeHistoryModel::Private::setHistory(
+    BikeHistory* aHistory)
+{
+    if (iHistory) {
+        iHistory->disconnect(this);
+    }
+    iHistory = aHistory;
+    iHistoryVersion = BikeHistory::version(aHistory);
+    if (aHistory) {
+        connect(aHistory, SIGNAL(versionChanged()),
+            SLOT(onHistoryVersionChanged()));
+    }
+    invalidateOrder();
+    updateStore();
+    updateRows();
+}
+
+void
+BikeHistoryModel::Private::onHistoryVersionChanged()
+{
+    const int version = BikeHistory::version(iHistory);
+
+    if (iHistoryVersion != version) {
+        const int prevCount = iStore.count();
+        const bool extended = updateStore();
+
+        iHistoryVersion = version;
+        if (extended) {
+            mergeOrder(prevCount);
+        } else {
+            invalidateOrder();
+        }
+        if (extended && iRecent && recent()) {
+            updateRecent();
+        } else {
+            updateRows();
+        }
+    }
+}
+
+bool
+BikeHistoryModel::Private::updateStore()
+{
+    // Returns true if the previously known rides have been kept intact
+    const BikeHistory::Index index(BikeHistory::index(iHistory));
+    const int n = iStore.count();
+
+    if (index.iValid) {
+        // Reuse the store (possibly memory mapped) if it's available
+        const BikeRideStore prev(iStore);
+
+        iStore = index.iStore;
+        return !n || (iStore.count() >= n && iStore.at(0) == prev.at(0) &&
+            iStore.at(n - 1) == prev.at(n - 1));
+    } else {
+        return iStore.update(BikeHistory::rides(iHistory)) == n;
+    }
+}
+
+void
+BikeHistoryModel::Private::updateRows()
 {
     BikeHistoryModel* model = parentModel();
-    const int n = iHistory.count();
-    int pos = 0;
+    const BikeRideStore::Ride* current = iStore.inProgress();
+    const int n = iStore.count();
 
-    // Take a simple approach - reset the model
+    // Take a simple approach - reset the model. The rows are only
+    // located here, the data are fetched from the store on demand.
     model->beginResetModel();
-    for (int i = 0; i < n && (!iMaxCount || pos < iMaxCount); i++) {
-        QJsonObject entry(iHistory.at(i).toObject());
-
-        if (acceptEntry(entry)) {
-            const Ride ride(entry);
+    iRows.resize(0);
+    iRecent = recent();
+    if (iRecent) {
+        // The window is enough, no need to locate the rows
+        iCurrentRow = (current != Q_NULLPTR);
+        iTop = n;
+        iWindow = qMax(qMin(n, iMaxCount - (iCurrentRow ? 1 : 0)), 0);
+        HDEBUG(iWindow << "recent ride(s) out of" << n);
+    } else {
+        if (current && acceptRide(*current) && (iQuery.isEmpty() ||
+            BikeSearchIndex::matches(iStore, *current, iQuery))) {
+            iRows.append(-1);
+        }
 
-            if (iRides.count() <= pos) {
-                iRides.append(ride);
-            } else {
-                iRides[pos] = ride;
+        if (!iQuery.isEmpty()) {
+            appendSearchResults();
+        } else if (!iYear && !iMonth) {
+            BikeRideStore::Range all;
+
+            all.iFirst = 0;
+            all.iEnd = n;
+            appendRange(all);
+        } else if (iYear) {
+            appendRange(iMonth ? iStore.monthRange(iYear, iMonth) :
+                iStore.yearRange(iYear));
+        } else if (n > 0) {
+            const QDate first(iStore.at(0).date());
+            const int lastYear = iStore.at(n - 1).date().year();
+            const int firstYear = first.isValid() ? first.year() : lastYear;
+
+            for (int year = lastYear; year >= firstYear && !full(); year--) {
+                appendRange(iStore.monthRange(year, iMonth));
             }
-            pos++;
         }
+        if (iSortOrder != BikeHistoryModel::Newest) {
+            sortRows();
+        }
+        HDEBUG(iRows.count() << "ride(s) out of" << n);
     }
-    while (iRides.count() > pos) {
-        iRides.removeLast();
+    updateRideDurationTimer();
+    model->endResetModel();
+}
+
+void
+BikeHistoryModel::Private::updateRecent()
+{
+    // The store has only been extended, i.e. the rows that are already
+    // there remain valid. Only the difference gets signaled, which costs
+    // O(1) per new ride regardless of the size of the history.
+    BikeHistoryModel* model = parentModel();
+    const QModelIndex parent;
+    const int n = iStore.count();
+    const bool current = (iStore.inProgress() != Q_NULLPTR);
+    const int window = qMax(qMin(n, iMaxCount - (current ? 1 : 0)), 0);
+    const int added = qMin(n - iTop, window);
+    const int keep = window - added;
+
+    HDEBUG(added << "new ride(s)," << keep << "kept");
+    updateRideDuration();
+    if (iCurrentRow && !current) {
+        model->beginRemoveRows(parent, 0, 0);
+        iCurrentRow = false;
+        model->endRemoveRows();
     }
-    HDEBUG(iRides.count() << "ride(s)");
-    if (!iRides.isEmpty() &&
-        iRides.first().inProgress() &&
-        iRides.first().iDepartureDate.isValid()) {
-        Ride& currentRide = iRides.first();
-        const QDateTime now(QDateTime::currentDateTime());
-        const qint64 secs = currentRide.iDepartureDate.secsTo(now);
-
-        currentRide.iDuration = qMax(int(secs), 0);
-        HDEBUG("Ride in progress" << currentRide.iDuration << "sec");
+
+    const int first = iCurrentRow ? 1 : 0;
+
+    if (keep < iWindow) {
+        // Older rides fall off the bottom
+        model->beginRemoveRows(parent, first + keep, first + iWindow - 1);
+        iWindow = keep;
+        model->endRemoveRows();
+    } else if (keep > iWindow) {
+        // There's room for more of the older ones
+        model->beginInsertRows(parent, first + iWindow, first + keep - 1);
+        iWindow = keep;
+        model->endInsertRows();
+    }
+
+    if (added > 0) {
+        model->beginInsertRows(parent, first, first + added - 1);
+        iTop = n;
+        iWindow += added;
+        model->endInsertRows();
+    }
+    iTop = n;
+
+    if (current) {
+        if (iCurrentRow) {
+            // The ride in progress may have changed
+            const QModelIndex index(model->index(0));
+
+            Q_EMIT model->dataChanged(index, index);
+        } else {
+            model->beginInsertRows(parent, 0, 0);
+            iCurrentRow = true;
+            model->endInsertRows();
+        }
+    }
+    updateRideDurationTimer();
+}
+
+void
+BikeHistoryModel::Private::updateRideDuration()
+{
+    const BikeRideStore::Ride* current = iStore.inProgress();
+    const qint64 now = QDateTime::currentMSecsSinceEpoch() / 1000;
+
+    iRideDuration = current ? qMax(int(now - current->iDepartureTime), 0) : 0;
+}
+
+void
+BikeHistoryModel::Private::updateRideDurationTimer()
+{
+    const BikeRideStore::Ride* current = iStore.inProgress();
+
+    if (current && current->iDepartureTime && rowCount() > 0 &&
+        storeIndex(0) < 0) {
+        updateRideDuration();
+        HDEBUG("Ride in progress" << iRideDuration << "sec");
         if (!iRideDurationTimer) {
             iRideDurationTimer = new QTimer(this);
             iRideDurationTimer->setInterval(1000);
@@ -247,28 +619,45 @@ BikeHistoryModel::Private::updateHistory()
         delete iRideDurationTimer;
         iRideDurationTimer = Q_NULLPTR;
     }
-    model->endResetModel();
 }
 
 void
 BikeHistoryModel::Private::onRideDurationTimer()
 {
-    Ride& currentRide = iRides.first();
+    const int prevDuration = iRideDuration;
 
-    if (currentRide.iDepartureDate.isValid()) {
-        const QDateTime now(QDateTime::currentDateTime());
-        const qint64 secs = currentRide.iDepartureDate.secsTo(now);
+    updateRideDuration();
+    if (iRideDuration > prevDuration) {
+        BikeHistoryModel* model = parentModel();
+        const QModelIndex index(model->index(0));
+        const QVector<int> role(1, DurationRole);
 
-        if (secs > currentRide.iDuration) {
-            BikeHistoryModel* model = parentModel();
-            const QModelIndex index(model->index(0));
-            const QVector<int> role(1, DurationRole);
+        HDEBUG(iRideDuration);
+        Q_EMIT model->dataChanged(index, index, role);
+    }
+}
 
-            HDEBUG(secs);
-            currentRide.iDuration = int(secs);
-            Q_EMIT model->dataChanged(index, index, role);
-        }
+QVariant
+BikeHistoryModel::Private::data(
+    int aRow,
+    Role aRole) const
+{
+    const int pos = storeIndex(aRow);
+    const BikeRideStore::Ride& ride = (pos < 0) ?
+        *iStore.inProgress() : iStore.at(pos);
+
+    switch (aRole) {
+    case BikeRole: return iStore.string(ride.iBike);
+    case DepartureDateRole: return dateTime(ride.iDepartureTime);
+    case DepartureStationRole: return iStore.string(ride.iDepartureStation);
+    case DistanceRole: return ride.iDistance;
+    case DurationRole: return (pos < 0) ? iRideDuration : ride.iDuration;
+    case ReturnDateRole: return dateTime(ride.iReturnTime);
+    case ReturnStationRole: return iStore.string(ride.iReturnStation);
+    case MonthRole: return ride.date().month();
+    case InProgressRole: return (pos < 0);
     }
+    return QVariant();
 }
 
 // ==========================================================================
@@ -281,7 +670,7 @@ BikeHistoryModel::BikeHistoryModel(
     iPrivate(new Private(this))
 {}
 
-QJsonArray
+BikeHistory*
 BikeHistoryModel::history() const
 {
     return iPrivate->iHistory;
@@ -289,11 +678,10 @@ BikeHistoryModel::history() const
 
 void
 BikeHistoryModel::setHistory(
-    QJsonArray aHistory)
+    BikeHistory* aHistory)
 {
     if (iPrivate->iHistory != aHistory) {
-        iPrivate->iHistory = aHistory;
-        iPrivate->updateHistory();
+        iPrivate->setHistory(aHistory);
         Q_EMIT historyChanged();
     }
 }
@@ -311,7 +699,7 @@ BikeHistoryModel::setYear(
     if (iPrivate->iYear != aYear) {
         iPrivate->iYear = aYear;
         HDEBUG(aYear);
-        iPrivate->updateHistory();
+        iPrivate->updateRows();
         Q_EMIT yearChanged();
     }
 }
@@ -329,7 +717,7 @@ BikeHistoryModel::setMonth(
     if (iPrivate->iMonth!= aMonth) {
         iPrivate->iMonth = aMonth;
         HDEBUG(aMonth);
-        iPrivate->updateHistory();
+        iPrivate->updateRows();
         Q_EMIT monthChanged();
     }
 }
@@ -347,17 +735,54 @@ BikeHistoryModel::setMaxCount(
     if (iPrivate->iMaxCount != aMaxCount) {
         iPrivate->iMaxCount = aMaxCount;
         HDEBUG(aMaxCount);
-        iPrivate->updateHistory();
+        iPrivate->updateRows();
         Q_EMIT maxCountChanged();
     }
 }
 
+QString
+BikeHistoryModel::searchText() const
+{
+    return iPrivate->iSearchText;
+}
+
+void
+BikeHistoryModel::setSearchText(
+    QString aText)
+{
+    if (iPrivate->iSearchText != aText) {
+        iPrivate->iSearchText = aText;
+        iPrivate->iQuery = BikeSearchIndex::parse(aText);
+        HDEBUG(aText);
+        iPrivate->updateRows();
+        Q_EMIT searchTextChanged();
+    }
+}
+
+BikeHistoryModel::SortOrder
+BikeHistoryModel::sortOrder() const
+{
+    return iPrivate->iSortOrder;
+}
+
+void
+BikeHistoryModel::setSortOrder(
+    SortOrder aSortOrder)
+{
+    if (iPrivate->iSortOrder != aSortOrder) {
+        iPrivate->iSortOrder = aSortOrder;
+        HDEBUG(aSortOrder);
+        iPrivate->updateRows();
+        Q_EMIT sortOrderChanged();
+    }
+}
+
 // static
 bool
 BikeHistoryModel::rideInProgress(
     QJsonObject aObject)
 {
-    return Ride(aObject).inProgress();
+    return BikeRideStore::isInProgress(aObject);
 }
 
 QString
@@ -383,7 +808,7 @@ int
 BikeHistoryModel::rowCount(
     const QModelIndex&) const
 {
-    return iPrivate->iRides.count();
+    return iPrivate->rowCount();
 }
 
 QVariant
@@ -393,17 +818,8 @@ BikeHistoryModel::data(
 {
     const int row = aIndex.row();
 
-    if (row >= 0 && row < iPrivate->iRides.count()) {
-        const Ride& ride = iPrivate->iRides.at(row);
-
-        switch ((Private::Role)aRole) {
-        #define ROLE(X,x) case Private::ROLE_(X): return ride.i##X;
-        ROLES(ROLE)
-        #undef ROLE
-        case Private::ROLE_(InProgress): return ride.inProgress();
-        }
-    }
-    return QVariant();
+    return (row >= 0 && row < iPrivate->rowCount()) ?
+        iPrivate->data(row, (Private::Role)aRole) : QVariant();
 }
 
 #include "BikeHistoryModel.moc"
@@ -40,36 +40,44 @@
 #define BIKE_HISTORY_MODEL_H
 
 #include <QtCore/QAbstractListModel>
-#include <QtCore/QJsonArray>
 
-// The JSON array contains objects like this:
-//
-// {
-//   "bike": "XXXX",
-//   "departureDate": "2025-05-30T01:24:21Z",
-//   "departureStation": "XXX yyyyyyyyy",
-//   "distance": 1341,
-//   "duration": 509,
-//   "providerName": "helsinki-espoo",
-//   "returnDate": "2025-05-30T01:32:56Z",
-//   "returnStation": "XXX yyyyyyyyy"
-// }
+#include "BikeHistory.h"
+
+// Rides from BikeHistory, optionally filtered by year and month and
+// by the search text (see BikeSearchIndex for the syntax). The ride in
+// progress (if any) always comes first, the rest is sorted according
+// to sortOrder. The maxCount limit is applied after sorting.
 //
+// Without any filters, the newest maxCount rides are just the tail of
+// the store. Such a window is maintained incrementally, subsequent history
+// updates only insert and remove the affected rows instead of resetting
+// the whole model.
 
 class BikeHistoryModel :
     public QAbstractListModel
 {
     Q_OBJECT
-    Q_PROPERTY(QJsonArray history READ history WRITE setHistory NOTIFY historyChanged)
+    Q_PROPERTY(BikeHistory* history READ history WRITE setHistory NOTIFY historyChanged)
     Q_PROPERTY(int year READ year WRITE setYear NOTIFY yearChanged)
     Q_PROPERTY(int month READ month WRITE setMonth NOTIFY monthChanged)
     Q_PROPERTY(int maxCount READ maxCount WRITE setMaxCount NOTIFY maxCountChanged)
+    Q_PROPERTY(QString searchText READ searchText WRITE setSearchText NOTIFY searchTextChanged)
+    Q_PROPERTY(SortOrder sortOrder READ sortOrder WRITE setSortOrder NOTIFY sortOrderChanged)
+    Q_ENUMS(SortOrder)
 
 public:
+    enum SortOrder {
+        Newest,         // Server order, most recent first
+        Distance,       // Longest first
+        Duration,       // Longest first
+        Speed,          // Fastest first
+        Station         // Departure station, alphabetically
+    };
+
     BikeHistoryModel(QObject* aParent = Q_NULLPTR);
 
-    QJsonArray history() const;
-    void setHistory(QJsonArray);
+    BikeHistory* history() const;
+    void setHistory(BikeHistory*);
 
     int year() const;
     void setYear(int);
@@ -80,6 +88,12 @@ public:
     int maxCount() const;
     void setMaxCount(int);
 
+    QString searchText() const;
+    void setSearchText(QString);
+
+    SortOrder sortOrder() const;
+    void setSortOrder(SortOrder);
+
     static bool rideInProgress(QJsonObject);
     Q_INVOKABLE QString monthName(int);
 
@@ -93,9 +107,10 @@ Q_SIGNALS:
     void yearChanged();
     void monthChanged();
     void maxCountChanged();
+    void searchTextChanged();
+    void sortOrderChanged();
 
 private:
-    class Ride;
     class Private;
     Private* iPrivate;
 };
@@ -38,8 +38,6 @@
 
 #include "BikeHistoryQuery.h"
 
-#include "BikeApp.h"
-
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonDocument>
@@ -47,10 +45,10 @@
 #include "HarbourDebug.h"
 
 BikeHistoryQuery::BikeHistoryQuery(
-    QNetworkAccessManager* aParent) :
+    BikeConnection* aParent) :
     BikeRequest(aParent)
 {
-    connect(get(BIKE_API_URL("citybikes/rentals"), jsonApiHeaders()),
+    connect(get(apiUrl("citybikes/rentals"), jsonApiHeaders()),
         SIGNAL(finished()), SLOT(onQueryFinished()));
 }
 
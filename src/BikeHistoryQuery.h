@@ -65,7 +65,7 @@ class BikeHistoryQuery :
     Q_OBJECT
 
 public:
-    BikeHistoryQuery(QNetworkAccessManager*);
+    BikeHistoryQuery(BikeConnection*);
 
 Q_SIGNALS:
     void finished(const QJsonArray&);
@@ -37,30 +37,36 @@
  */
 
 #include "BikeHistoryStats.h"
+#include "BikeRideStore.h"
+#include "BikeTrace.h"
 #include "Fillari.h"
 
 #include <QtCore/QDate>
-#include <QtCore/QDateTime>
-#include <QtCore/QHash>
-#include <QtCore/QList>
-#include <QtCore/QJsonObject>
+#include <QtCore/QPointer>
+#include <QtCore/QThreadPool>
 #include <QtCore/QVector>
 
 #include "HarbourDebug.h"
 #include "HarbourParentSignalQueueObject.h"
-
-#define X12(x) x(0) x(1) x(2) x(3) x(4) x(5) x(6) x(7) x(8) x(9) x(10) x(11)
+#include "HarbourTask.h"
 
 // s(SignalName,signalName)
 #define QUEUED_SIGNALS(s) \
     s(History,history) \
     s(Mode,mode) \
+    s(Resolution,resolution) \
     s(Year,year) \
     s(MaxValue,maxValue) \
     s(Total,total)
 
 // ==========================================================================
 // BikeHistoryStats::Private
+//
+// Nothing gets recalculated when the properties are being set. Instead,
+// the stats are marked dirty and the update is scheduled for the end of
+// the current event loop iteration. That update submits the aggregation
+// to the worker thread. Reading the stats before the results arrive from
+// the worker thread makes them recalculated synchronously.
 // ==========================================================================
 
 enum BikeHistoryStatsSignal {
@@ -77,53 +83,77 @@ typedef HarbourParentSignalQueueObject<BikeHistoryStats,
 class BikeHistoryStats::Private :
     public BikeHistoryStatsPrivateBase
 {
+    Q_OBJECT
+
     static const SignalEmitter gSignalEmitters[];
 
 public:
-    enum {
-        Months = 12
-    };
+    class Task;
 
-    enum Role {
-        RoleMonth = Qt::UserRole,
-        RoleValue
-    };
+    typedef BikeTimeBuckets::Totals Totals;
 
-    struct Stats {
-        uint iRides;
-        uint iDistance;
-        uint iDuration;
+    enum Role {
+        RoleLabel = Qt::UserRole,
+        RoleValue,
+        RoleText
     };
 
-    struct Stash {
-        Stash(Private*);
-        void queueSignals(Private*);
-
-        const int iMaxValue;
-        const int iTotal;
+    struct Row {
+        QDate iStart;
+        Totals iTotals;
     };
 
     Private(BikeHistoryStats*);
+    ~Private();
 
     static QString shortMonthName(int);
-    static int value(const Stats*, Mode);
+    static int value(const Totals&, Mode);
+    static Totals maxPerRow(const QVector<Row>&);
 
     void emitDataChanged();
+    void scheduleUpdate();
+    void setHistory(BikeHistory*);
+    void invalidateHistory();
+    void invalidateRows();
+    void releaseTask();
+    void saveIndex();
     void updateStats();
+    void publish();
+    void applyRows();
+    QVector<Row> rows();
+    Totals seasonTotal(const QDate&, const QDate&);
     int maxValue();
     int total();
     int yearTotal(int, Mode);
+    int monthTotal(int, Mode);
+    QString label(const Row&);
+    const QStringList& texts();
     QVariant data(int, Role);
 
+private Q_SLOTS:
+    void onHistoryVersionChanged();
+    void onUpdate();
+    void onTaskDone();
+
 public:
-    QJsonArray iHistory;
+    QThreadPool* iThreadPool;
+    Task* iTask;
+    uint iGeneration;
+    bool iUpdateScheduled;
+    bool iHistoryDirty;
+    bool iRowsDirty;
+    bool iDataChanged;
+    int iPublishedMaxValue;
+    int iPublishedTotal;
+    QPointer<BikeHistory> iHistory;
+    int iHistoryVersion;
+    BikeRideStore iStore;
+    BikeTimeBuckets iBuckets;
     Mode iMode;
+    Resolution iResolution;
     int iYear;
-    QHash<int,Stats> iYearTotal;
-    Stats iMonthTotal[Months];
-    Stats iMaxPerMonth;
-    const uint iFirstMonth;
-    const uint iMonthCount;
+    QVector<Row> iRows;
+    QStringList iTexts;
 };
 
 /* static */
@@ -137,13 +167,27 @@ BikeHistoryStats::Private::gSignalEmitters [] = {
 BikeHistoryStats::Private::Private(
     BikeHistoryStats* aParent) :
     BikeHistoryStatsPrivateBase(aParent, gSignalEmitters),
+    iThreadPool(new QThreadPool(this)),
+    iTask(Q_NULLPTR),
+    iGeneration(0),
+    iUpdateScheduled(false),
+    iHistoryDirty(false),
+    iRowsDirty(false),
+    iDataChanged(false),
+    iPublishedMaxValue(0),
+    iPublishedTotal(0),
+    iHistoryVersion(0),
     iMode(Distance),
-    iYear(0),
-    iFirstMonth(3), // April (zero-based)
-    iMonthCount(7)
+    iResolution(Months),
+    iYear(0)
 {
-    memset(iMonthTotal, 0, sizeof(iMonthTotal));
-    memset(&iMaxPerMonth, 0, sizeof(iMaxPerMonth));
+    iThreadPool->setMaxThreadCount(1);
+    iRows = rows();
+}
+
+BikeHistoryStats::Private::~Private()
+{
+    releaseTask();
 }
 
 //static
@@ -161,32 +205,249 @@ BikeHistoryStats::Private::shortMonthName(
 // static
 int
 BikeHistoryStats::Private::value(
-    const Stats* aStats,
+    const Totals& aTotals,
     Mode aMode)
 {
     switch (aMode) {
-    case Rides: return aStats->iRides;
-    case Distance: return aStats->iDistance;
-    case Duration: return aStats->iDuration;
+    case Rides: return int(aTotals.iRides);
+    case Distance: return int(aTotals.iDistance);
+    case Duration: return int(aTotals.iDuration);
     }
     return 0;
 }
 
+// static
+BikeHistoryStats::Private::Totals
+BikeHistoryStats::Private::maxPerRow(
+    const QVector<Row>& aRows)
+{
+    const int n = aRows.count();
+    Totals max;
+
+    for (int i = 0; i < n; i++) {
+        const Totals& totals = aRows.at(i).iTotals;
+
+        max.iRides = qMax(max.iRides, totals.iRides);
+        max.iDistance = qMax(max.iDistance, totals.iDistance);
+        max.iDuration = qMax(max.iDuration, totals.iDuration);
+    }
+    return max;
+}
+
 void
 BikeHistoryStats::Private::emitDataChanged()
 {
-    BikeHistoryStats* model = parentObject();
+    if (!iRows.isEmpty()) {
+        BikeHistoryStats* model = parentObject();
+
+        Q_EMIT model->dataChanged(model->index(0),
+            model->index(iRows.count() - 1),
+            QVector<int>{Private::RoleLabel, Private::RoleValue, Private::RoleText});
+    }
+}
+
+void
+BikeHistoryStats::Private::scheduleUpdate()
+{
+    // Multiple changes made within the same event loop iteration
+    // result in a single update
+    if (!iUpdateScheduled) {
+        iUpdateScheduled = true;
+        QMetaObject::invokeMethod(this, "onUpdate", Qt::QueuedConnection);
+    }
+}
+
+void
+BikeHistoryStats::Private::setHistory(
+    BikeHistory* aHistory)
+{
+    if (iHistory) {
+        iHistory->disconnect(this);
+    }
+    iHistory = aHistory;
+    iHistoryVersion = BikeHistory::version(aHistory);
+    if (aHistory) {
+        connect(aHistory, SIGNAL(versionChanged()),
+            SLOT(onHistoryVersionChanged()));
+    }
+    invalidateHistory();
+    queueSignal(SignalHistoryChanged);
+}
+
+void
+BikeHistoryStats::Private::onHistoryVersionChanged()
+{
+    const int version = BikeHistory::version(iHistory);
+
+    if (iHistoryVersion != version) {
+        HDEBUG("History version" << version);
+        iHistoryVersion = version;
+        invalidateHistory();
+    }
+}
+
+void
+BikeHistoryStats::Private::invalidateHistory()
+{
+    const BikeHistory::Index index(BikeHistory::index(iHistory));
+
+    if (index.iValid) {
+        // Someone has already done the job
+        HDEBUG("Reusing history index");
+        releaseTask();
+        iGeneration++;
+        iStore = index.iStore;
+        iBuckets = index.iBuckets;
+        iHistoryDirty = false;
+    } else {
+        iHistoryDirty = true;
+    }
+    iRowsDirty = true;
+    scheduleUpdate();
+}
+
+void
+BikeHistoryStats::Private::invalidateRows()
+{
+    iRowsDirty = true;
+    scheduleUpdate();
+}
+
+void
+BikeHistoryStats::Private::releaseTask()
+{
+    if (iTask) {
+        iTask->release(this);
+        iTask = Q_NULLPTR;
+    }
+}
+
+void
+BikeHistoryStats::Private::saveIndex()
+{
+    // Leave the results with the history for others to reuse
+    if (iHistory) {
+        BikeHistory::Index index;
+
+        index.iValid = true;
+        index.iStore = iStore;
+        index.iBuckets = iBuckets;
+        iHistory->setIndex(iHistoryVersion, index);
+    }
+}
+
+void
+BikeHistoryStats::Private::updateStats()
+{
+    // Someone needs the numbers right now
+    if (iHistoryDirty) {
+        HDEBUG("Updating synchronously");
+        releaseTask();
+        iGeneration++;
+        iStore.update(BikeHistory::rides(iHistory));
+        iBuckets.build(iStore);
+        iHistoryDirty = false;
+        iRowsDirty = true;
+        saveIndex();
+    }
+}
+
+void
+BikeHistoryStats::Private::onUpdate()
+{
+    iUpdateScheduled = false;
+    if (iHistoryDirty) {
+        // Aggregate the snapshot of the history on the worker thread.
+        // Results of the older tasks (if any) will be dropped.
+        releaseTask();
+        iTask = new Task(iThreadPool, ++iGeneration,
+            BikeHistory::rides(iHistory), iStore);
+        iTask->submit(this, SLOT(onTaskDone()));
+    } else {
+        publish();
+    }
+}
+
+void
+BikeHistoryStats::Private::onTaskDone()
+{
+    Task* task = qobject_cast<Task*>(sender());
+
+    if (task == iTask) {
+        iTask = Q_NULLPTR;
+    }
+    if (task->iGeneration == iGeneration && iHistoryDirty) {
+        // Swap the results and notify everyone at once
+        HDEBUG("Generation" << iGeneration);
+        iStore = task->iStore;
+        iBuckets = task->iBuckets;
+        iHistoryDirty = false;
+        iRowsDirty = true;
+        saveIndex();
+        publish();
+    } else {
+        HDEBUG("Dropping stale generation" << task->iGeneration);
+    }
+    task->release(this);
+}
+
+void
+BikeHistoryStats::Private::publish()
+{
+    BikeTrace::Span span("BikeHistoryStats::publish");
 
-    Q_EMIT model->dataChanged(model->index(0),
-        model->index(iMonthCount - 1),
-        QVector<int>{Private::RoleValue});
+    updateStats();
+    if (iRowsDirty) {
+        applyRows();
+    }
+
+    const int maxValue = value(maxPerRow(iRows), iMode);
+    const int total = yearTotal(iYear, iMode);
+
+    if (iPublishedMaxValue != maxValue) {
+        iPublishedMaxValue = maxValue;
+        HDEBUG("Max value" << maxValue);
+        queueSignal(SignalMaxValueChanged);
+    }
+    if (iPublishedTotal != total) {
+        iPublishedTotal = total;
+        HDEBUG("Total" << total);
+        queueSignal(SignalTotalChanged);
+    }
+    emitQueuedSignals();
+    if (iDataChanged) {
+        iDataChanged = false;
+        emitDataChanged();
+    }
+}
+
+void
+BikeHistoryStats::Private::applyRows()
+{
+    const QVector<Row> newRows(rows());
+
+    iRowsDirty = false;
+    if (iRows.count() == newRows.count()) {
+        iRows = newRows;
+        iTexts.clear();
+        iDataChanged = true;
+    } else {
+        BikeHistoryStats* model = parentObject();
+
+        HDEBUG(newRows.count() << "row(s)");
+        model->beginResetModel();
+        iRows = newRows;
+        iTexts.clear();
+        model->endResetModel();
+    }
 }
 
 inline
 int
 BikeHistoryStats::Private::maxValue()
 {
-    return value(&iMaxPerMonth, iMode);
+    updateStats();
+    return value(maxPerRow(iRowsDirty ? rows() : iRows), iMode);
 }
 
 inline
@@ -201,59 +462,125 @@ BikeHistoryStats::Private::yearTotal(
     int aYear,
     Mode aMode)
 {
-    return iYearTotal.contains(aYear) ? value(&iYearTotal[aYear], aMode) : 0;
+    updateStats();
+    return aYear ? value(iBuckets.total(QDate(aYear, 1, 1),
+        QDate(aYear, 12, 31)), aMode) : 0;
 }
 
-void
-BikeHistoryStats::Private::updateStats()
+int
+BikeHistoryStats::Private::monthTotal(
+    int aMonth,
+    Mode aMode)
 {
-    const uint n = iHistory.size();
-
-    iYearTotal.clear();
-    memset(iMonthTotal, 0, sizeof(iMonthTotal));
-    memset(&iMaxPerMonth, 0, sizeof(iMaxPerMonth));
+    updateStats();
+    if (aMonth >= 1 && aMonth <= 12) {
+        const QDate month(iYear ? iYear : iBuckets.lastDate().year(), aMonth, 1);
 
-    for (uint i = 0; i < n; i++) {
-        const QJsonObject entry(iHistory.at(i).toObject());
-        const int distance = entry.value(QStringLiteral("distance")).toInt();
-        const int duration = entry.value(QStringLiteral("duration")).toInt();
-        const QString isoDate(entry.value(QStringLiteral("departureDate")).toString());
-        const QDate date(QDateTime::fromString(isoDate, Qt::ISODate).date());
-        const int year = date.year();
-        const int month = date.month();
-
-        if (year) {
-            Stats* stats = &iYearTotal[year];
+        return value(seasonTotal(month, BikeTimeBuckets::bucketEnd(month,
+            BikeTimeBuckets::Month)), aMode);
+    }
+    return 0;
+}
 
-            stats->iRides += 1;
-            stats->iDistance += distance;
-            stats->iDuration += duration;
+BikeHistoryStats::Private::Totals
+BikeHistoryStats::Private::seasonTotal(
+    const QDate& aFrom,
+    const QDate& aTo)
+{
+    if (iYear || iBuckets.isEmpty()) {
+        return iBuckets.total(aFrom, aTo);
+    } else {
+        // Same range in every year
+        const int firstYear = iBuckets.firstDate().year();
+        const int lastYear = iBuckets.lastDate().year();
+        Totals sum;
+
+        for (int y = firstYear; y <= lastYear; y++) {
+            const int shift = y - aFrom.year();
+
+            sum += iBuckets.total(aFrom.addYears(shift), aTo.addYears(shift));
         }
+        return sum;
+    }
+}
 
-        if (month && (!iYear || iYear == year)) {
-            Stats* stats = iMonthTotal + (month - 1);
-
-            if ((stats->iRides += 1) > iMaxPerMonth.iRides) {
-                iMaxPerMonth.iRides = stats->iRides;
-            }
-            if ((stats->iDistance += distance) > iMaxPerMonth.iDistance) {
-                iMaxPerMonth.iDistance = stats->iDistance;
-            }
-            if ((stats->iDuration += duration) > iMaxPerMonth.iDuration) {
-                iMaxPerMonth.iDuration = stats->iDuration;
+QVector<BikeHistoryStats::Private::Row>
+BikeHistoryStats::Private::rows()
+{
+    const BikeTimeBuckets::Resolution resolution =
+        (BikeTimeBuckets::Resolution) iResolution;
+    QVector<Row> rows;
+
+    if (iResolution == Seasons) {
+        if (!iBuckets.isEmpty()) {
+            const int firstYear = iBuckets.firstDate().year();
+            const int lastYear = iBuckets.lastDate().year();
+
+            for (int y = firstYear; y <= lastYear; y++) {
+                Row row;
+
+                row.iStart = BikeTimeBuckets::bucketStart(QDate(y, 1, 1),
+                    BikeTimeBuckets::Season);
+                row.iTotals = iBuckets.bucket(row.iStart, resolution);
+                rows.append(row);
             }
         }
+    } else {
+        // When the year is zero, the season of the last year is used
+        // as a template for every year
+        const int year = iYear ? iYear : iBuckets.isEmpty() ?
+            QDate::currentDate().year() : iBuckets.lastDate().year();
+        const QDate seasonStart(year, BikeTimeBuckets::SeasonFirstMonth, 1);
+        const QDate seasonEnd(BikeTimeBuckets::bucketEnd(seasonStart,
+            BikeTimeBuckets::Season));
+        QDate start(BikeTimeBuckets::bucketStart(seasonStart, resolution));
+
+        while (start <= seasonEnd) {
+            const QDate end(BikeTimeBuckets::bucketEnd(start, resolution));
+            Row row;
+
+            row.iStart = start;
+            row.iTotals = seasonTotal(qMax(start, seasonStart),
+                qMin(end, seasonEnd));
+            rows.append(row);
+            start = end.addDays(1);
+        }
     }
+    return rows;
+}
 
-    #define PRINT_RIDES(i) << iMonthTotal[i].iRides
-    #define PRINT_DISTANCE(i) << iMonthTotal[i].iDistance
-    #define PRINT_DIRATION(i) << iMonthTotal[i].iDuration
-    HDEBUG("Rides:" X12(PRINT_RIDES));
-    HDEBUG("Distances:" X12(PRINT_DISTANCE) << "m");
-    HDEBUG("Durations:" X12(PRINT_DIRATION) << "sec");
-    #undef PRINT_RIDES
-    #undef PRINT_DISTANCE
-    #undef PRINT_DIRATION
+QString
+BikeHistoryStats::Private::label(
+    const Row& aRow)
+{
+    switch (iResolution) {
+    case Days:
+        return aRow.iStart.toString(QStringLiteral("d.M."));
+    case Weeks:
+        return QString::number(aRow.iStart.weekNumber());
+    case Months:
+        return shortMonthName(aRow.iStart.month());
+    case Seasons:
+        return QString::number(aRow.iStart.year());
+    }
+    return QString();
+}
+
+const QStringList&
+BikeHistoryStats::Private::texts()
+{
+    // Format the whole column at once
+    if (iTexts.count() != iRows.count()) {
+        const int n = iRows.count();
+        QVector<int> values;
+
+        values.reserve(n);
+        for (int i = 0; i < n; i++) {
+            values.append(value(iRows.at(i).iTotals, iMode));
+        }
+        iTexts = Fillari::format(values, iMode);
+    }
+    return iTexts;
 }
 
 QVariant
@@ -261,42 +588,77 @@ BikeHistoryStats::Private::data(
     int aRow,
     Role aRole)
 {
-    if (uint(aRow) < iMonthCount) {
-        const uint monthIndex = iFirstMonth + aRow;
-        const Stats* stats = iMonthTotal + monthIndex;
+    updateStats();
+    if (iRowsDirty) {
+        // The model can't be reset from here. If the number of rows
+        // has changed, the stale data will be shown until publish()
+        const QVector<Row> newRows(rows());
+
+        if (newRows.count() == iRows.count()) {
+            iRows = newRows;
+            iTexts.clear();
+            iRowsDirty = false;
+            iDataChanged = true;
+        }
+    }
+
+    if (aRow >= 0 && aRow < iRows.count()) {
+        const Row& row = iRows.at(aRow);
 
         switch (aRole) {
-        case RoleMonth:
-            return shortMonthName(monthIndex + 1);
+        case RoleLabel:
+            return label(row);
         case RoleValue:
-            return value(stats, iMode);
+            return value(row.iTotals, iMode);
+        case RoleText:
+            return texts().at(aRow);
         }
     }
     return QVariant();
 }
 
 // ==========================================================================
-// BikeHistoryStats::Private::Stash
+// BikeHistoryStats::Private::Task
 // ==========================================================================
 
-BikeHistoryStats::Private::Stash::Stash(
-    Private* aPrivate) :
-    iMaxValue(aPrivate->maxValue()),
-    iTotal(aPrivate->total())
+class BikeHistoryStats::Private::Task :
+    public HarbourTask
+{
+    Q_OBJECT
+
+public:
+    Task(QThreadPool*, uint, const QJsonArray&, const BikeRideStore&);
+
+protected:
+    void performTask() Q_DECL_OVERRIDE;
+
+public:
+    const uint iGeneration;
+    const QJsonArray iHistory;
+    BikeRideStore iStore;
+    BikeTimeBuckets iBuckets;
+};
+
+BikeHistoryStats::Private::Task::Task(
+    QThreadPool* aPool,
+    uint aGeneration,
+    const QJsonArray& aHistory,
+    const BikeRideStore& aStore) :
+    HarbourTask(aPool),
+    iGeneration(aGeneration),
+    iHistory(aHistory),
+    iStore(aStore)
 {}
 
 void
-BikeHistoryStats::Private::Stash::queueSignals(
-    Private* aPrivate)
+BikeHistoryStats::Private::Task::performTask()
 {
-    if (aPrivate->maxValue() != iMaxValue) {
-        HDEBUG("Max value" << aPrivate->maxValue());
-        aPrivate->queueSignal(SignalMaxValueChanged);
-    }
-    if (aPrivate->total() != iTotal) {
-        HDEBUG("Total" << aPrivate->total());
-        aPrivate->queueSignal(SignalTotalChanged);
-    }
+    BikeTrace::Span span("BikeHistoryStats::Task");
+
+    // Both the history and the store are implicitly shared, the store
+    // gets detached from the one owned by the main thread on update
+    iStore.update(iHistory);
+    iBuckets.build(iStore);
 }
 
 // ==========================================================================
@@ -309,7 +671,7 @@ BikeHistoryStats::BikeHistoryStats(
     iPrivate(new Private(this))
 {}
 
-QJsonArray
+BikeHistory*
 BikeHistoryStats::history() const
 {
     return iPrivate->iHistory;
@@ -317,18 +679,11 @@ BikeHistoryStats::history() const
 
 void
 BikeHistoryStats::setHistory(
-    QJsonArray aHistory)
+    BikeHistory* aHistory)
 {
     if (iPrivate->iHistory != aHistory) {
-        Private::Stash stash(iPrivate);
-
-        iPrivate->iHistory = aHistory;
-        iPrivate->updateStats();
-
-        stash.queueSignals(iPrivate);
-        iPrivate->queueSignal(SignalHistoryChanged);
+        iPrivate->setHistory(aHistory);
         iPrivate->emitQueuedSignals();
-        iPrivate->emitDataChanged();
     }
 }
 
@@ -343,15 +698,32 @@ BikeHistoryStats::setMode(
     Mode aMode)
 {
     if (iPrivate->iMode != aMode) {
-        Private::Stash stash(iPrivate);
-
         HDEBUG(aMode);
         iPrivate->iMode = aMode;
-
-        stash.queueSignals(iPrivate);
+        iPrivate->iTexts.clear();
+        iPrivate->iDataChanged = true;
+        iPrivate->scheduleUpdate();
         iPrivate->queueSignal(SignalModeChanged);
         iPrivate->emitQueuedSignals();
-        iPrivate->emitDataChanged();
+    }
+}
+
+BikeHistoryStats::Resolution
+BikeHistoryStats::resolution() const
+{
+    return iPrivate->iResolution;
+}
+
+void
+BikeHistoryStats::setResolution(
+    Resolution aResolution)
+{
+    if (iPrivate->iResolution != aResolution) {
+        HDEBUG(aResolution);
+        iPrivate->iResolution = aResolution;
+        iPrivate->invalidateRows();
+        iPrivate->queueSignal(SignalResolutionChanged);
+        iPrivate->emitQueuedSignals();
     }
 }
 
@@ -366,16 +738,11 @@ BikeHistoryStats::setYear(
     int aYear)
 {
     if (iPrivate->iYear != aYear) {
-        Private::Stash stash(iPrivate);
-
         HDEBUG(aYear);
         iPrivate->iYear = aYear;
-        iPrivate->updateStats();
-
-        stash.queueSignals(iPrivate);
+        iPrivate->invalidateRows();
         iPrivate->queueSignal(SignalYearChanged);
         iPrivate->emitQueuedSignals();
-        iPrivate->emitDataChanged();
     }
 }
 
@@ -404,8 +771,7 @@ BikeHistoryStats::monthTotal(
     int aMonth,
     Mode aMode)
 {
-    return (aMonth > 0 && aMonth <= Private::Months) ?
-        Private::value(iPrivate->iMonthTotal + (aMonth - 1), aMode) : 0;
+    return iPrivate->monthTotal(aMonth, aMode);
 }
 
 QString
@@ -421,8 +787,9 @@ BikeHistoryStats::roleNames() const
 {
     QHash<int,QByteArray> roles;
 
-    roles.insert(Private::RoleMonth, "month");
+    roles.insert(Private::RoleLabel, "label");
     roles.insert(Private::RoleValue, "value");
+    roles.insert(Private::RoleText, "text");
     return roles;
 }
 
@@ -430,7 +797,7 @@ int
 BikeHistoryStats::rowCount(
     const QModelIndex&) const
 {
-    return iPrivate->iMonthCount;
+    return iPrivate->iRows.count();
 }
 
 QVariant
@@ -440,3 +807,5 @@ BikeHistoryStats::data(
 {
     return iPrivate->data(aIndex.row(), (Private::Role) aRole);
 }
+
+#include "BikeHistoryStats.moc"
@@ -40,32 +40,24 @@
 #define BIKE_HISTORY_STATS_H
 
 #include <QtCore/QAbstractListModel>
-#include <QtCore/QJsonArray>
-
-// The JSON array contains objects like this:
-//
-// {
-//   "bike": "XXXX",
-//   "departureDate": "2025-05-30T01:24:21Z",
-//   "departureStation": "XXX yyyyyyyyy",
-//   "distance": 1341,
-//   "duration": 509,
-//   "providerName": "helsinki-espoo",
-//   "returnDate": "2025-05-30T01:32:56Z",
-//   "returnStation": "XXX yyyyyyyyy"
-// }
-//
+
+#include "BikeHistory.h"
+#include "BikeTimeBuckets.h"
+
+// Aggregated BikeHistory, one row per time bucket
 
 class BikeHistoryStats :
     public QAbstractListModel
 {
     Q_OBJECT
-    Q_PROPERTY(QJsonArray history READ history WRITE setHistory NOTIFY historyChanged)
+    Q_PROPERTY(BikeHistory* history READ history WRITE setHistory NOTIFY historyChanged)
     Q_PROPERTY(Mode mode READ mode WRITE setMode NOTIFY modeChanged)
+    Q_PROPERTY(Resolution resolution READ resolution WRITE setResolution NOTIFY resolutionChanged)
     Q_PROPERTY(int year READ year WRITE setYear NOTIFY yearChanged)
     Q_PROPERTY(int maxValue READ maxValue NOTIFY maxValueChanged)
     Q_PROPERTY(int total READ total NOTIFY totalChanged)
     Q_ENUMS(Mode)
+    Q_ENUMS(Resolution)
 
 public:
     enum Mode {
@@ -74,14 +66,27 @@ public:
         Duration    // minutes
     };
 
+    // The model contains one row per bucket. Days, weeks and months
+    // cover the season of the selected year (or of all years if the
+    // year is zero), seasons cover the entire history.
+    enum Resolution {
+        Days = BikeTimeBuckets::Day,
+        Weeks = BikeTimeBuckets::Week,
+        Months = BikeTimeBuckets::Month,
+        Seasons = BikeTimeBuckets::Season
+    };
+
     BikeHistoryStats(QObject* aParent = Q_NULLPTR);
 
-    QJsonArray history() const;
-    void setHistory(QJsonArray);
+    BikeHistory* history() const;
+    void setHistory(BikeHistory*);
 
     Mode mode() const;
     void setMode(Mode);
 
+    Resolution resolution() const;
+    void setResolution(Resolution);
+
     int year() const;
     void setYear(int);
 
@@ -100,6 +105,7 @@ public:
 Q_SIGNALS:
     void historyChanged();
     void modeChanged();
+    void resolutionChanged();
     void yearChanged();
     void maxValueChanged();
     void totalChanged();
@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeLatencyHistogram.h"
+
+#include <QtCore/QJsonArray>
+
+#include <limits.h>
+#include <string.h>
+
+#include "HarbourDebug.h"
+#include "HarbourParentSignalQueueObject.h"
+
+// s(SignalName,signalName)
+#define QUEUED_SIGNALS(s) \
+    s(Count,count) \
+    s(MaxCount,maxCount) \
+    s(Average,average) \
+    s(Last,last)
+
+// ==========================================================================
+// BikeLatencyHistogram::Private
+// ==========================================================================
+
+enum BikeLatencyHistogramSignal {
+    #define SIGNAL_ENUM_(Name,name) Signal##Name##Changed,
+    QUEUED_SIGNALS(SIGNAL_ENUM_)
+    #undef  SIGNAL_ENUM_
+    BikeLatencyHistogramSignalCount
+};
+
+typedef HarbourParentSignalQueueObject<BikeLatencyHistogram,
+    BikeLatencyHistogramSignal, BikeLatencyHistogramSignalCount>
+    BikeLatencyHistogramPrivateBase;
+
+class BikeLatencyHistogram::Private :
+    public BikeLatencyHistogramPrivateBase
+{
+    static const SignalEmitter gSignalEmitters[];
+
+public:
+    static const int gLimits[];
+    static const QString BUCKETS;
+    static const QString TOTAL;
+    static const QString LAST;
+
+    enum {
+        BucketCount = 8 // Including the overflow bucket
+    };
+
+    enum Role {
+        RoleMinimum = Qt::UserRole,
+        RoleLimit,
+        RoleSamples
+    };
+
+    Private(BikeLatencyHistogram*);
+
+    static int bucket(qint64);
+    int average() const;
+    void setCounts(const int*, qint64, int);
+
+public:
+    int iBuckets[BucketCount];
+    int iCount;
+    int iMaxCount;
+    qint64 iTotal;
+    int iLast;
+};
+
+/* static */
+const BikeLatencyHistogram::Private::SignalEmitter
+BikeLatencyHistogram::Private::gSignalEmitters [] = {
+    #define SIGNAL_EMITTER_(Name,name) &BikeLatencyHistogram::name##Changed,
+    QUEUED_SIGNALS(SIGNAL_EMITTER_)
+    #undef SIGNAL_EMITTER_
+};
+
+// Exclusive upper bounds of all buckets but the last one, milliseconds
+const int BikeLatencyHistogram::Private::gLimits[BucketCount - 1] = {
+    250, 500, 1000, 2000, 4000, 8000, 16000
+};
+
+const QString BikeLatencyHistogram::Private::BUCKETS("buckets");
+const QString BikeLatencyHistogram::Private::TOTAL("total");
+const QString BikeLatencyHistogram::Private::LAST("last");
+
+BikeLatencyHistogram::Private::Private(
+    BikeLatencyHistogram* aParent) :
+    BikeLatencyHistogramPrivateBase(aParent, gSignalEmitters),
+    iCount(0),
+    iMaxCount(0),
+    iTotal(0),
+    iLast(0)
+{
+    memset(iBuckets, 0, sizeof(iBuckets));
+}
+
+// static
+int
+BikeLatencyHistogram::Private::bucket(
+    qint64 aMillis)
+{
+    int i = 0;
+
+    while (i < BucketCount - 1 && aMillis >= gLimits[i]) {
+        i++;
+    }
+    return i;
+}
+
+int
+BikeLatencyHistogram::Private::average() const
+{
+    return iCount ? int(iTotal / iCount) : 0;
+}
+
+void
+BikeLatencyHistogram::Private::setCounts(
+    const int* aBuckets,
+    qint64 aTotal,
+    int aLast)
+{
+    BikeLatencyHistogram* model = parentObject();
+    const int prevAverage = average();
+    int count = 0, maxCount = 0;
+
+    for (int i = 0; i < BucketCount; i++) {
+        const int n = aBuckets[i];
+
+        if (iBuckets[i] != n) {
+            iBuckets[i] = n;
+            Q_EMIT model->dataChanged(model->index(i), model->index(i));
+        }
+        count += n;
+        maxCount = qMax(maxCount, n);
+    }
+
+    iTotal = aTotal;
+    if (iCount != count) {
+        iCount = count;
+        queueSignal(SignalCountChanged);
+    }
+    if (iMaxCount != maxCount) {
+        iMaxCount = maxCount;
+        queueSignal(SignalMaxCountChanged);
+    }
+    if (average() != prevAverage) {
+        queueSignal(SignalAverageChanged);
+    }
+    if (iLast != aLast) {
+        iLast = aLast;
+        queueSignal(SignalLastChanged);
+    }
+}
+
+// ==========================================================================
+// BikeLatencyHistogram
+// ==========================================================================
+
+BikeLatencyHistogram::BikeLatencyHistogram(
+    QObject* aParent) :
+    QAbstractListModel(aParent),
+    iPrivate(new Private(this))
+{}
+
+int
+BikeLatencyHistogram::count() const
+{
+    return iPrivate->iCount;
+}
+
+int
+BikeLatencyHistogram::maxCount() const
+{
+    return iPrivate->iMaxCount;
+}
+
+int
+BikeLatencyHistogram::average() const
+{
+    return iPrivate->average();
+}
+
+int
+BikeLatencyHistogram::last() const
+{
+    return iPrivate->iLast;
+}
+
+void
+BikeLatencyHistogram::add(
+    qint64 aMillis)
+{
+    const int ms = (int) qBound(Q_INT64_C(0), aMillis, qint64(INT_MAX));
+    int buckets[Private::BucketCount];
+
+    HDEBUG(ms << "ms");
+    memcpy(buckets, iPrivate->iBuckets, sizeof(buckets));
+    buckets[Private::bucket(ms)]++;
+    iPrivate->setCounts(buckets, iPrivate->iTotal + ms, ms);
+    iPrivate->emitQueuedSignals();
+}
+
+void
+BikeLatencyHistogram::clear()
+{
+    const int buckets[Private::BucketCount] = { 0 };
+
+    iPrivate->setCounts(buckets, 0, 0);
+    iPrivate->emitQueuedSignals();
+}
+
+QJsonObject
+BikeLatencyHistogram::toJson() const
+{
+    QJsonArray buckets;
+    QJsonObject json;
+
+    for (int i = 0; i < Private::BucketCount; i++) {
+        buckets.append(iPrivate->iBuckets[i]);
+    }
+    json.insert(Private::BUCKETS, buckets);
+    json.insert(Private::TOTAL, double(iPrivate->iTotal));
+    json.insert(Private::LAST, iPrivate->iLast);
+    return json;
+}
+
+void
+BikeLatencyHistogram::fromJson(
+    const QJsonObject& aJson)
+{
+    const QJsonArray array(aJson.value(Private::BUCKETS).toArray());
+    int buckets[Private::BucketCount] = { 0 };
+
+    // Ignore the data if the bucket layout doesn't match
+    if (array.size() == Private::BucketCount) {
+        for (int i = 0; i < Private::BucketCount; i++) {
+            buckets[i] = qMax(array.at(i).toInt(), 0);
+        }
+        iPrivate->setCounts(buckets,
+            qint64(aJson.value(Private::TOTAL).toDouble()),
+            aJson.value(Private::LAST).toInt());
+    } else {
+        iPrivate->setCounts(buckets, 0, 0);
+    }
+    iPrivate->emitQueuedSignals();
+}
+
+QHash<int,QByteArray>
+BikeLatencyHistogram::roleNames() const
+{
+    QHash<int,QByteArray> roles;
+
+    roles.insert(Private::RoleMinimum, "minimum");
+    roles.insert(Private::RoleLimit, "limit");
+    roles.insert(Private::RoleSamples, "samples");
+    return roles;
+}
+
+int
+BikeLatencyHistogram::rowCount(
+    const QModelIndex&) const
+{
+    return Private::BucketCount;
+}
+
+QVariant
+BikeLatencyHistogram::data(
+    const QModelIndex& aIndex,
+    int aRole) const
+{
+    const int row = aIndex.row();
+
+    if (row >= 0 && row < Private::BucketCount) {
+        switch ((Private::Role)aRole) {
+        case Private::RoleMinimum:
+            return row ? Private::gLimits[row - 1] : 0;
+        case Private::RoleLimit:
+            return (row < Private::BucketCount - 1) ? Private::gLimits[row] : 0;
+        case Private::RoleSamples:
+            return iPrivate->iBuckets[row];
+        }
+    }
+    return QVariant();
+}
@@ -152,7 +152,7 @@ BikeLogin::Private::onGetLoginFinished()
     if (status == Found) {
         owner->updateCookies(reply);
         connect(owner->get(reply->rawHeader("Location"), QList<HeaderPair>() <<
-            HeaderPair("Referer", "https://www.hsl.fi/") <<
+            HeaderPair("Referer", wwwUrl("/").toLatin1()) <<
             HeaderPair("Sec-Fetch-Dest", "document") <<
             HeaderPair("Sec-Fetch-Mode", "navigate") <<
             HeaderPair("Sec-Fetch-Site", "same-site") <<
@@ -177,7 +177,7 @@ BikeLogin::Private::onGetAuthFinished()
         iAuthUiUrl = QString::fromLatin1(reply->rawHeader("Location"));
         owner->updateCookies(reply);
         connect(owner->get(iAuthUiUrl, QList<HeaderPair>() <<
-            HeaderPair("Referer", "https://www.hsl.fi/") <<
+            HeaderPair("Referer", wwwUrl("/").toLatin1()) <<
             HeaderPair("Sec-Fetch-Dest", "document") <<
             HeaderPair("Sec-Fetch-Mode", "navigate") <<
             HeaderPair("Sec-Fetch-Site", "same-site") <<
@@ -209,7 +209,7 @@ BikeLogin::Private::onGetAuthUiFinished()
 
         owner->updateCookies(reply);
         connect(owner->post(authUiUrl, QList<HeaderPair>() <<
-            HeaderPair("Origin", "https://id.hsl.fi") <<
+            HeaderPair("Origin", idUrl().toLatin1()) <<
             HeaderPair("Referer", iAuthUiUrl.toUtf8()) <<
             HeaderPair("Sec-Fetch-Dest", "empty") <<
             HeaderPair("Sec-Fetch-Mode", "cors") <<
@@ -246,11 +246,11 @@ BikeLogin::Private::onPostAuthUiFinished()
         iSyncId = uidl.value(syncIdKey).toInt();
         iClientId = uidl.value(clientIdKey).toInt();
         iCsrfToken = uidl.value("Vaadin-Security-Key").toString();
-        iAuthUidlUrl = QString("https://id.hsl.fi/UIDL/?v-uiId=%1").
+        iAuthUidlUrl = idUrl("/UIDL/?v-uiId=%1").
             arg(replyJson.value("v-uiId").toInt());
         iAuthUidlHeaders = QList<HeaderPair>() <<
             HeaderPair("Accept", "*/*") <<
-            HeaderPair("Origin", "https://id.hsl.fi") <<
+            HeaderPair("Origin", idUrl().toLatin1()) <<
             HeaderPair("Referer", iAuthUiUrl.toUtf8()) <<
             HeaderPair("Sec-Fetch-Dest", "empty") <<
             HeaderPair("Sec-Fetch-Mode", "cors") <<
@@ -714,7 +714,7 @@ BikeLogin::Private::onGetAuthRedirectFinished()
     HDEBUG(qPrintable(toString(reply)));
     if (status == OK) {
         const QString redirectHtml(reply->readAll());
-        const int start = redirectHtml.indexOf("https://www.hsl.fi/user/auth/hslid?");
+        const int start = redirectHtml.indexOf(wwwUrl("/user/auth/hslid?"));
 
         owner->updateCookies(reply);
         HDEBUG(qPrintable(redirectHtml));
@@ -771,14 +771,14 @@ BikeLogin::Private::onGetHslidFinished()
 // ==========================================================================
 
 BikeLogin::BikeLogin(
-    QNetworkAccessManager* aParent,
+    BikeConnection* aParent,
     QString aLogin,
     QString aPassword) :
     BikeRequest(aParent),
     iPrivate(new Private(this, aLogin, aPassword))
 {
-    QNetworkReply* reply = get("https://www.hsl.fi/user/auth/login?language=en",  QList<HeaderPair>() <<
-        HeaderPair("Referer", "https://www.hsl.fi/omat-tiedot/kaupunkipyorat/matkahistoria") <<
+    QNetworkReply* reply = get(wwwUrl("/user/auth/login?language=en"),  QList<HeaderPair>() <<
+        HeaderPair("Referer", wwwUrl("/omat-tiedot/kaupunkipyorat/matkahistoria").toLatin1()) <<
         HeaderPair("Sec-Fetch-Dest", "document") <<
         HeaderPair("Sec-Fetch-Mode", "navigate") <<
         HeaderPair("Sec-Fetch-Site", "same-origin") <<
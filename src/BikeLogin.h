@@ -51,7 +51,7 @@ class BikeLogin :
     Q_OBJECT
 
 public:
-    BikeLogin(QNetworkAccessManager*, QString, QString);
+    BikeLogin(BikeConnection*, QString, QString);
 
 Q_SIGNALS:
     void success(const QJsonObject&);
@@ -65,14 +65,14 @@ BikeLogout::Private::Private(
     QObject(aParent),
     iRedirectCount(0),
     iHeaders(QList<HeaderPair>() <<
-        HeaderPair("Referer", "https://www.hsl.fi/") <<
+        HeaderPair("Referer", wwwUrl("/").toLatin1()) <<
         HeaderPair("Sec-Fetch-Dest", "iframe") <<
         HeaderPair("Sec-Fetch-Mode", "navigate") <<
         HeaderPair("Sec-Fetch-Site", "same-site") <<
         HeaderPair("Priority", "u=4") <<
         HeaderPair("Upgrade-Insecure-Requests", "1"))
 {
-    connect(aParent->get("https://www.hsl.fi/user/auth/logout", iHeaders),
+    connect(aParent->get(wwwUrl("/user/auth/logout"), iHeaders),
         SIGNAL(finished()), SLOT(onRequestFinished()));
 }
 
@@ -111,7 +111,7 @@ BikeLogout::Private::onRequestFinished()
 // ==========================================================================
 
 BikeLogout::BikeLogout(
-    QNetworkAccessManager* aParent) :
+    BikeConnection* aParent) :
     BikeRequest(aParent),
     iPrivate(new Private(this))
 {}
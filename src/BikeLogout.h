@@ -47,7 +47,7 @@ class BikeLogout :
     Q_OBJECT
 
 public:
-    BikeLogout(QNetworkAccessManager*);
+    BikeLogout(BikeConnection*);
 
 Q_SIGNALS:
     void finished();
@@ -38,8 +38,6 @@
 
 #include "BikeObjectQuery.h"
 
-#include "BikeApp.h"
-
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonDocument>
 
@@ -79,7 +77,7 @@ BikeObjectQuery::BikeObjectQuery(
 
 BikeObjectQuery::BikeObjectQuery(
     QString aUrl,
-    QNetworkAccessManager* aParent) :
+    BikeConnection* aParent) :
     BikeRequest(aParent)
 {
     connect(Private::submit(this, aUrl), SIGNAL(finished()),
@@ -117,26 +115,26 @@ BikeObjectQuery::onQueryFinished()
 // BikeUserQuery
 // ==========================================================================
 
-const QString BikeUserQuery::URL
-    (BIKE_API_URL("menu?language=en&path=/omat-tiedot/kaupunkipyorat/matkahistoria"));
+const char BikeUserQuery::PATH[] =
+    "menu?language=en&path=/omat-tiedot/kaupunkipyorat/matkahistoria";
 
 BikeUserQuery::BikeUserQuery(
     BikeRequest* aParent) :
-    BikeObjectQuery(URL, aParent)
+    BikeObjectQuery(apiUrl(PATH), aParent)
 {}
 
 BikeUserQuery::BikeUserQuery(
-    QNetworkAccessManager* aParent) :
-    BikeObjectQuery(URL, aParent)
+    BikeConnection* aParent) :
+    BikeObjectQuery(apiUrl(PATH), aParent)
 {}
 
 // ==========================================================================
 // BikeServiceQuery
 // ==========================================================================
 
-const QString BikeServiceQuery::URL(BIKE_API_URL("citybikes/cbf/maas-user"));
+const char BikeServiceQuery::PATH[] = "citybikes/cbf/maas-user";
 
 BikeServiceQuery::BikeServiceQuery(
-    QNetworkAccessManager* aParent) :
-    BikeObjectQuery(URL, aParent)
+    BikeConnection* aParent) :
+    BikeObjectQuery(apiUrl(PATH), aParent)
 {}
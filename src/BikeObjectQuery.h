@@ -53,7 +53,7 @@ class BikeObjectQuery :
 
 public:
     BikeObjectQuery(QString, BikeRequest*);
-    BikeObjectQuery(QString, QNetworkAccessManager*);
+    BikeObjectQuery(QString, BikeConnection*);
 
 Q_SIGNALS:
     void finished(const QJsonObject&);
@@ -130,11 +130,11 @@ class BikeUserQuery :
     public BikeObjectQuery
 {
     Q_OBJECT
-    static const QString URL;
+    static const char PATH[];
 
 public:
     BikeUserQuery(BikeRequest*);
-    BikeUserQuery(QNetworkAccessManager*);
+    BikeUserQuery(BikeConnection*);
 };
 
 //
@@ -142,10 +142,10 @@ class BikeServiceQuery :
     public BikeObjectQuery
 {
     Q_OBJECT
-    static const QString URL;
+    static const char PATH[];
 
 public:
-    BikeServiceQuery(QNetworkAccessManager*);
+    BikeServiceQuery(BikeConnection*);
 };
 
 
@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeRecording.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+#include <QtCore/QUrl>
+#include <QtCore/QVector>
+
+#include "HarbourDebug.h"
+
+// ==========================================================================
+// BikeRecording::Private
+// ==========================================================================
+
+class BikeRecording::Private
+{
+public:
+    static const QString INDEX_FILE;
+    static const QString EXCHANGES;
+    static const QString METHOD;
+    static const QString PATH;
+    static const QString STATUS;
+    static const QString HEADERS;
+    static const QString BODY;
+    static const QString TIME;
+
+    static QByteArray key(const QByteArray&, const QByteArray&);
+    static QString bodyFileName(int, const Exchange&);
+    static QJsonObject toJson(const Exchange&, const QString&);
+
+    void add(const Exchange&);
+    void clear();
+
+public:
+    QVector<Exchange> iExchanges;
+    QJsonArray iIndex;
+    QHash<QByteArray,QVector<int> > iSequences;
+    QHash<QByteArray,int> iPositions;
+};
+
+const QString BikeRecording::Private::INDEX_FILE("index.json");
+const QString BikeRecording::Private::EXCHANGES("exchanges");
+const QString BikeRecording::Private::METHOD("method");
+const QString BikeRecording::Private::PATH("path");
+const QString BikeRecording::Private::STATUS("status");
+const QString BikeRecording::Private::HEADERS("headers");
+const QString BikeRecording::Private::BODY("body");
+const QString BikeRecording::Private::TIME("time");
+
+// static
+QByteArray
+BikeRecording::Private::key(
+    const QByteArray& aMethod,
+    const QByteArray& aUrl)
+{
+    // Works for both absolute URLs and paths, query is ignored
+    return aMethod.toUpper() + ' ' +
+        QUrl::fromEncoded(aUrl).path(QUrl::FullyEncoded).toLatin1();
+}
+
+// static
+QString
+BikeRecording::Private::bodyFileName(
+    int aIndex,
+    const Exchange& aExchange)
+{
+    QString suffix(QStringLiteral(".dat"));
+
+    for (int i = 0; i < aExchange.iHeaders.count(); i++) {
+        const Header& header = aExchange.iHeaders.at(i);
+
+        if (header.first.toLower() == "content-type") {
+            if (header.second.contains("json")) {
+                suffix = QStringLiteral(".json");
+            } else if (header.second.contains("html")) {
+                suffix = QStringLiteral(".html");
+            }
+            break;
+        }
+    }
+    return QString(QStringLiteral("%1")).arg(aIndex, 3, 10, QChar('0')) +
+        suffix;
+}
+
+// static
+QJsonObject
+BikeRecording::Private::toJson(
+    const Exchange& aExchange,
+    const QString& aBodyFile)
+{
+    QJsonObject headers;
+    QJsonObject entry;
+
+    for (int i = 0; i < aExchange.iHeaders.count(); i++) {
+        const Header& header = aExchange.iHeaders.at(i);
+        const QString name(QString::fromLatin1(header.first));
+        const QString value(QString::fromLatin1(header.second));
+        const QJsonValue prev(headers.value(name));
+
+        if (prev.isUndefined()) {
+            headers.insert(name, value);
+        } else {
+            QJsonArray values;
+
+            if (prev.isArray()) {
+                values = prev.toArray();
+            } else {
+                values.append(prev);
+            }
+            values.append(value);
+            headers.insert(name, values);
+        }
+    }
+
+    entry.insert(METHOD, QString::fromLatin1(aExchange.iMethod));
+    entry.insert(PATH, QString::fromLatin1(aExchange.iPath));
+    entry.insert(STATUS, aExchange.iStatus);
+    entry.insert(HEADERS, headers);
+    entry.insert(BODY, aBodyFile);
+    entry.insert(TIME, aExchange.iTime);
+    return entry;
+}
+
+void
+BikeRecording::Private::add(
+    const Exchange& aExchange)
+{
+    iSequences[key(aExchange.iMethod, aExchange.iPath)].
+        append(iExchanges.count());
+    iExchanges.append(aExchange);
+}
+
+void
+BikeRecording::Private::clear()
+{
+    iExchanges.resize(0);
+    iIndex = QJsonArray();
+    iSequences.clear();
+    iPositions.clear();
+}
+
+// ==========================================================================
+// BikeRecording::Exchange
+// ==========================================================================
+
+BikeRecording::Exchange::Exchange() :
+    iStatus(0),
+    iTime(0)
+{}
+
+// ==========================================================================
+// BikeRecording
+// ==========================================================================
+
+BikeRecording::BikeRecording() :
+    iPrivate(new Private)
+{}
+
+BikeRecording::~BikeRecording()
+{
+    delete iPrivate;
+}
+
+bool
+BikeRecording::load(
+    const QString& aDir)
+{
+    const QDir dir(aDir);
+    QFile file(dir.filePath(Private::INDEX_FILE));
+
+    iPrivate->clear();
+    if (file.open(QIODevice::ReadOnly)) {
+        const QJsonArray index(QJsonDocument::fromJson(file.readAll()).
+            object().value(Private::EXCHANGES).toArray());
+
+        for (int i = 0; i < index.count(); i++) {
+            const QJsonObject entry(index.at(i).toObject());
+            const QJsonObject headers(entry.value(Private::HEADERS).toObject());
+            const QString body(entry.value(Private::BODY).toString());
+            const QStringList names(headers.keys());
+            Exchange exchange;
+
+            exchange.iMethod = entry.value(Private::METHOD).toString().toLatin1();
+            exchange.iPath = entry.value(Private::PATH).toString().toLatin1();
+            exchange.iStatus = entry.value(Private::STATUS).toInt(200);
+            exchange.iTime = entry.value(Private::TIME).toInt();
+            for (int k = 0; k < names.count(); k++) {
+                const QString& name = names.at(k);
+                const QJsonValue value(headers.value(name));
+
+                if (value.isArray()) {
+                    const QJsonArray values(value.toArray());
+
+                    for (int v = 0; v < values.count(); v++) {
+                        exchange.iHeaders.append(Header(name.toLatin1(),
+                            values.at(v).toString().toLatin1()));
+                    }
+                } else {
+                    exchange.iHeaders.append(Header(name.toLatin1(),
+                        value.toString().toLatin1()));
+                }
+            }
+
+            if (!body.isEmpty()) {
+                QFile bodyFile(dir.filePath(body));
+
+                if (bodyFile.open(QIODevice::ReadOnly)) {
+                    exchange.iBody = bodyFile.readAll();
+                } else {
+                    HWARN("Can't open" << qPrintable(bodyFile.fileName()));
+                }
+            }
+            iPrivate->add(exchange);
+        }
+        iPrivate->iIndex = index;
+        HDEBUG("Loaded" << count() << "exchange(s) from" <<
+            qPrintable(file.fileName()));
+        return true;
+    }
+    HWARN("Can't open" << qPrintable(file.fileName()));
+    return false;
+}
+
+bool
+BikeRecording::append(
+    const QString& aDir,
+    const Exchange& aExchange)
+{
+    const QDir dir(aDir);
+    QString body;
+
+    if (!dir.mkpath(QStringLiteral("."))) {
+        HWARN("Failed to create" << qPrintable(aDir));
+        return false;
+    }
+
+    if (!aExchange.iBody.isEmpty()) {
+        body = Private::bodyFileName(count() + 1, aExchange);
+
+        QFile bodyFile(dir.filePath(body));
+
+        if (!bodyFile.open(QIODevice::WriteOnly) ||
+            bodyFile.write(aExchange.iBody) != aExchange.iBody.size()) {
+            HWARN("Failed to write" << qPrintable(bodyFile.fileName()));
+            return false;
+        }
+    }
+
+    iPrivate->iIndex.append(Private::toJson(aExchange, body));
+    iPrivate->add(aExchange);
+
+    // Rewrite the index every time, there's no telling when we get killed
+    QJsonObject root;
+    QFile file(dir.filePath(Private::INDEX_FILE));
+
+    root.insert(Private::EXCHANGES, iPrivate->iIndex);
+    if (file.open(QIODevice::WriteOnly) &&
+        file.write(QJsonDocument(root).toJson()) > 0) {
+        HDEBUG("Recorded" << aExchange.iMethod.constData() <<
+            aExchange.iPath.constData() << aExchange.iStatus);
+        return true;
+    }
+    HWARN("Failed to write" << qPrintable(file.fileName()));
+    return false;
+}
+
+int
+BikeRecording::count() const
+{
+    return iPrivate->iExchanges.count();
+}
+
+const BikeRecording::Exchange*
+BikeRecording::next(
+    const QByteArray& aMethod,
+    const QByteArray& aUrl)
+{
+    const QByteArray k(Private::key(aMethod, aUrl));
+    QHash<QByteArray,QVector<int> >::const_iterator it =
+        iPrivate->iSequences.constFind(k);
+
+    if (it != iPrivate->iSequences.constEnd()) {
+        const QVector<int>& seq = it.value();
+        int& pos = iPrivate->iPositions[k];
+        const int i = seq.at(qMin(pos, seq.count() - 1));
+
+        HDEBUG(k.constData() << "=>" << i);
+        pos++;
+        return iPrivate->iExchanges.constData() + i;
+    } else {
+        HWARN("No response for" << k.constData());
+        return Q_NULLPTR;
+    }
+}
+
+void
+BikeRecording::rewind()
+{
+    iPrivate->iPositions.clear();
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_RECORDING_H
+#define BIKE_RECORDING_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+
+// HTTP exchanges recorded by BikeTransport and served by the replay
+// transport and the mock server. The directory contains index.json
+// listing the exchanges:
+//
+// {
+//   "exchanges": [
+//     {
+//       "method": "GET",
+//       "path": "/user/api/v1/citybikes/rentals",
+//       "status": 200,
+//       "headers": { "Content-Type": "application/json" },
+//       "body": "003.json",
+//       "time": 250
+//     },
+//     ...
+//   ]
+// }
+//
+// The body is the name of the file (in the same directory) containing
+// the decoded response body, time is optional (the response time in
+// milliseconds). Repeated headers (e.g. Set-Cookie) are arrays.
+//
+// Responses with the same method and path (query is ignored) are served
+// in the order they are listed, the last one gets repeated.
+//
+// Request bodies are never recorded (login requests carry the password)
+// but the responses do contain session cookies. Don't share recordings
+// of the real sessions.
+
+class BikeRecording
+{
+    Q_DISABLE_COPY(BikeRecording)
+
+public:
+    typedef QPair<QByteArray,QByteArray> Header;
+
+    struct Exchange {
+        Exchange();
+
+        QByteArray iMethod;
+        QByteArray iPath;           // Query included
+        int iStatus;
+        QList<Header> iHeaders;
+        QByteArray iBody;
+        int iTime;                  // Milliseconds
+    };
+
+    BikeRecording();
+    ~BikeRecording();
+
+    bool load(const QString&);
+    bool append(const QString&, const Exchange&);
+
+    int count() const;
+    const Exchange* next(const QByteArray&, const QByteArray&);
+    void rewind();
+
+private:
+    class Private;
+    Private* iPrivate;
+};
+
+#endif // BIKE_RECORDING_H
@@ -0,0 +1,495 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeRecords.h"
+#include "BikeRideStore.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QMap>
+#include <QtCore/QPointer>
+#include <QtCore/QVector>
+
+#include "HarbourDebug.h"
+#include "HarbourParentSignalQueueObject.h"
+
+// s(SignalName,signalName)
+#define QUEUED_SIGNALS(s) \
+    s(History,history) \
+    s(Season,season) \
+    s(Count,count)
+
+// ==========================================================================
+// BikeRecords::Private
+// ==========================================================================
+
+enum BikeRecordsSignal {
+    #define SIGNAL_ENUM_(Name,name) Signal##Name##Changed,
+    QUEUED_SIGNALS(SIGNAL_ENUM_)
+    #undef  SIGNAL_ENUM_
+    BikeRecordsSignalCount
+};
+
+typedef HarbourParentSignalQueueObject<BikeRecords,
+    BikeRecordsSignal, BikeRecordsSignalCount>
+    BikeRecordsPrivateBase;
+
+class BikeRecords::Private :
+    public BikeRecordsPrivateBase
+{
+    Q_OBJECT
+    static const SignalEmitter gSignalEmitters[];
+
+public:
+    // Shorter rides don't qualify for the speed record (seconds)
+    enum { MinSpeedDuration = 60 };
+
+    enum Role {
+        RoleRecord = Qt::UserRole,
+        RoleValue,
+        RoleDate,
+        RoleEndDate,
+        RoleDepartureStation,
+        RoleReturnStation
+    };
+
+    // Records of a season or all-time. The last day and the current
+    // streak allow to continue with the next ride.
+    struct Records {
+        Records();
+        void add(int, const BikeRideStore::Ride&, const QDate&);
+
+        int iLongestRide;           // Store index, -1 if none
+        int iLongestDistance;       // Meters
+        int iFastestRide;           // Store index, -1 if none
+        qint64 iFastestSpeed;       // mm/s
+        QDate iLongestStreakStart;
+        int iLongestStreakDays;
+        QDate iBusiestDay;
+        int iBusiestDayRides;
+        QDate iLastDay;
+        int iLastDayRides;
+        QDate iStreakStart;
+        int iStreakDays;
+    };
+
+    Private(BikeRecords*);
+
+    static QVariant dateTime(qint64);
+    static QVariant dateTime(const QDate&);
+
+    void reset();
+    void aggregate(int);
+    const Records* selected() const;
+    void setHistory(BikeHistory*);
+    void updateHistory();
+    void updateRows();
+    QVariant data(int, Role) const;
+
+private Q_SLOTS:
+    void onHistoryVersionChanged();
+
+public:
+    QPointer<BikeHistory> iHistory;
+    int iHistoryVersion;
+    BikeRideStore iStore;
+    int iSeason;
+    int iAggregated;
+    Records iAllTime;
+    QMap<int,Records> iSeasons;
+    QVector<Record> iRows;
+};
+
+/* static */
+const BikeRecords::Private::SignalEmitter
+BikeRecords::Private::gSignalEmitters [] = {
+    #define SIGNAL_EMITTER_(Name,name) &BikeRecords::name##Changed,
+    QUEUED_SIGNALS(SIGNAL_EMITTER_)
+    #undef SIGNAL_EMITTER_
+};
+
+BikeRecords::Private::Private(
+    BikeRecords* aParent) :
+    BikeRecordsPrivateBase(aParent, gSignalEmitters),
+    iHistoryVersion(0),
+    iSeason(0),
+    iAggregated(0)
+{}
+
+// static
+QVariant
+BikeRecords::Private::dateTime(
+    qint64 aTime)
+{
+    return aTime ? QDateTime::fromMSecsSinceEpoch(aTime * 1000) : QDateTime();
+}
+
+// static
+QVariant
+BikeRecords::Private::dateTime(
+    const QDate& aDate)
+{
+    // Midnight, so that QML shows the same date
+    return QDateTime(aDate);
+}
+
+void
+BikeRecords::Private::reset()
+{
+    iAggregated = 0;
+    iAllTime = Records();
+    iSeasons.clear();
+}
+
+void
+BikeRecords::Private::aggregate(
+    int aIndex)
+{
+    const BikeRideStore::Ride& ride = iStore.at(aIndex);
+    const QDate day(ride.date());
+
+    iAllTime.add(aIndex, ride, day);
+    if (day.isValid()) {
+        iSeasons[day.year()].add(aIndex, ride, day);
+    }
+}
+
+const BikeRecords::Private::Records*
+BikeRecords::Private::selected() const
+{
+    if (iSeason) {
+        QMap<int,Records>::const_iterator it = iSeasons.constFind(iSeason);
+
+        return (it == iSeasons.constEnd()) ? Q_NULLPTR : &it.value();
+    } else {
+        return &iAllTime;
+    }
+}
+
+void
+BikeRecords::Private::setHistory(
+    BikeHistory* aHistory)
+{
+    if (iHistory) {
+        iHistory->disconnect(this);
+    }
+    iHistory = aHistory;
+    iHistoryVersion = BikeHistory::version(aHistory);
+    if (aHistory) {
+        connect(aHistory, SIGNAL(versionChanged()),
+            SLOT(onHistoryVersionChanged()));
+    }
+    updateHistory();
+    queueSignal(SignalHistoryChanged);
+}
+
+void
+BikeRecords::Private::onHistoryVersionChanged()
+{
+    const int version = BikeHistory::version(iHistory);
+
+    if (iHistoryVersion != version) {
+        iHistoryVersion = version;
+        updateHistory();
+        emitQueuedSignals();
+    }
+}
+
+void
+BikeRecords::Private::updateHistory()
+{
+    const BikeHistory::Index index(BikeHistory::index(iHistory));
+    int kept;
+
+    if (index.iValid) {
+        // Reuse the store (possibly memory mapped) if it's available
+        const BikeRideStore prev(iStore);
+        const int n = prev.count();
+
+        iStore = index.iStore;
+        kept = (iStore.count() >= n && (!n || (iStore.at(0) == prev.at(0) &&
+            iStore.at(n - 1) == prev.at(n - 1)))) ? n : 0;
+    } else {
+        kept = iStore.update(BikeHistory::rides(iHistory));
+    }
+
+    const int n = iStore.count();
+    bool changed = false;
+
+    if (kept < iAggregated) {
+        // The history has been rebuilt from scratch
+        HDEBUG("Starting over");
+        reset();
+        changed = true;
+    }
+
+    if (iAggregated < n) {
+        HDEBUG("Aggregating" << (n - iAggregated) << "ride(s)");
+        for (int i = iAggregated; i < n; i++) {
+            aggregate(i);
+        }
+        iAggregated = n;
+        changed = true;
+    }
+
+    if (changed) {
+        updateRows();
+    }
+}
+
+void
+BikeRecords::Private::updateRows()
+{
+    BikeRecords* model = parentObject();
+    const Records* records = selected();
+    const int prevCount = iRows.count();
+    QVector<Record> rows;
+
+    if (records) {
+        if (records->iLongestRide >= 0) {
+            rows.append(LongestRide);
+        }
+        if (records->iFastestRide >= 0) {
+            rows.append(FastestRide);
+        }
+        if (records->iLongestStreakDays > 0) {
+            rows.append(LongestStreak);
+        }
+        if (records->iBusiestDayRides > 0) {
+            rows.append(BusiestDay);
+        }
+    }
+
+    // Take a simple approach - reset the model, there are only a few rows
+    model->beginResetModel();
+    iRows = rows;
+    model->endResetModel();
+    if (iRows.count() != prevCount) {
+        queueSignal(SignalCountChanged);
+    }
+}
+
+QVariant
+BikeRecords::Private::data(
+    int aRow,
+    Role aRole) const
+{
+    const Records* records = selected();
+
+    if (records && aRow >= 0 && aRow < iRows.count()) {
+        const Record record = iRows.at(aRow);
+        const int pos = (record == LongestRide) ? records->iLongestRide :
+            (record == FastestRide) ? records->iFastestRide : -1;
+        const BikeRideStore::Ride* ride = (pos >= 0) ? &iStore.at(pos) :
+            Q_NULLPTR;
+
+        switch (aRole) {
+        case RoleRecord:
+            return int(record);
+        case RoleValue:
+            switch (record) {
+            case LongestRide:
+                return records->iLongestDistance;
+            case FastestRide:
+                // km/h
+                return ride->iDistance * qreal(3.6) / ride->iDuration;
+            case LongestStreak:
+                return records->iLongestStreakDays;
+            case BusiestDay:
+                return records->iBusiestDayRides;
+            }
+            break;
+        case RoleDate:
+            return ride ? dateTime(ride->iDepartureTime) :
+                dateTime((record == LongestStreak) ?
+                    records->iLongestStreakStart : records->iBusiestDay);
+        case RoleEndDate:
+            return ride ? dateTime(ride->iReturnTime) :
+                dateTime((record == LongestStreak) ?
+                    records->iLongestStreakStart.addDays(records->
+                        iLongestStreakDays - 1) : records->iBusiestDay);
+        case RoleDepartureStation:
+            return ride ? iStore.string(ride->iDepartureStation) : QString();
+        case RoleReturnStation:
+            return ride ? iStore.string(ride->iReturnStation) : QString();
+        }
+    }
+    return QVariant();
+}
+
+// ==========================================================================
+// BikeRecords::Private::Records
+// ==========================================================================
+
+BikeRecords::Private::Records::Records() :
+    iLongestRide(-1),
+    iLongestDistance(0),
+    iFastestRide(-1),
+    iFastestSpeed(0),
+    iLongestStreakDays(0),
+    iBusiestDayRides(0),
+    iLastDayRides(0),
+    iStreakDays(0)
+{}
+
+void
+BikeRecords::Private::Records::add(
+    int aIndex,
+    const BikeRideStore::Ride& aRide,
+    const QDate& aDay)
+{
+    // The rides come in chronological order. In case of a tie,
+    // the earlier ride (or day) keeps the record.
+    if (aRide.iDistance > iLongestDistance) {
+        iLongestRide = aIndex;
+        iLongestDistance = aRide.iDistance;
+    }
+
+    if (aRide.iDistance > 0 && aRide.iDuration >= MinSpeedDuration) {
+        const qint64 speed = qint64(aRide.iDistance) * 1000 / aRide.iDuration;
+
+        if (speed > iFastestSpeed) {
+            iFastestRide = aIndex;
+            iFastestSpeed = speed;
+        }
+    }
+
+    if (aDay.isValid()) {
+        if (aDay == iLastDay) {
+            iLastDayRides++;
+        } else {
+            if (iLastDay.isValid() && iLastDay.addDays(1) == aDay) {
+                iStreakDays++;
+            } else {
+                iStreakStart = aDay;
+                iStreakDays = 1;
+            }
+            iLastDay = aDay;
+            iLastDayRides = 1;
+        }
+        if (iStreakDays > iLongestStreakDays) {
+            iLongestStreakStart = iStreakStart;
+            iLongestStreakDays = iStreakDays;
+        }
+        if (iLastDayRides > iBusiestDayRides) {
+            iBusiestDay = iLastDay;
+            iBusiestDayRides = iLastDayRides;
+        }
+    }
+}
+
+// ==========================================================================
+// BikeRecords
+// ==========================================================================
+
+BikeRecords::BikeRecords(
+    QObject* aParent) :
+    QAbstractListModel(aParent),
+    iPrivate(new Private(this))
+{}
+
+BikeHistory*
+BikeRecords::history() const
+{
+    return iPrivate->iHistory;
+}
+
+void
+BikeRecords::setHistory(
+    BikeHistory* aHistory)
+{
+    if (iPrivate->iHistory != aHistory) {
+        iPrivate->setHistory(aHistory);
+        iPrivate->emitQueuedSignals();
+    }
+}
+
+int
+BikeRecords::season() const
+{
+    return iPrivate->iSeason;
+}
+
+void
+BikeRecords::setSeason(
+    int aSeason)
+{
+    if (iPrivate->iSeason != aSeason) {
+        HDEBUG(aSeason);
+        iPrivate->iSeason = aSeason;
+        iPrivate->updateRows();
+        iPrivate->queueSignal(SignalSeasonChanged);
+        iPrivate->emitQueuedSignals();
+    }
+}
+
+int
+BikeRecords::count() const
+{
+    return iPrivate->iRows.count();
+}
+
+QHash<int,QByteArray>
+BikeRecords::roleNames() const
+{
+    QHash<int,QByteArray> roles;
+
+    roles.insert(Private::RoleRecord, "record");
+    roles.insert(Private::RoleValue, "value");
+    roles.insert(Private::RoleDate, "date");
+    roles.insert(Private::RoleEndDate, "endDate");
+    roles.insert(Private::RoleDepartureStation, "departureStation");
+    roles.insert(Private::RoleReturnStation, "returnStation");
+    return roles;
+}
+
+int
+BikeRecords::rowCount(
+    const QModelIndex&) const
+{
+    return iPrivate->iRows.count();
+}
+
+QVariant
+BikeRecords::data(
+    const QModelIndex& aIndex,
+    int aRole) const
+{
+    return iPrivate->data(aIndex.row(), (Private::Role) aRole);
+}
+
+#include "BikeRecords.moc"
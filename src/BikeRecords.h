@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_RECORDS_H
+#define BIKE_RECORDS_H
+
+#include <QtCore/QAbstractListModel>
+
+#include "BikeHistory.h"
+
+// Personal records: the longest and the fastest ride, the longest streak
+// of consecutive days with rides and the most rides in a day, either for
+// a single season (calendar year) or all-time (season is zero). Days are
+// UTC, same as in BikeHistoryStats and BikeRideStore.
+//
+// The records are kept up to date incrementally, as long as the history
+// has only been growing each update only looks at the rides that have
+// been added since the previous one. The model has one row per record
+// that exists in the selected season.
+
+class BikeRecords :
+    public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(BikeHistory* history READ history WRITE setHistory NOTIFY historyChanged)
+    Q_PROPERTY(int season READ season WRITE setSeason NOTIFY seasonChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_ENUMS(Record)
+
+public:
+    enum Record {
+        LongestRide,    // Value is the distance in meters
+        FastestRide,    // Value is the average speed in km/h
+        LongestStreak,  // Value is the number of days
+        BusiestDay      // Value is the number of rides
+    };
+
+    BikeRecords(QObject* aParent = Q_NULLPTR);
+
+    BikeHistory* history() const;
+    void setHistory(BikeHistory*);
+
+    int season() const;
+    void setSeason(int);
+
+    int count() const;
+
+    // QAbstractItemModel
+    QHash<int,QByteArray> roleNames() const Q_DECL_OVERRIDE;
+    int rowCount(const QModelIndex&) const Q_DECL_OVERRIDE;
+    QVariant data(const QModelIndex&, int) const Q_DECL_OVERRIDE;
+
+Q_SIGNALS:
+    void historyChanged();
+    void seasonChanged();
+    void countChanged();
+
+private:
+    class Private;
+    Private* iPrivate;
+};
+
+#endif // BIKE_RECORDS_H
@@ -38,9 +38,11 @@
 
 #include "BikeRequest.h"
 #include "BikeApp.h"
+#include "BikeConnection.h"
+#include "BikeTransport.h"
 
+#include <QtCore/QScopedPointer>
 #include <QtCore/QUrl>
-#include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkCookie>
 #include <QtNetwork/QNetworkCookieJar>
 
@@ -53,6 +55,14 @@ class BikeRequest::Private
 public:
     static const QString USER_AGENT;
     static const QList<QNetworkReply::RawHeaderPair> DEFAULT_HEADERS;
+    static QString gWwwUrl;
+    static QString gIdUrl;
+    static BikeTransport* gTransport;
+    static QScopedPointer<BikeTransport> gDefaultTransport;
+
+    static QString serverUrl(const char*, const char*);
+    static void initServerUrls();
+    static BikeTransport* transport();
 };
 
 const QString
@@ -63,6 +73,65 @@ BikeRequest::Private::DEFAULT_HEADERS(
     QNetworkReply::RawHeaderPair("DNT", "1") <<
     QNetworkReply::RawHeaderPair("Sec-GPC", "1") <<
     QNetworkReply::RawHeaderPair("Connection", "keep-alive"));
+QString BikeRequest::Private::gWwwUrl;
+QString BikeRequest::Private::gIdUrl;
+BikeTransport* BikeRequest::Private::gTransport = Q_NULLPTR;
+QScopedPointer<BikeTransport> BikeRequest::Private::gDefaultTransport;
+
+// static
+QString
+BikeRequest::Private::serverUrl(
+    const char* aEnv,
+    const char* aDefault)
+{
+    QString url(QString::fromLocal8Bit(qgetenv(aEnv)));
+
+    if (url.isEmpty()) {
+        return QString::fromLatin1(aDefault);
+    } else {
+        // Trailing slash would result in double slashes
+        while (url.endsWith('/')) {
+            url.chop(1);
+        }
+        HDEBUG(aEnv << "=" << qPrintable(url));
+        return url;
+    }
+}
+
+// static
+void
+BikeRequest::Private::initServerUrls()
+{
+    if (gWwwUrl.isEmpty()) {
+        gWwwUrl = serverUrl(BIKE_WWW_URL_ENV, BIKE_WWW_URL);
+    }
+    if (gIdUrl.isEmpty()) {
+        gIdUrl = serverUrl(BIKE_ID_URL_ENV, BIKE_ID_URL);
+    }
+}
+
+// static
+BikeTransport*
+BikeRequest::Private::transport()
+{
+    if (gTransport) {
+        return gTransport;
+    } else if (!gDefaultTransport) {
+        const QString replay(QString::fromLocal8Bit(qgetenv(BIKE_REPLAY_DIR_ENV)));
+        const QString record(QString::fromLocal8Bit(qgetenv(BIKE_RECORD_DIR_ENV)));
+
+        if (!replay.isEmpty()) {
+            HDEBUG("Replaying" << qPrintable(replay));
+            gDefaultTransport.reset(BikeTransport::newReplay(replay));
+        } else if (!record.isEmpty()) {
+            HDEBUG("Recording to" << qPrintable(record));
+            gDefaultTransport.reset(BikeTransport::newRecorder(record));
+        } else {
+            gDefaultTransport.reset(BikeTransport::newLive());
+        }
+    }
+    return gDefaultTransport.data();
+}
 
 // ==========================================================================
 // BikeRequest::Reply
@@ -83,23 +152,23 @@ BikeRequest::BikeRequest(
 {}
 
 BikeRequest::BikeRequest(
-    QNetworkAccessManager* aParent) :
+    BikeConnection* aParent) :
     QObject(aParent)
 {}
 
-QNetworkAccessManager*
-BikeRequest::getNetworkAccessManager() const
+BikeConnection*
+BikeRequest::getConnection() const
 {
     QObject* parentObject = parent();
-    QNetworkAccessManager* am = qobject_cast<QNetworkAccessManager*>(parentObject);
+    BikeConnection* connection = qobject_cast<BikeConnection*>(parentObject);
 
-    if (am) {
-        return am;
+    if (connection) {
+        return connection;
     } else {
         BikeRequest* parentReq = qobject_cast<BikeRequest*>(parentObject);
 
         if (parentReq) {
-            return parentReq->getNetworkAccessManager();
+            return parentReq->getConnection();
         }
     }
     return Q_NULLPTR;
@@ -127,7 +196,7 @@ BikeRequest::createRequest(
         req.setRawHeader(h.first, h.second);
     }
 
-    QList<QNetworkCookie> cookies(getNetworkAccessManager()->cookieJar()->
+    QList<QNetworkCookie> cookies(getConnection()->cookieJar()->
         cookiesForUrl(url));
     if (!cookies.isEmpty()) {
         req.setHeader(QNetworkRequest::CookieHeader,
@@ -147,7 +216,8 @@ BikeRequest::get(
     HDEBUG("============ GET ================");
     HDEBUG(qPrintable(toString(req)));
 
-    return getNetworkAccessManager()->get(req);
+    return Private::transport()->get(getConnection()->
+        networkAccessManager(), req);
 }
 
 QNetworkReply*
@@ -165,7 +235,8 @@ BikeRequest::post(
     HDEBUG("Data:");
     HDEBUG(aPostData.constData());
 
-    return getNetworkAccessManager()->post(req, aPostData);
+    return Private::transport()->post(getConnection()->
+        networkAccessManager(), req, aPostData);
 }
 
 void
@@ -173,18 +244,63 @@ BikeRequest::updateCookies(
     QNetworkReply* aReply)
 {
     if (aReply) {
-        getNetworkAccessManager()->cookieJar()->setCookiesFromUrl(aReply->
+        getConnection()->cookieJar()->setCookiesFromUrl(aReply->
             header(QNetworkRequest::SetCookieHeader). value<QList<QNetworkCookie>>(),
             aReply->url());
     }
 }
 
+//static
+void
+BikeRequest::setServerUrls(
+    QString aWwwUrl,
+    QString aIdUrl)
+{
+    Private::gWwwUrl = aWwwUrl;
+    Private::gIdUrl = aIdUrl;
+    Private::initServerUrls();
+}
+
+//static
+void
+BikeRequest::setTransport(
+    BikeTransport* aTransport)
+{
+    Private::gTransport = aTransport;
+}
+
+//static
+QString
+BikeRequest::wwwUrl(
+    const char* aPath)
+{
+    Private::initServerUrls();
+    return Private::gWwwUrl + QLatin1String(aPath);
+}
+
+//static
+QString
+BikeRequest::idUrl(
+    const char* aPath)
+{
+    Private::initServerUrls();
+    return Private::gIdUrl + QLatin1String(aPath);
+}
+
+//static
+QString
+BikeRequest::apiUrl(
+    const char* aPath)
+{
+    return wwwUrl(BIKE_API_PATH) + QLatin1String(aPath);
+}
+
 //static
 QList<BikeRequest::HeaderPair>
 BikeRequest::jsonApiHeaders()
 {
     static const QList<HeaderPair> headers(QList<HeaderPair>() <<
-        HeaderPair("Referer", BIKE_DEFAULT_REFERER) <<
+        HeaderPair("Referer", wwwUrl(BIKE_DEFAULT_REFERER_PATH).toLatin1()) <<
         HeaderPair("Sec-Fetch-Dest", "empty") <<
         HeaderPair("Sec-Fetch-Mode", "cors") <<
         HeaderPair("Sec-Fetch-Site", "same-origin") <<
@@ -47,8 +47,9 @@
 
 #include "HarbourDebug.h"
 
+class BikeConnection;
+class BikeTransport;
 class QJsonObject;
-class QNetworkAccessManager;
 
 class BikeRequest :
     public QObject
@@ -67,6 +68,15 @@ public:
     typedef QScopedPointer<BikeRequest,
         QScopedPointerObjectDeleteLater<BikeRequest>> Ptr;
 
+    // By default, server URLs are taken from the environment (falling
+    // back to the real thing). Those must be set before the first request.
+    static void setServerUrls(QString, QString);
+
+    // By default, the transport is selected by the environment too
+    // (live, recording or replaying). The caller keeps the ownership,
+    // null restores the default.
+    static void setTransport(BikeTransport*);
+
     // Automates deleteLater() call
     class Reply : public QScopedPointer<QNetworkReply,
         QScopedPointerObjectDeleteLater<QNetworkReply>>
@@ -79,14 +89,17 @@ public:
 protected:
     using HeaderPair = QNetworkReply::RawHeaderPair;
     BikeRequest(BikeRequest*);
-    BikeRequest(QNetworkAccessManager*);
+    BikeRequest(BikeConnection*);
 
-    QNetworkAccessManager* getNetworkAccessManager() const;
+    BikeConnection* getConnection() const;
     QNetworkRequest createRequest(QString, QList<HeaderPair>) const;
     QNetworkReply* get(QString, QList<HeaderPair>) const;
     QNetworkReply* post(QString, QList<HeaderPair>, QString, QByteArray) const;
     void updateCookies(QNetworkReply*);
 
+    static QString wwwUrl(const char* aPath = "");
+    static QString idUrl(const char* aPath = "");
+    static QString apiUrl(const char*);
     static QList<HeaderPair> jsonApiHeaders();
     static int statusCode(const QNetworkReply*);
 
@@ -0,0 +1,492 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeRideStore.h"
+#include "BikeSnapshot.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "HarbourDebug.h"
+
+#define SECONDS_PER_DAY (24*60*60)
+#define UNIX_EPOCH_JULIAN_DAY Q_INT64_C(2440588)
+
+// ==========================================================================
+// BikeRideStore::Ride
+// ==========================================================================
+
+bool
+BikeRideStore::Ride::inProgress() const
+{
+    return iDepartureTime && !iReturnTime;
+}
+
+QDate
+BikeRideStore::Ride::date() const
+{
+    return iDepartureTime ? QDate::fromJulianDay(iDepartureTime /
+        SECONDS_PER_DAY + UNIX_EPOCH_JULIAN_DAY) : QDate();
+}
+
+bool
+BikeRideStore::Ride::operator==(
+    const Ride& aRide) const
+{
+    return iDepartureTime == aRide.iDepartureTime &&
+        iReturnTime == aRide.iReturnTime &&
+        iDistance == aRide.iDistance &&
+        iDuration == aRide.iDuration &&
+        iBike == aRide.iBike &&
+        iDepartureStation == aRide.iDepartureStation &&
+        iReturnStation == aRide.iReturnStation;
+}
+
+bool
+BikeRideStore::Ride::operator!=(
+    const Ride& aRide) const
+{
+    return !operator==(aRide);
+}
+
+// ==========================================================================
+// BikeRideStore::Private
+// ==========================================================================
+
+class BikeRideStore::Private :
+    public QSharedData
+{
+public:
+    static const QString BikeKey;
+    static const QString DepartureDateKey;
+    static const QString DepartureStationKey;
+    static const QString DistanceKey;
+    static const QString DurationKey;
+    static const QString ReturnDateKey;
+    static const QString ReturnStationKey;
+
+    Private();
+    Private(const BikeSnapshot&);
+
+    static qint64 time(const QJsonObject&, const QString&);
+    static qint64 time(const QDate&);
+    static QString time(qint64);
+    static int lowerBound(const BikeRideStore&, qint64);
+
+    int count() const;
+    const Ride& at(int) const;
+    QString string(int) const;
+    int stringCount() const;
+    int intern(const QString&);
+    Ride ride(const QJsonObject&);
+    bool matches(const QJsonArray&, int);
+    int update(const QJsonArray&);
+    void clear();
+
+public:
+    BikeSnapshot iSnapshot;         // The oldest rides and strings
+    int iSnapshotRides;
+    int iSnapshotStrings;
+    QVector<Ride> iRides;           // Rides after the snapshot
+    QStringList iStrings;           // Strings after the snapshot
+    QHash<QString,int> iStringIndex; // Strings looked up so far
+    Ride iCurrent;
+    bool iHaveCurrent;
+};
+
+const QString BikeRideStore::Private::BikeKey("bike");
+const QString BikeRideStore::Private::DepartureDateKey("departureDate");
+const QString BikeRideStore::Private::DepartureStationKey("departureStation");
+const QString BikeRideStore::Private::DistanceKey("distance");
+const QString BikeRideStore::Private::DurationKey("duration");
+const QString BikeRideStore::Private::ReturnDateKey("returnDate");
+const QString BikeRideStore::Private::ReturnStationKey("returnStation");
+
+BikeRideStore::Private::Private() :
+    iSnapshotRides(0),
+    iSnapshotStrings(0),
+    iHaveCurrent(false)
+{
+    memset(&iCurrent, 0, sizeof(iCurrent));
+}
+
+BikeRideStore::Private::Private(
+    const BikeSnapshot& aSnapshot) :
+    iSnapshot(aSnapshot),
+    iSnapshotRides(aSnapshot.count()),
+    iSnapshotStrings(aSnapshot.stringCount()),
+    iHaveCurrent(aSnapshot.inProgress() != Q_NULLPTR)
+{
+    if (iHaveCurrent) {
+        iCurrent = *aSnapshot.inProgress();
+    } else {
+        memset(&iCurrent, 0, sizeof(iCurrent));
+    }
+}
+
+// static
+qint64
+BikeRideStore::Private::time(
+    const QJsonObject& aJson,
+    const QString& aKey)
+{
+    const QDateTime t(QDateTime::fromString(aJson.value(aKey).toString(),
+        Qt::ISODate));
+
+    return t.isValid() ? t.toMSecsSinceEpoch() / 1000 : 0;
+}
+
+// static
+qint64
+BikeRideStore::Private::time(
+    const QDate& aDate)
+{
+    return (aDate.toJulianDay() - UNIX_EPOCH_JULIAN_DAY) * SECONDS_PER_DAY;
+}
+
+// static
+QString
+BikeRideStore::Private::time(
+    qint64 aTime)
+{
+    return aTime ? QDateTime::fromMSecsSinceEpoch(aTime * 1000, Qt::UTC).
+        toString(Qt::ISODate) : QString();
+}
+
+// static
+int
+BikeRideStore::Private::lowerBound(
+    const BikeRideStore& aStore,
+    qint64 aTime)
+{
+    // Index of the first ride departed at or after the given time
+    int low = 0;
+    int high = aStore.count();
+
+    while (low < high) {
+        const int mid = (low + high) / 2;
+
+        if (aStore.at(mid).iDepartureTime < aTime) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+inline
+int
+BikeRideStore::Private::count() const
+{
+    return iSnapshotRides + iRides.count();
+}
+
+inline
+const BikeRideStore::Ride&
+BikeRideStore::Private::at(
+    int aIndex) const
+{
+    // Rides from the snapshot are never copied, new ones follow them
+    return (aIndex < iSnapshotRides) ? iSnapshot.at(aIndex) :
+        iRides.at(aIndex - iSnapshotRides);
+}
+
+inline
+QString
+BikeRideStore::Private::string(
+    int aIndex) const
+{
+    return (aIndex < iSnapshotStrings) ? iSnapshot.string(aIndex) :
+        iStrings.value(aIndex - iSnapshotStrings);
+}
+
+inline
+int
+BikeRideStore::Private::stringCount() const
+{
+    return iSnapshotStrings + iStrings.count();
+}
+
+int
+BikeRideStore::Private::intern(
+    const QString& aString)
+{
+    QHash<QString,int>::const_iterator it = iStringIndex.constFind(aString);
+
+    if (it != iStringIndex.constEnd()) {
+        return it.value();
+    } else {
+        // The snapshot has its strings sorted, no need to hash them all
+        int index = iSnapshot.findString(aString);
+
+        if (index < 0) {
+            index = stringCount();
+            iStrings.append(aString);
+        }
+        iStringIndex.insert(aString, index);
+        return index;
+    }
+}
+
+BikeRideStore::Ride
+BikeRideStore::Private::ride(
+    const QJsonObject& aJson)
+{
+    Ride ride;
+
+    ride.iDepartureTime = time(aJson, DepartureDateKey);
+    ride.iReturnTime = time(aJson, ReturnDateKey);
+    ride.iDistance = aJson.value(DistanceKey).toInt();
+    ride.iDuration = aJson.value(DurationKey).toInt();
+    ride.iBike = intern(aJson.value(BikeKey).toString());
+    ride.iDepartureStation = intern(aJson.value(DepartureStationKey).toString());
+    ride.iReturnStation = intern(aJson.value(ReturnStationKey).toString());
+    ride.iReserved = 0;
+    return ride;
+}
+
+bool
+BikeRideStore::Private::matches(
+    const QJsonArray& aHistory,
+    int aCompleted)
+{
+    // The history is sorted newest first. Check the newest and the oldest
+    // known rides, that's good enough to detect that the history has only
+    // grown since the last update. The rides from a corrupted snapshot
+    // can't be trusted though.
+    const int known = count();
+
+    return !iSnapshot.isCorrupted() && known > 0 && known <= aCompleted &&
+        ride(aHistory.at(aHistory.size() - known).toObject()) ==
+            at(known - 1) &&
+        ride(aHistory.at(aHistory.size() - 1).toObject()) == at(0);
+}
+
+int
+BikeRideStore::Private::update(
+    const QJsonArray& aHistory)
+{
+    const int n = aHistory.size();
+    const bool haveCurrent = n > 0 && isInProgress(aHistory.at(0).toObject());
+    const int first = haveCurrent ? 1 : 0;
+    int kept;
+
+    if (matches(aHistory, n - first)) {
+        kept = count();
+    } else {
+        clear();
+        kept = 0;
+    }
+
+    iHaveCurrent = haveCurrent;
+    if (haveCurrent) {
+        iCurrent = ride(aHistory.at(0).toObject());
+    }
+
+    iRides.reserve(n - first - iSnapshotRides);
+    for (int i = n - kept - 1; i >= first; i--) {
+        iRides.append(ride(aHistory.at(i).toObject()));
+    }
+
+    HDEBUG(kept << "kept," << (count() - kept) << "new," <<
+        stringCount() << "strings");
+    return kept;
+}
+
+void
+BikeRideStore::Private::clear()
+{
+    iSnapshot = BikeSnapshot();
+    iSnapshotRides = iSnapshotStrings = 0;
+    iRides.clear();
+    iStrings.clear();
+    iStringIndex.clear();
+    iHaveCurrent = false;
+}
+
+// ==========================================================================
+// BikeRideStore
+// ==========================================================================
+
+BikeRideStore::BikeRideStore() :
+    iPrivate(new Private)
+{}
+
+BikeRideStore::BikeRideStore(
+    const BikeSnapshot& aSnapshot) :
+    iPrivate(new Private(aSnapshot))
+{}
+
+BikeRideStore::BikeRideStore(
+    const BikeRideStore& aStore) :
+    iPrivate(aStore.iPrivate)
+{}
+
+BikeRideStore::~BikeRideStore()
+{}
+
+BikeRideStore&
+BikeRideStore::operator=(
+    const BikeRideStore& aStore)
+{
+    iPrivate = aStore.iPrivate;
+    return *this;
+}
+
+int
+BikeRideStore::count() const
+{
+    return iPrivate.constData()->count();
+}
+
+const BikeRideStore::Ride&
+BikeRideStore::at(
+    int aIndex) const
+{
+    return iPrivate.constData()->at(aIndex);
+}
+
+const BikeRideStore::Ride*
+BikeRideStore::inProgress() const
+{
+    const Private* d = iPrivate.constData();
+
+    return d->iHaveCurrent ? &d->iCurrent : Q_NULLPTR;
+}
+
+QString
+BikeRideStore::string(
+    int aIndex) const
+{
+    return iPrivate.constData()->string(aIndex);
+}
+
+int
+BikeRideStore::stringCount() const
+{
+    return iPrivate.constData()->stringCount();
+}
+
+QJsonObject
+BikeRideStore::toJson(
+    const Ride& aRide) const
+{
+    // Same keys as in the history received from the server
+    QJsonObject json;
+
+    json.insert(Private::BikeKey, string(aRide.iBike));
+    json.insert(Private::DepartureDateKey,
+        Private::time(aRide.iDepartureTime));
+    json.insert(Private::DepartureStationKey,
+        string(aRide.iDepartureStation));
+    json.insert(Private::DistanceKey, aRide.iDistance);
+    json.insert(Private::DurationKey, aRide.iDuration);
+    json.insert(Private::ReturnDateKey, Private::time(aRide.iReturnTime));
+    json.insert(Private::ReturnStationKey, string(aRide.iReturnStation));
+    return json;
+}
+
+BikeRideStore::Range
+BikeRideStore::yearRange(
+    int aYear) const
+{
+    const Private* d = iPrivate.constData();
+
+    // The snapshot indices only work until something gets appended
+    return (d->iSnapshot.isValid() && d->iRides.isEmpty()) ?
+        d->iSnapshot.yearRange(aYear) :
+        range(QDate(aYear, 1, 1), QDate(aYear, 12, 31));
+}
+
+BikeRideStore::Range
+BikeRideStore::monthRange(
+    int aYear,
+    int aMonth) const
+{
+    const Private* d = iPrivate.constData();
+    const QDate first(aYear, aMonth, 1);
+
+    return (d->iSnapshot.isValid() && d->iRides.isEmpty()) ?
+        d->iSnapshot.monthRange(aYear, aMonth) :
+        range(first, first.addMonths(1).addDays(-1));
+}
+
+BikeRideStore::Range
+BikeRideStore::range(
+    const QDate& aFrom,
+    const QDate& aTo) const
+{
+    Range range;
+
+    range.iFirst = aFrom.isValid() ?
+        Private::lowerBound(*this, Private::time(aFrom)) : 0;
+    range.iEnd = aTo.isValid() ?
+        Private::lowerBound(*this, Private::time(aTo.addDays(1))) : count();
+    range.iEnd = qMax(range.iFirst, range.iEnd);
+    return range;
+}
+
+int
+BikeRideStore::update(
+    const QJsonArray& aHistory)
+{
+    return iPrivate->update(aHistory);
+}
+
+void
+BikeRideStore::clear()
+{
+    iPrivate->clear();
+}
+
+// static
+bool
+BikeRideStore::isInProgress(
+    const QJsonObject& aJson)
+{
+    return QDateTime::fromString(aJson.value(Private::DepartureDateKey).
+        toString(), Qt::ISODate).isValid() &&
+        !aJson.value(Private::DepartureStationKey).toString().isEmpty() &&
+        !QDateTime::fromString(aJson.value(Private::ReturnDateKey).
+        toString(), Qt::ISODate).isValid() &&
+        aJson.value(Private::ReturnStationKey).toString().isEmpty();
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_RIDE_STORE_H
+#define BIKE_RIDE_STORE_H
+
+#include <QtCore/QDate>
+#include <QtCore/QJsonArray>
+#include <QtCore/QSharedDataPointer>
+#include <QtCore/QString>
+
+class BikeSnapshot;
+class QJsonObject;
+
+// Typed, implicitly shared representation of the ride history. Completed
+// rides are kept in chronological order (oldest first) so that the rides
+// arriving with the subsequent history updates get appended to the end
+// and the indices of the already known rides remain stable. Strings (bike
+// ids and station names) are interned, each ride refers to them by index.
+//
+// The ride in progress (if there is one) is stored separately, it's not
+// included in count() and can't be accessed with at()
+//
+// The store can also be backed by a memory mapped BikeSnapshot, in which
+// case the rides are read straight from the file. The updates only append
+// new rides and strings after those in the snapshot, nothing gets copied.
+
+class BikeRideStore
+{
+public:
+    struct Ride {
+        qint64 iDepartureTime;      // Seconds since epoch (UTC)
+        qint64 iReturnTime;         // Zero if the bike hasn't been returned
+        int iDistance;              // Meters
+        int iDuration;              // Seconds
+        int iBike;                  // String index
+        int iDepartureStation;      // String index
+        int iReturnStation;         // String index
+        int iReserved;              // Always zero (explicit padding)
+
+        bool inProgress() const;
+        QDate date() const;         // Departure date (UTC)
+        bool operator==(const Ride&) const;
+        bool operator!=(const Ride&) const;
+    };
+
+    // Index range [iFirst, iEnd) of the completed rides
+    struct Range {
+        int iFirst;
+        int iEnd;
+    };
+
+    BikeRideStore();
+    BikeRideStore(const BikeSnapshot&);
+    BikeRideStore(const BikeRideStore&);
+    ~BikeRideStore();
+
+    BikeRideStore& operator=(const BikeRideStore&);
+
+    int count() const;
+    const Ride& at(int) const;
+    const Ride* inProgress() const;
+    QString string(int) const;
+    int stringCount() const;
+    QJsonObject toJson(const Ride&) const;
+
+    // Rides which departed in the given year or month (1=Jan) or within
+    // the given dates (inclusive, invalid date means no limit), UTC.
+    // Assumes that the rides are sorted by departure time.
+    Range yearRange(int) const;
+    Range monthRange(int, int) const;
+    Range range(const QDate&, const QDate&) const;
+
+    // Returns the number of rides that were kept intact, the rides at
+    // and after that index are new. Zero means that the whole thing has
+    // been rebuilt from scratch.
+    int update(const QJsonArray&);
+    void clear();
+
+    static bool isInProgress(const QJsonObject&);
+
+private:
+    class Private;
+    QSharedDataPointer<Private> iPrivate;
+};
+
+#endif // BIKE_RIDE_STORE_H
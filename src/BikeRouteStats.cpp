@@ -0,0 +1,559 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeRouteStats.h"
+#include "BikeRideStore.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QPointer>
+#include <QtCore/QVector>
+
+#include "HarbourDebug.h"
+#include "HarbourParentSignalQueueObject.h"
+
+#include <algorithm>
+
+// s(SignalName,signalName)
+#define QUEUED_SIGNALS(s) \
+    s(History,history) \
+    s(Type,type) \
+    s(MaxCount,maxCount) \
+    s(Rides,rides) \
+    s(Hours,hours) \
+    s(Weekdays,weekdays)
+
+// ==========================================================================
+// BikeRouteStats::Private
+// ==========================================================================
+
+enum BikeRouteStatsSignal {
+    #define SIGNAL_ENUM_(Name,name) Signal##Name##Changed,
+    QUEUED_SIGNALS(SIGNAL_ENUM_)
+    #undef  SIGNAL_ENUM_
+    BikeRouteStatsSignalCount
+};
+
+typedef HarbourParentSignalQueueObject<BikeRouteStats,
+    BikeRouteStatsSignal, BikeRouteStatsSignalCount>
+    BikeRouteStatsPrivateBase;
+
+class BikeRouteStats::Private :
+    public BikeRouteStatsPrivateBase
+{
+    Q_OBJECT
+    static const SignalEmitter gSignalEmitters[];
+
+public:
+    enum {
+        Hours = 24,
+        Weekdays = 7
+    };
+
+    enum Role {
+        RoleName = Qt::UserRole,
+        RoleDepartureStation,
+        RoleReturnStation,
+        RoleCount,
+        RoleDistance,
+        RoleDuration,
+        RoleSpeed
+    };
+
+    struct Totals {
+        Totals();
+        void add(const BikeRideStore::Ride&);
+        qreal speed() const;
+        bool operator==(const Totals&) const;
+
+        int iCount;
+        qint64 iDistance;
+        qint64 iDuration;
+    };
+
+    struct Row {
+        bool sameKey(const Row&) const;
+
+        int iDepartureStation;
+        int iReturnStation;
+        Totals iTotals;
+    };
+
+    Private(BikeRouteStats*);
+
+    static quint64 routeKey(int, int);
+    static bool moreFrequent(const Row&, const Row&);
+
+    void reset();
+    void aggregate(const BikeRideStore::Ride&);
+    void setHistory(BikeHistory*);
+    void updateHistory();
+    void updateRows();
+    QVariant data(int, Role) const;
+
+private Q_SLOTS:
+    void onHistoryVersionChanged();
+
+public:
+    QPointer<BikeHistory> iHistory;
+    int iHistoryVersion;
+    BikeRideStore iStore;
+    Type iType;
+    int iMaxCount;
+    int iAggregated;
+    QHash<int,Totals> iDepartures;
+    QHash<int,Totals> iReturns;
+    QHash<quint64,Totals> iRoutes;
+    QList<int> iHours;
+    QList<int> iWeekdays;
+    QVector<Row> iRows;
+};
+
+/* static */
+const BikeRouteStats::Private::SignalEmitter
+BikeRouteStats::Private::gSignalEmitters [] = {
+    #define SIGNAL_EMITTER_(Name,name) &BikeRouteStats::name##Changed,
+    QUEUED_SIGNALS(SIGNAL_EMITTER_)
+    #undef SIGNAL_EMITTER_
+};
+
+BikeRouteStats::Private::Private(
+    BikeRouteStats* aParent) :
+    BikeRouteStatsPrivateBase(aParent, gSignalEmitters),
+    iHistoryVersion(0),
+    iType(Routes),
+    iMaxCount(0),
+    iAggregated(0)
+{
+    reset();
+}
+
+// static
+inline
+quint64
+BikeRouteStats::Private::routeKey(
+    int aDepartureStation,
+    int aReturnStation)
+{
+    return (quint64(aDepartureStation) << 32) | uint(aReturnStation);
+}
+
+// static
+bool
+BikeRouteStats::Private::moreFrequent(
+    const Row& aRow1,
+    const Row& aRow2)
+{
+    // Most frequent first, then the longest. Station indices make
+    // the order stable.
+    const Totals& t1 = aRow1.iTotals;
+    const Totals& t2 = aRow2.iTotals;
+
+    if (t1.iCount != t2.iCount) {
+        return t1.iCount > t2.iCount;
+    } else if (t1.iDistance != t2.iDistance) {
+        return t1.iDistance > t2.iDistance;
+    } else if (aRow1.iDepartureStation != aRow2.iDepartureStation) {
+        return aRow1.iDepartureStation < aRow2.iDepartureStation;
+    } else {
+        return aRow1.iReturnStation < aRow2.iReturnStation;
+    }
+}
+
+void
+BikeRouteStats::Private::reset()
+{
+    iAggregated = 0;
+    iDepartures.clear();
+    iReturns.clear();
+    iRoutes.clear();
+    iHours.clear();
+    iWeekdays.clear();
+    for (int i = 0; i < Hours; i++) {
+        iHours.append(0);
+    }
+    for (int i = 0; i < Weekdays; i++) {
+        iWeekdays.append(0);
+    }
+}
+
+void
+BikeRouteStats::Private::aggregate(
+    const BikeRideStore::Ride& aRide)
+{
+    const QDateTime departure(QDateTime::fromMSecsSinceEpoch(aRide.
+        iDepartureTime * 1000));
+
+    iDepartures[aRide.iDepartureStation].add(aRide);
+    iReturns[aRide.iReturnStation].add(aRide);
+    iRoutes[routeKey(aRide.iDepartureStation, aRide.iReturnStation)].add(aRide);
+    if (departure.isValid()) {
+        iHours[departure.time().hour()]++;
+        iWeekdays[departure.date().dayOfWeek() - 1]++;
+    }
+}
+
+void
+BikeRouteStats::Private::setHistory(
+    BikeHistory* aHistory)
+{
+    if (iHistory) {
+        iHistory->disconnect(this);
+    }
+    iHistory = aHistory;
+    iHistoryVersion = BikeHistory::version(aHistory);
+    if (aHistory) {
+        connect(aHistory, SIGNAL(versionChanged()),
+            SLOT(onHistoryVersionChanged()));
+    }
+    updateHistory();
+    queueSignal(SignalHistoryChanged);
+}
+
+void
+BikeRouteStats::Private::onHistoryVersionChanged()
+{
+    const int version = BikeHistory::version(iHistory);
+
+    if (iHistoryVersion != version) {
+        iHistoryVersion = version;
+        updateHistory();
+        emitQueuedSignals();
+    }
+}
+
+void
+BikeRouteStats::Private::updateHistory()
+{
+    const int kept = iStore.update(BikeHistory::rides(iHistory));
+    const int n = iStore.count();
+
+    if (kept < iAggregated) {
+        // The history has been rebuilt from scratch
+        HDEBUG("Starting over");
+        reset();
+        queueSignal(SignalHoursChanged);
+        queueSignal(SignalWeekdaysChanged);
+    }
+
+    if (iAggregated < n) {
+        HDEBUG("Aggregating" << (n - iAggregated) << "ride(s)");
+        for (int i = iAggregated; i < n; i++) {
+            aggregate(iStore.at(i));
+        }
+        queueSignal(SignalHoursChanged);
+        queueSignal(SignalWeekdaysChanged);
+    }
+
+    if (iAggregated != n) {
+        iAggregated = n;
+        queueSignal(SignalRidesChanged);
+    }
+    updateRows();
+}
+
+void
+BikeRouteStats::Private::updateRows()
+{
+    BikeRouteStats* model = parentObject();
+    QVector<Row> rows;
+
+    if (iType == Routes) {
+        QHashIterator<quint64,Totals> it(iRoutes);
+
+        rows.reserve(iRoutes.count());
+        while (it.hasNext()) {
+            Row row;
+
+            it.next();
+            row.iDepartureStation = int(it.key() >> 32);
+            row.iReturnStation = int(it.key() & 0xffffffff);
+            row.iTotals = it.value();
+            rows.append(row);
+        }
+    } else {
+        const bool departures = (iType == DepartureStations);
+        QHashIterator<int,Totals> it(departures ? iDepartures : iReturns);
+
+        while (it.hasNext()) {
+            Row row;
+
+            it.next();
+            row.iDepartureStation = departures ? it.key() : -1;
+            row.iReturnStation = departures ? -1 : it.key();
+            row.iTotals = it.value();
+            rows.append(row);
+        }
+    }
+
+    if (iMaxCount > 0 && rows.count() > iMaxCount) {
+        std::partial_sort(rows.begin(), rows.begin() + iMaxCount, rows.end(),
+            moreFrequent);
+        rows.resize(iMaxCount);
+    } else {
+        std::sort(rows.begin(), rows.end(), moreFrequent);
+    }
+
+    // Typically only the totals of a few rows change, the set of rows
+    // and their order stay the same
+    const int n = rows.count();
+    bool sameKeys = (n == iRows.count());
+
+    for (int i = 0; i < n && sameKeys; i++) {
+        sameKeys = rows.at(i).sameKey(iRows.at(i));
+    }
+
+    if (sameKeys) {
+        int first = -1;
+
+        for (int i = 0; i <= n; i++) {
+            if (i < n && !(rows.at(i).iTotals == iRows.at(i).iTotals)) {
+                iRows[i].iTotals = rows.at(i).iTotals;
+                if (first < 0) {
+                    first = i;
+                }
+            } else if (first >= 0) {
+                // Signal each range of changed rows
+                Q_EMIT model->dataChanged(model->index(first),
+                    model->index(i - 1));
+                first = -1;
+            }
+        }
+    } else {
+        // The order has changed, reset the model
+        model->beginResetModel();
+        iRows = rows;
+        model->endResetModel();
+    }
+}
+
+QVariant
+BikeRouteStats::Private::data(
+    int aRow,
+    Role aRole) const
+{
+    if (aRow >= 0 && aRow < iRows.count()) {
+        const Row& row = iRows.at(aRow);
+
+        switch (aRole) {
+        case RoleName:
+            return (row.iDepartureStation >= 0 && row.iReturnStation >= 0) ?
+                QString(iStore.string(row.iDepartureStation) +
+                    QStringLiteral(" ") + QChar(0x2192) + QStringLiteral(" ") +
+                    iStore.string(row.iReturnStation)) :
+                iStore.string(qMax(row.iDepartureStation, row.iReturnStation));
+        case RoleDepartureStation:
+            return iStore.string(row.iDepartureStation);
+        case RoleReturnStation:
+            return iStore.string(row.iReturnStation);
+        case RoleCount:
+            return row.iTotals.iCount;
+        case RoleDistance:
+            return int(row.iTotals.iDistance);
+        case RoleDuration:
+            return int(row.iTotals.iDuration);
+        case RoleSpeed:
+            return row.iTotals.speed();
+        }
+    }
+    return QVariant();
+}
+
+// ==========================================================================
+// BikeRouteStats::Private::Row
+// ==========================================================================
+
+inline
+bool
+BikeRouteStats::Private::Row::sameKey(
+    const Row& aRow) const
+{
+    return iDepartureStation == aRow.iDepartureStation &&
+        iReturnStation == aRow.iReturnStation;
+}
+
+// ==========================================================================
+// BikeRouteStats::Private::Totals
+// ==========================================================================
+
+BikeRouteStats::Private::Totals::Totals() :
+    iCount(0),
+    iDistance(0),
+    iDuration(0)
+{}
+
+inline
+void
+BikeRouteStats::Private::Totals::add(
+    const BikeRideStore::Ride& aRide)
+{
+    iCount++;
+    iDistance += aRide.iDistance;
+    iDuration += aRide.iDuration;
+}
+
+inline
+bool
+BikeRouteStats::Private::Totals::operator==(
+    const Totals& aTotals) const
+{
+    return iCount == aTotals.iCount &&
+        iDistance == aTotals.iDistance &&
+        iDuration == aTotals.iDuration;
+}
+
+qreal
+BikeRouteStats::Private::Totals::speed() const
+{
+    // km/h
+    return iDuration ? (iDistance * qreal(3.6) / iDuration) : 0;
+}
+
+// ==========================================================================
+// BikeRouteStats
+// ==========================================================================
+
+BikeRouteStats::BikeRouteStats(
+    QObject* aParent) :
+    QAbstractListModel(aParent),
+    iPrivate(new Private(this))
+{}
+
+BikeHistory*
+BikeRouteStats::history() const
+{
+    return iPrivate->iHistory;
+}
+
+void
+BikeRouteStats::setHistory(
+    BikeHistory* aHistory)
+{
+    if (iPrivate->iHistory != aHistory) {
+        iPrivate->setHistory(aHistory);
+        iPrivate->emitQueuedSignals();
+    }
+}
+
+BikeRouteStats::Type
+BikeRouteStats::type() const
+{
+    return iPrivate->iType;
+}
+
+void
+BikeRouteStats::setType(
+    Type aType)
+{
+    if (iPrivate->iType != aType) {
+        HDEBUG(aType);
+        iPrivate->iType = aType;
+        iPrivate->updateRows();
+        iPrivate->queueSignal(SignalTypeChanged);
+        iPrivate->emitQueuedSignals();
+    }
+}
+
+int
+BikeRouteStats::maxCount() const
+{
+    return iPrivate->iMaxCount;
+}
+
+void
+BikeRouteStats::setMaxCount(
+    int aMaxCount)
+{
+    if (iPrivate->iMaxCount != aMaxCount) {
+        HDEBUG(aMaxCount);
+        iPrivate->iMaxCount = aMaxCount;
+        iPrivate->updateRows();
+        iPrivate->queueSignal(SignalMaxCountChanged);
+        iPrivate->emitQueuedSignals();
+    }
+}
+
+int
+BikeRouteStats::rides() const
+{
+    return iPrivate->iAggregated;
+}
+
+QList<int>
+BikeRouteStats::hours() const
+{
+    return iPrivate->iHours;
+}
+
+QList<int>
+BikeRouteStats::weekdays() const
+{
+    return iPrivate->iWeekdays;
+}
+
+QHash<int,QByteArray>
+BikeRouteStats::roleNames() const
+{
+    QHash<int,QByteArray> roles;
+
+    roles.insert(Private::RoleName, "name");
+    roles.insert(Private::RoleDepartureStation, "departureStation");
+    roles.insert(Private::RoleReturnStation, "returnStation");
+    roles.insert(Private::RoleCount, "count");
+    roles.insert(Private::RoleDistance, "distance");
+    roles.insert(Private::RoleDuration, "duration");
+    roles.insert(Private::RoleSpeed, "speed");
+    return roles;
+}
+
+int
+BikeRouteStats::rowCount(
+    const QModelIndex&) const
+{
+    return iPrivate->iRows.count();
+}
+
+QVariant
+BikeRouteStats::data(
+    const QModelIndex& aIndex,
+    int aRole) const
+{
+    return iPrivate->data(aIndex.row(), (Private::Role) aRole);
+}
+
+#include "BikeRouteStats.moc"
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_ROUTE_STATS_H
+#define BIKE_ROUTE_STATS_H
+
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QList>
+
+#include "BikeHistory.h"
+
+// Per-station and per-route statistics of BikeHistory. Only the rides
+// that have been added since the last update get aggregated, as long
+// as the history has only been growing.
+//
+// The model lists top departure stations, return stations or routes
+// (departure -> return station pairs), depending on the type, most
+// frequent first. The hour and weekday histograms count the departures.
+
+class BikeRouteStats :
+    public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(BikeHistory* history READ history WRITE setHistory NOTIFY historyChanged)
+    Q_PROPERTY(Type type READ type WRITE setType NOTIFY typeChanged)
+    Q_PROPERTY(int maxCount READ maxCount WRITE setMaxCount NOTIFY maxCountChanged)
+    Q_PROPERTY(int rides READ rides NOTIFY ridesChanged)
+    Q_PROPERTY(QList<int> hours READ hours NOTIFY hoursChanged)
+    Q_PROPERTY(QList<int> weekdays READ weekdays NOTIFY weekdaysChanged)
+    Q_ENUMS(Type)
+
+public:
+    enum Type {
+        DepartureStations,
+        ReturnStations,
+        Routes
+    };
+
+    BikeRouteStats(QObject* aParent = Q_NULLPTR);
+
+    BikeHistory* history() const;
+    void setHistory(BikeHistory*);
+
+    Type type() const;
+    void setType(Type);
+
+    int maxCount() const;
+    void setMaxCount(int);
+
+    int rides() const;
+    QList<int> hours() const;       // 24 values, local time
+    QList<int> weekdays() const;    // 7 values, Monday first
+
+    // QAbstractItemModel
+    QHash<int,QByteArray> roleNames() const Q_DECL_OVERRIDE;
+    int rowCount(const QModelIndex&) const Q_DECL_OVERRIDE;
+    QVariant data(const QModelIndex&, int) const Q_DECL_OVERRIDE;
+
+Q_SIGNALS:
+    void historyChanged();
+    void typeChanged();
+    void maxCountChanged();
+    void ridesChanged();
+    void hoursChanged();
+    void weekdaysChanged();
+
+private:
+    class Private;
+    Private* iPrivate;
+};
+
+#endif // BIKE_ROUTE_STATS_H
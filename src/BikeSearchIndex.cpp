@@ -0,0 +1,422 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeSearchIndex.h"
+
+#include <QtCore/QLocale>
+#include <QtCore/QMap>
+#include <QtCore/QRegExp>
+
+#include "HarbourDebug.h"
+
+#include <algorithm>
+#include <iterator>
+
+// ==========================================================================
+// BikeSearchIndex::Query
+// ==========================================================================
+
+BikeSearchIndex::Query::Query() :
+    iYear(0),
+    iMonth(0)
+{}
+
+bool
+BikeSearchIndex::Query::isEmpty() const
+{
+    return iWords.isEmpty() && !iYear && !iMonth &&
+        !iFrom.isValid() && !iTo.isValid();
+}
+
+// ==========================================================================
+// BikeSearchIndex::Private
+// ==========================================================================
+
+class BikeSearchIndex::Private
+{
+public:
+    static const int FIRST_YEAR = 2000;
+
+    Private();
+
+    static int month(const QString&);
+    static bool matches(const QDate&, const Query&);
+    static bool matches(const QString&, const QString&);
+    static QVector<int> intersect(const QVector<int>&, const QVector<int>&);
+
+    void clear();
+    void addString(int, const QString&);
+    void addRide(int, int);
+    QVector<int> lookup(const QString&) const;
+
+public:
+    QMap<QString,QVector<int> > iWords;     // Word => string ids
+    QVector<QVector<int> > iRides;          // String id => ride indices
+    int iRideCount;
+    BikeRideStore::Ride iFirst;
+    BikeRideStore::Ride iLast;
+};
+
+BikeSearchIndex::Private::Private() :
+    iRideCount(0)
+{
+    memset(&iFirst, 0, sizeof(iFirst));
+    memset(&iLast, 0, sizeof(iLast));
+}
+
+// static
+int
+BikeSearchIndex::Private::month(
+    const QString& aTerm)
+{
+    // Full or abbreviated, localized or English
+    const QString term(words(aTerm).join(QChar(' ')));
+    const QLocale c(QLocale::c());
+
+    for (int m = 1; m <= 12; m++) {
+        if (term == words(QDate::longMonthName(m, QDate::StandaloneFormat)).
+            join(QChar(' ')) ||
+            term == words(QDate::longMonthName(m)).join(QChar(' ')) ||
+            term == words(QDate::shortMonthName(m)).join(QChar(' ')) ||
+            term == words(c.monthName(m)).join(QChar(' ')) ||
+            term == words(c.monthName(m, QLocale::ShortFormat)).
+            join(QChar(' '))) {
+            return m;
+        }
+    }
+    return 0;
+}
+
+// static
+bool
+BikeSearchIndex::Private::matches(
+    const QDate& aDate,
+    const Query& aQuery)
+{
+    if (!aDate.isValid()) {
+        return !aQuery.iYear && !aQuery.iMonth &&
+            !aQuery.iFrom.isValid() && !aQuery.iTo.isValid();
+    } else {
+        return (!aQuery.iYear || aDate.year() == aQuery.iYear) &&
+            (!aQuery.iMonth || aDate.month() == aQuery.iMonth) &&
+            (!aQuery.iFrom.isValid() || aDate >= aQuery.iFrom) &&
+            (!aQuery.iTo.isValid() || aDate <= aQuery.iTo);
+    }
+}
+
+// static
+bool
+BikeSearchIndex::Private::matches(
+    const QString& aString,
+    const QString& aWord)
+{
+    const QStringList stringWords(words(aString));
+
+    for (int i = 0; i < stringWords.count(); i++) {
+        if (stringWords.at(i).startsWith(aWord)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// static
+QVector<int>
+BikeSearchIndex::Private::intersect(
+    const QVector<int>& aFirst,
+    const QVector<int>& aSecond)
+{
+    QVector<int> result;
+
+    result.reserve(qMin(aFirst.count(), aSecond.count()));
+    std::set_intersection(aFirst.constBegin(), aFirst.constEnd(),
+        aSecond.constBegin(), aSecond.constEnd(), std::back_inserter(result));
+    return result;
+}
+
+void
+BikeSearchIndex::Private::clear()
+{
+    iWords.clear();
+    iRides.clear();
+    iRideCount = 0;
+}
+
+void
+BikeSearchIndex::Private::addString(
+    int aId,
+    const QString& aString)
+{
+    QStringList stringWords(words(aString));
+
+    stringWords.removeDuplicates();
+    for (int i = 0; i < stringWords.count(); i++) {
+        iWords[stringWords.at(i)].append(aId);
+    }
+    iRides.append(QVector<int>());
+}
+
+void
+BikeSearchIndex::Private::addRide(
+    int aRide,
+    int aString)
+{
+    if (aString >= 0 && aString < iRides.count()) {
+        QVector<int>& rides = iRides[aString];
+
+        // Departure and return station may be the same
+        if (rides.isEmpty() || rides.last() != aRide) {
+            rides.append(aRide);
+        }
+    }
+}
+
+QVector<int>
+BikeSearchIndex::Private::lookup(
+    const QString& aPrefix) const
+{
+    // All the words starting with the prefix are next to each other
+    QMap<QString,QVector<int> >::const_iterator it = iWords.lowerBound(aPrefix);
+    QVector<int> rides;
+
+    for (; it != iWords.constEnd() && it.key().startsWith(aPrefix); ++it) {
+        const QVector<int>& strings = it.value();
+
+        for (int i = 0; i < strings.count(); i++) {
+            rides += iRides.at(strings.at(i));
+        }
+    }
+    std::sort(rides.begin(), rides.end());
+    rides.erase(std::unique(rides.begin(), rides.end()), rides.end());
+    return rides;
+}
+
+// ==========================================================================
+// BikeSearchIndex
+// ==========================================================================
+
+BikeSearchIndex::BikeSearchIndex() :
+    iPrivate(new Private)
+{}
+
+BikeSearchIndex::~BikeSearchIndex()
+{
+    delete iPrivate;
+}
+
+void
+BikeSearchIndex::update(
+    const BikeRideStore& aStore)
+{
+    Private* d = iPrivate;
+    const int n = aStore.count();
+    const int strings = aStore.stringCount();
+
+    // Same heuristic as BikeRideStore uses, the store only grows at the
+    // end unless it gets rebuilt from scratch
+    if (!d->iRideCount || n < d->iRideCount ||
+        strings < d->iRides.count() ||
+        aStore.at(0) != d->iFirst ||
+        aStore.at(d->iRideCount - 1) != d->iLast) {
+        d->clear();
+    }
+
+    const int knownStrings = d->iRides.count();
+    const int knownRides = d->iRideCount;
+
+    for (int i = knownStrings; i < strings; i++) {
+        d->addString(i, aStore.string(i));
+    }
+    for (int i = knownRides; i < n; i++) {
+        const BikeRideStore::Ride& ride = aStore.at(i);
+
+        d->addRide(i, ride.iBike);
+        d->addRide(i, ride.iDepartureStation);
+        d->addRide(i, ride.iReturnStation);
+    }
+    if (n > 0) {
+        d->iFirst = aStore.at(0);
+        d->iLast = aStore.at(n - 1);
+    }
+    d->iRideCount = n;
+    if (n > knownRides) {
+        HDEBUG(n - knownRides << "new ride(s)," << d->iWords.count() <<
+            "word(s)");
+    }
+}
+
+void
+BikeSearchIndex::clear()
+{
+    iPrivate->clear();
+}
+
+QVector<int>
+BikeSearchIndex::find(
+    const BikeRideStore& aStore,
+    const Query& aQuery) const
+{
+    // The rides are sorted by date, narrow down the range first
+    BikeRideStore::Range range(aStore.range(aQuery.iFrom, aQuery.iTo));
+    QVector<int> result;
+
+    if (aQuery.iYear) {
+        const BikeRideStore::Range year(aQuery.iMonth ?
+            aStore.monthRange(aQuery.iYear, aQuery.iMonth) :
+            aStore.yearRange(aQuery.iYear));
+
+        range.iFirst = qMax(range.iFirst, year.iFirst);
+        range.iEnd = qMin(range.iEnd, year.iEnd);
+    }
+
+    if (aQuery.iWords.isEmpty()) {
+        for (int i = range.iFirst; i < range.iEnd; i++) {
+            if (Private::matches(aStore.at(i).date(), aQuery)) {
+                result.append(i);
+            }
+        }
+    } else {
+        QVector<int> found(iPrivate->lookup(aQuery.iWords.first()));
+
+        for (int k = 1; k < aQuery.iWords.count() && !found.isEmpty(); k++) {
+            found = Private::intersect(found,
+                iPrivate->lookup(aQuery.iWords.at(k)));
+        }
+        for (int i = 0; i < found.count(); i++) {
+            const int pos = found.at(i);
+
+            if (pos >= range.iFirst && pos < range.iEnd &&
+                Private::matches(aStore.at(pos).date(), aQuery)) {
+                result.append(pos);
+            }
+        }
+    }
+    return result;
+}
+
+// static
+BikeSearchIndex::Query
+BikeSearchIndex::parse(
+    const QString& aText)
+{
+    const QStringList terms(aText.split(QRegExp("\\s+"),
+        QString::SkipEmptyParts));
+    const int thisYear = QDate::currentDate().year();
+    Query query;
+
+    for (int i = 0; i < terms.count(); i++) {
+        const QString& term = terms.at(i);
+        const int dots = term.indexOf(QStringLiteral(".."));
+        const QDate date(QDate::fromString(term, Qt::ISODate));
+        const QDate month(QDate::fromString(term, QStringLiteral("yyyy-MM")));
+        bool isNumber = false;
+        const int year = term.toInt(&isNumber);
+        int m;
+
+        if (dots >= 0) {
+            query.iFrom = QDate::fromString(term.left(dots), Qt::ISODate);
+            query.iTo = QDate::fromString(term.mid(dots + 2), Qt::ISODate);
+        } else if (date.isValid()) {
+            query.iFrom = query.iTo = date;
+        } else if (month.isValid()) {
+            query.iYear = month.year();
+            query.iMonth = month.month();
+        } else if (isNumber && term.length() == 4 &&
+            year >= Private::FIRST_YEAR && year <= thisYear) {
+            query.iYear = year;
+        } else if ((m = Private::month(term)) > 0) {
+            query.iMonth = m;
+        } else {
+            query.iWords.append(words(term));
+        }
+    }
+    return query;
+}
+
+// static
+QStringList
+BikeSearchIndex::words(
+    const QString& aText)
+{
+    // Decompose and drop the accents, so that "toolo" finds "Töölö"
+    const QString text(aText.normalized(QString::NormalizationForm_D).
+        toLower());
+    const int n = text.length();
+    QStringList result;
+    QString word;
+
+    for (int i = 0; i < n; i++) {
+        const QChar c(text.at(i));
+
+        if (c.isLetterOrNumber()) {
+            word.append(c);
+        } else if (c.category() != QChar::Mark_NonSpacing &&
+            !word.isEmpty()) {
+            result.append(word);
+            word.clear();
+        }
+    }
+    if (!word.isEmpty()) {
+        result.append(word);
+    }
+    return result;
+}
+
+// static
+bool
+BikeSearchIndex::matches(
+    const BikeRideStore& aStore,
+    const BikeRideStore::Ride& aRide,
+    const Query& aQuery)
+{
+    if (!Private::matches(aRide.date(), aQuery)) {
+        return false;
+    }
+
+    // Slow but this is only used for the ride in progress
+    for (int i = 0; i < aQuery.iWords.count(); i++) {
+        const QString& word = aQuery.iWords.at(i);
+
+        if (!Private::matches(aStore.string(aRide.iBike), word) &&
+            !Private::matches(aStore.string(aRide.iDepartureStation), word) &&
+            !Private::matches(aStore.string(aRide.iReturnStation), word)) {
+            return false;
+        }
+    }
+    return true;
+}
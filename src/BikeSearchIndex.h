@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_SEARCH_INDEX_H
+#define BIKE_SEARCH_INDEX_H
+
+#include "BikeRideStore.h"
+
+#include <QtCore/QDate>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+// Inverted index over the strings (bike ids and station names) interned
+// by BikeRideStore. Strings are split into lowercase words with accents
+// removed, each word refers to the strings containing it and each string
+// refers to the completed rides mentioning it. The index grows together
+// with the store, the rides and the strings which have already been
+// indexed are not looked at again.
+//
+// Search text is a list of whitespace separated terms, all of which must
+// match. A term can be a year (2025), a month name (June or kesäkuu), a
+// month of a year (2025-06), a date (2025-06-15), a date range
+// (2025-06-01..2025-06-15, either end can be omitted) or a word prefix
+// to be looked up in the index.
+
+class BikeSearchIndex
+{
+    Q_DISABLE_COPY(BikeSearchIndex)
+
+public:
+    struct Query {
+        Query();
+        bool isEmpty() const;
+
+        QStringList iWords;
+        int iYear;
+        int iMonth;
+        QDate iFrom;
+        QDate iTo;
+    };
+
+    BikeSearchIndex();
+    ~BikeSearchIndex();
+
+    void update(const BikeRideStore&);
+    void clear();
+
+    // Indices of the matching completed rides, in the store order
+    QVector<int> find(const BikeRideStore&, const Query&) const;
+
+    static Query parse(const QString&);
+    static QStringList words(const QString&);
+    static bool matches(const BikeRideStore&, const BikeRideStore::Ride&,
+        const Query&);
+
+private:
+    class Private;
+    Private* iPrivate;
+};
+
+#endif // BIKE_SEARCH_INDEX_H
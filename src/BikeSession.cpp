@@ -38,26 +38,35 @@
 
 #include "BikeSession.h"
 
+#include "BikeApp.h"
+#include "BikeConnection.h"
 #include "BikeHistoryModel.h"
 #include "BikeHistoryQuery.h"
 #include "BikeLogin.h"
 #include "BikeLogout.h"
 #include "BikeObjectQuery.h"
+#include "BikeSnapshot.h"
+#include "BikeTrace.h"
+#include "Fillari.h"
 
 #include <QtCore/QDate>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QListIterator>
+#include <QtCore/QSaveFile>
 #include <QtCore/QScopedPointer>
 #include <QtCore/QTextStream>
+#include <QtCore/QThreadPool>
 #include <QtCore/QTimer>
-#include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkCookieJar>
 #include <QtNetwork/QNetworkCookie>
 
 #include "HarbourDebug.h"
 #include "HarbourParentSignalQueueObject.h"
+#include "HarbourTask.h"
 
 // s(SignalName,signalName)
 #define QUEUED_SIGNALS(s) \
@@ -81,7 +90,8 @@
     s(RideDuration,rideDuration) \
     s(Years,years) \
     s(LastYear,lastYear) \
-    s(ThisYear,thisYear)
+    s(ThisYear,thisYear) \
+    s(Cached,cached)
 
 // ==========================================================================
 // BikeSession::CookieJar
@@ -110,6 +120,11 @@ enum BikeSessionSignal {
     BikeSessionSignalCount
 };
 
+#define CHANGE_BIT_(Name,name) \
+    Q_STATIC_ASSERT(BikeSession::Name##Change == (1 << Signal##Name##Changed));
+QUEUED_SIGNALS(CHANGE_BIT_)
+#undef CHANGE_BIT_
+
 typedef HarbourParentSignalQueueObject<BikeSession,
     BikeSessionSignal, BikeSessionSignalCount>
     BikeSessionPrivateBase;
@@ -119,16 +134,44 @@ class BikeSession::Private :
 {
     Q_OBJECT
 
+    // Warm state of a recently used account
+    struct Account {
+        QString iDataDir;
+        QString iLogin;
+        QList<QNetworkCookie> iCookies;
+        QJsonObject iUserInfo;
+        QJsonObject iServiceInfo;
+        QJsonArray iHistory;        // Unless the saved rides can be used
+        BikeHistory::Index iIndex;
+        QDateTime iLastUpdate;
+        qint64 iRidesStamp;
+        qint64 iSnapshotStamp;
+    };
+
+    static const int POOL_SIZE = 4;
+    static const int REVALIDATION_INTERVAL = 5*60; // seconds
     static const SignalEmitter gSignalEmitters[];
+    static const QString CACHE_FILE;
+    static const QString CACHE_LAST_UPDATE;
+    static const QString CACHE_USER;
+    static const QString CACHE_SERVICE;
+    static const QString CACHE_HISTORY;
+    static const QString CACHE_RIDES_STAMP;
     static const QString COOKIES_FILE;
     static const QString LOGIN_FILE;
+    static const QString LOG_FILE;
+    static const QString RIDES_FILE;
+    static const QString SNAPSHOT_FILE;
 
-    #if HARBOUR_DEBUG
     static const char* stateName(State);
-    #endif
+    static bool isRequestState(State);
+    static bool isErrorState(State);
 
 public:
+    class SnapshotCheck;
+
     Private(BikeSession*);
+    ~Private();
 
     static int last(const QList<int>&);
     static QDate parseDate(const QString&);
@@ -137,7 +180,10 @@ public:
     void setLogin(QString);
     void setErrorText(QString);
     void setHttpStatus(int);
+    void queueSignal(BikeSessionSignal);
     void setState(State);
+    void logState(State);
+    void logSwitch();
     void setFirstName(QString);
     void setLastName(QString);
     void setIdent(QString, QString);
@@ -150,7 +196,28 @@ public:
     void signIn(QString, QString);
     void logOut();
     void refreshHistory();
+    void publishHistory(const QJsonArray&,
+        const BikeHistory::Index& aIndex = BikeHistory::Index());
     void updated();
+    void setCached(bool);
+    void setYears(const QList<int>&);
+    void updateRideInProgress(bool);
+    void applyUserInfo(const QJsonObject&);
+    void applyServiceInfo(const QJsonObject&);
+    void applyHistory(const QJsonArray&,
+        const BikeHistory::Index& aIndex = BikeHistory::Index());
+    void applyHistory(const QString&, const BikeHistory::Index&);
+    void loadCache();
+    void saveCache() const;
+    QJsonArray loadRides(const QJsonObject&) const;
+    void saveRides();
+    BikeSnapshot loadSnapshot(qint64) const;
+    void saveSnapshot();
+    void checkSnapshot(const BikeSnapshot&);
+    void releaseSnapshotCheck();
+    void stashAccount();
+    bool restoreAccount();
+    void forgetRemovedAccounts();
 
     void saveCookies(CookieJar*) const;
     void saveCookies() const;
@@ -174,9 +241,13 @@ private Q_SLOTS:
     void onLogoutDone();
     void onNetworkError();
     void onHttpError(int);
+    void onRideDurationTimer();
+    void onHistoryIndexChanged();
+    void onSnapshotChecked();
+    void onEmitChanges();
 
 public:
-    QNetworkAccessManager iNetworkAccessManager;
+    BikeConnection iConnection;
     BikeRequest::Ptr iRequest;
     QString iDataDir;
     int iHttpError;
@@ -191,14 +262,81 @@ public:
     QString iNfcid1;
     QDate iPassBeginDate;
     QDate iPassEndDate;
-    QJsonArray iHistory;
+    QJsonObject iUserInfo;
+    QJsonObject iServiceInfo;
+    BikeHistory* iSharedHistory;
+    qint64 iRideStart;          // Seconds since epoch, zero if none
+    qint64 iRidesStamp;         // Zero if the rides haven't been saved
+    qint64 iSnapshotStamp;      // Zero if there's no valid snapshot
+    QThreadPool* iThreadPool;
+    SnapshotCheck* iSnapshotCheck;
     QTimer* iRideDurationTimer;
     QList<int> iYears;
     int iThisYear;
+    BikeSessionSummary* iSummary;
+    BikeSessionLog* iLog;
+    QElapsedTimer iStateTimer;
+    QElapsedTimer iLoginTimer;
+    int iChanges;
+    bool iCached;
+    QList<Account> iPool; // Most recently used first
 };
 
+// ==========================================================================
+// BikeSession::Private::SnapshotCheck
+// Verifies the parts of the snapshot which aren't checked when it's mapped
+// ==========================================================================
+
+class BikeSession::Private::SnapshotCheck :
+    public HarbourTask
+{
+    Q_OBJECT
+
+public:
+    SnapshotCheck(QThreadPool*, const BikeSnapshot&, int);
+
+protected:
+    void performTask() Q_DECL_OVERRIDE;
+
+public:
+    const BikeSnapshot iSnapshot;
+    const int iHistoryVersion;
+    bool iOk;
+};
+
+BikeSession::Private::SnapshotCheck::SnapshotCheck(
+    QThreadPool* aPool,
+    const BikeSnapshot& aSnapshot,
+    int aHistoryVersion) :
+    HarbourTask(aPool),
+    iSnapshot(aSnapshot),
+    iHistoryVersion(aHistoryVersion),
+    iOk(false)
+{}
+
+void
+BikeSession::Private::SnapshotCheck::performTask()
+{
+    BikeTrace::Span span("SnapshotCheck");
+
+    iOk = iSnapshot.verify();
+}
+
+// ==========================================================================
+// BikeSession::Private
+// ==========================================================================
+
+const QString BikeSession::Private::CACHE_FILE("Cache");
+const QString BikeSession::Private::CACHE_LAST_UPDATE("lastUpdate");
+const QString BikeSession::Private::CACHE_USER("user");
+const QString BikeSession::Private::CACHE_SERVICE("service");
+const QString BikeSession::Private::CACHE_HISTORY("history");
+const QString BikeSession::Private::CACHE_RIDES_STAMP("ridesStamp");
 const QString BikeSession::Private::COOKIES_FILE("Cookies");
-const QString BikeSession::Private::LOGIN_FILE("Login");
+const QString BikeSession::Private::LOGIN_FILE(BIKE_LOGIN_FILE);
+const QString BikeSession::Private::LOG_FILE("SessionLog");
+const QString BikeSession::Private::RIDES_FILE("Rides");
+const QString BikeSession::Private::SNAPSHOT_FILE("History");
 const BikeSession::Private::SignalEmitter
 BikeSession::Private::gSignalEmitters [] = {
     #define SIGNAL_EMITTER_(Name,name) &BikeSession::name##Changed,
@@ -211,9 +349,28 @@ BikeSession::Private::Private(
     BikeSessionPrivateBase(aParent, gSignalEmitters),
     iHttpError(0),
     iState(None),
+    iSharedHistory(new BikeHistory(aParent)),
+    iRideStart(0),
+    iRidesStamp(0),
+    iSnapshotStamp(0),
+    iThreadPool(new QThreadPool(this)),
+    iSnapshotCheck(Q_NULLPTR),
     iRideDurationTimer(Q_NULLPTR),
-    iThisYear(QDate::currentDate().year())
-{}
+    iThisYear(QDate::currentDate().year()),
+    iSummary(new BikeSessionSummary(iThisYear, aParent)),
+    iLog(new BikeSessionLog(aParent)),
+    iChanges(0),
+    iCached(false)
+{
+    iThreadPool->setMaxThreadCount(1);
+    connect(iSharedHistory, SIGNAL(indexChanged()),
+        SLOT(onHistoryIndexChanged()));
+}
+
+BikeSession::Private::~Private()
+{
+    releaseSnapshotCheck();
+}
 
 // static
 inline
@@ -233,7 +390,6 @@ BikeSession::Private::parseDate(
     return QDate::fromString(aString, QStringLiteral("yyyy-MM-dd"));
 }
 
-#if HARBOUR_DEBUG
 //static
 const char*
 BikeSession::Private::stateName(
@@ -254,7 +410,62 @@ BikeSession::Private::stateName(
     }
     return "?";
 }
-#endif
+
+// static
+bool
+BikeSession::Private::isRequestState(
+    State aState)
+{
+    switch (aState) {
+    case LoginCheck:
+    case UserInfoQuery:
+    case HistoryQuery:
+    case LoggingIn:
+    case LoggingOut:
+        return true;
+    case None:
+    case Unauthorized:
+    case LoginFailed:
+    case LoginNetworkError:
+    case NetworkError:
+    case Ready:
+        break;
+    }
+    return false;
+}
+
+// static
+bool
+BikeSession::Private::isErrorState(
+    State aState)
+{
+    return aState == LoginNetworkError || aState == NetworkError;
+}
+
+void
+BikeSession::Private::queueSignal(
+    BikeSessionSignal aSignal)
+{
+    // Individual property change signals are emitted as usual, the
+    // changed() signal combines everything that has changed during
+    // the current event loop iteration.
+    if (!iChanges) {
+        QMetaObject::invokeMethod(this, "onEmitChanges", Qt::QueuedConnection);
+    }
+    iChanges |= (1 << aSignal);
+    BikeSessionPrivateBase::queueSignal(aSignal);
+}
+
+void
+BikeSession::Private::onEmitChanges()
+{
+    const int changes = iChanges;
+
+    iChanges = 0;
+    if (changes) {
+        Q_EMIT parentObject()->changed(changes);
+    }
+}
 
 void
 BikeSession::Private::updated()
@@ -263,17 +474,299 @@ BikeSession::Private::updated()
     queueSignal(SignalLastUpdateChanged);
 }
 
+void
+BikeSession::Private::setCached(
+    bool aCached)
+{
+    if (iCached != aCached) {
+        iCached = aCached;
+        HDEBUG(iCached);
+        queueSignal(SignalCachedChanged);
+    }
+}
+
+void
+BikeSession::Private::loadCache()
+{
+    BikeTrace::Span span("loadCache");
+    QJsonObject cache;
+
+    // The last known state of the account is shown while it's being
+    // revalidated. Missing cache resets everything.
+    if (!iDataDir.isEmpty()) {
+        QFile file(QDir(iDataDir).filePath(CACHE_FILE));
+
+        if (file.open(QIODevice::ReadOnly)) {
+            cache = QJsonDocument::fromJson(file.readAll()).object();
+            HDEBUG("Loaded" << qPrintable(file.fileName()));
+        }
+    }
+
+    const QDateTime lastUpdate(QDateTime::fromString(cache.
+        value(CACHE_LAST_UPDATE).toString(), Qt::ISODate));
+    const qint64 ridesStamp = qint64(cache.value(CACHE_RIDES_STAMP).
+        toDouble());
+    const BikeSnapshot snapshot(loadSnapshot(ridesStamp));
+
+    iUserInfo = cache.value(CACHE_USER).toObject();
+    iServiceInfo = cache.value(CACHE_SERVICE).toObject();
+    applyUserInfo(iUserInfo);
+    applyServiceInfo(iServiceInfo);
+    if (snapshot.isValid()) {
+        // The rides get parsed if and when someone needs them
+        BikeHistory::Index index;
+
+        index.iValid = true;
+        index.iStore = BikeRideStore(snapshot);
+        index.iBuckets = snapshot.buckets();
+        iRidesStamp = iSnapshotStamp = ridesStamp;
+        applyHistory(QDir(iDataDir).filePath(RIDES_FILE), index);
+        checkSnapshot(snapshot);
+    } else {
+        // The snapshot gets written when the index is built. The rides
+        // cached by an older version get saved with the next update.
+        iRidesStamp = (ridesStamp && QDir(iDataDir).exists(RIDES_FILE)) ?
+            ridesStamp : 0;
+        iSnapshotStamp = 0;
+        applyHistory(loadRides(cache));
+    }
+    if (iLastUpdate != lastUpdate) {
+        iLastUpdate = lastUpdate;
+        queueSignal(SignalLastUpdateChanged);
+    }
+    setCached(lastUpdate.isValid());
+}
+
+void
+BikeSession::Private::saveCache() const
+{
+    // The rides are saved separately, and only when they change
+    if (!iDataDir.isEmpty()) {
+        QDir dir(iDataDir);
+
+        if (dir.mkpath(".")) {
+            QSaveFile file(dir.filePath(CACHE_FILE));
+            QJsonObject cache;
+
+            cache.insert(CACHE_LAST_UPDATE, iLastUpdate.toString(Qt::ISODate));
+            cache.insert(CACHE_USER, iUserInfo);
+            cache.insert(CACHE_SERVICE, iServiceInfo);
+            if (iRidesStamp) {
+                cache.insert(CACHE_RIDES_STAMP, double(iRidesStamp));
+            }
+            if (file.open(QIODevice::WriteOnly) &&
+                file.write(QJsonDocument(cache).
+                    toJson(QJsonDocument::Compact)) > 0 &&
+                file.commit()) {
+                HDEBUG("Saved" << qPrintable(file.fileName()));
+            } else {
+                HWARN("Failed to save" << qPrintable(file.fileName()));
+            }
+        }
+    }
+}
+
+QJsonArray
+BikeSession::Private::loadRides(
+    const QJsonObject& aCache) const
+{
+    BikeTrace::Span span("loadRides");
+
+    if (!iDataDir.isEmpty()) {
+        QFile file(QDir(iDataDir).filePath(RIDES_FILE));
+
+        if (file.open(QIODevice::ReadOnly)) {
+            HDEBUG("Loading" << qPrintable(file.fileName()));
+            return QJsonDocument::fromJson(file.readAll()).array();
+        }
+    }
+
+    // Older versions kept the rides in the cache
+    return aCache.value(CACHE_HISTORY).toArray();
+}
+
+void
+BikeSession::Private::saveRides()
+{
+    // Called when the history has changed. The old snapshot is removed
+    // first so that it can't be matched with the new rides, the new one
+    // is written once the index is available.
+    iRidesStamp = iSnapshotStamp = 0;
+    if (!iDataDir.isEmpty()) {
+        QDir dir(iDataDir);
+
+        if (dir.mkpath(".")) {
+            QSaveFile file(dir.filePath(RIDES_FILE));
+
+            dir.remove(SNAPSHOT_FILE);
+            if (file.open(QIODevice::WriteOnly) &&
+                file.write(QJsonDocument(iSharedHistory->rides()).
+                    toJson(QJsonDocument::Compact)) > 0 &&
+                file.commit()) {
+                iRidesStamp = QDateTime::currentMSecsSinceEpoch();
+                HDEBUG("Saved" << qPrintable(file.fileName()));
+                saveSnapshot();
+            } else {
+                HWARN("Failed to save" << qPrintable(file.fileName()));
+            }
+        }
+    }
+}
+
+BikeSnapshot
+BikeSession::Private::loadSnapshot(
+    qint64 aRidesStamp) const
+{
+    BikeTrace::Span span("loadSnapshot");
+
+    // The snapshot must match the saved rides
+    if (!iDataDir.isEmpty() && aRidesStamp) {
+        const QDir dir(iDataDir);
+        const BikeSnapshot snapshot(dir.filePath(SNAPSHOT_FILE));
+
+        if (snapshot.isValid() && snapshot.stamp() == aRidesStamp &&
+            dir.exists(RIDES_FILE)) {
+            return snapshot;
+        }
+    }
+    return BikeSnapshot();
+}
+
+void
+BikeSession::Private::saveSnapshot()
+{
+    // The rides in the form which doesn't need to be parsed. Written
+    // from the index built by BikeHistoryStats on its worker thread,
+    // tied to the saved rides by the stamp.
+    const BikeHistory::Index index(iSharedHistory->index());
+
+    if (index.iValid && iRidesStamp && iSnapshotStamp != iRidesStamp &&
+        !iDataDir.isEmpty() && BikeSnapshot::write(QDir(iDataDir).
+        filePath(SNAPSHOT_FILE), index.iStore, index.iBuckets,
+        iRidesStamp)) {
+        iSnapshotStamp = iRidesStamp;
+    }
+}
+
+void
+BikeSession::Private::checkSnapshot(
+    const BikeSnapshot& aSnapshot)
+{
+    // The rides are shown right away, the check runs in the background
+    releaseSnapshotCheck();
+    iSnapshotCheck = new SnapshotCheck(iThreadPool, aSnapshot,
+        iSharedHistory->version());
+    iSnapshotCheck->submit(this, SLOT(onSnapshotChecked()));
+}
+
+void
+BikeSession::Private::releaseSnapshotCheck()
+{
+    if (iSnapshotCheck) {
+        iSnapshotCheck->release(this);
+        iSnapshotCheck = Q_NULLPTR;
+    }
+}
+
+void
+BikeSession::Private::onHistoryIndexChanged()
+{
+    saveSnapshot();
+}
+
+void
+BikeSession::Private::onSnapshotChecked()
+{
+    SnapshotCheck* task = qobject_cast<SnapshotCheck*>(sender());
+
+    if (task == iSnapshotCheck) {
+        iSnapshotCheck = Q_NULLPTR;
+        if (!task->iOk) {
+            // Drop the snapshot. If the history still comes from it,
+            // start over with the saved rides. The new snapshot gets
+            // written when the index is rebuilt.
+            HWARN("Discarding the snapshot");
+            QDir(iDataDir).remove(SNAPSHOT_FILE);
+            iSnapshotStamp = 0;
+            if (iSharedHistory->version() == task->iHistoryVersion) {
+                iSharedHistory->invalidate();
+                queueSignal(SignalHistoryChanged);
+                applyHistory(iSharedHistory->rides());
+                emitQueuedSignals();
+            }
+        }
+    }
+    task->release(this);
+}
+
 void
 BikeSession::Private::setState(
     State aState)
 {
     if (iState != aState) {
         HDEBUG(stateName(iState) << "=>" << stateName(aState));
+        BikeTrace::instant("setState", stateName(aState));
+        logState(aState);
         iState = aState;
         queueSignal(SignalSessionStateChanged);
     }
 }
 
+void
+BikeSession::Private::logSwitch()
+{
+    // The current state (and its timing) belongs to the previous account
+    iStateTimer.invalidate();
+    iLoginTimer.invalidate();
+    if (iState != None) {
+        iLog->addEvent("Switch", stateName(iState), 0, 0);
+    }
+}
+
+void
+BikeSession::Private::logState(
+    State aState)
+{
+    // Time spent in the current state. The timer isn't running if the
+    // state has been inherited from another account (see logSwitch),
+    // there's nothing to measure then.
+    const bool timed = iStateTimer.isValid();
+    const qint64 ms = timed ? iStateTimer.restart() : 0;
+
+    if (!timed) {
+        iStateTimer.start();
+    }
+
+    iLog->addEvent(stateName(iState), stateName(aState),
+        timed ? iHttpError : 0, ms);
+    if (timed && isRequestState(iState)) {
+        iLog->addResult(stateName(iState), isErrorState(aState));
+    }
+
+    if (timed && iState == HistoryQuery && aState == Ready) {
+        iLog->historyLatency()->add(ms);
+    }
+
+    // LoginCheck => UserInfoQuery => HistoryQuery => Ready is the normal
+    // startup sequence, anything else breaks it.
+    switch (aState) {
+    case LoginCheck:
+        iLoginTimer.start();
+        break;
+    case UserInfoQuery:
+    case HistoryQuery:
+        break;
+    case Ready:
+        if (iLoginTimer.isValid()) {
+            iLog->loginLatency()->add(iLoginTimer.elapsed());
+        }
+        /* fallthrough */
+    default:
+        iLoginTimer.invalidate();
+        break;
+    }
+}
+
 void
 BikeSession::Private::setLogin(
     QString aLogin)
@@ -404,30 +897,19 @@ BikeSession::Private::passActive() const
 bool
 BikeSession::Private::rideInProgress() const
 {
-    return !iHistory.isEmpty() &&
-        BikeHistoryModel::rideInProgress(iHistory.first().toObject());
+    return iRideStart != 0;
 }
 
 int
 BikeSession::Private::rideDuration() const
 {
-    if (!iHistory.isEmpty()) {
-        const QJsonObject ride(iHistory.first().toObject());
-
-        if (BikeHistoryModel::rideInProgress(ride)) {
-            const QDateTime departureDate(QDateTime::fromString(ride.
-                value(QStringLiteral("departureDate")).toString(),
-                Qt::ISODate));
-
-            if (departureDate.isValid()) {
-                const QDateTime now(QDateTime::currentDateTime());
-                const qint64 secs = departureDate.secsTo(now);
+    if (iRideStart) {
+        const qint64 secs = QDateTime::currentMSecsSinceEpoch() / 1000 -
+            iRideStart;
 
-                if (secs > 0) {
-                    HDEBUG(secs);
-                    return int(secs);
-                }
-            }
+        if (secs > 0) {
+            HDEBUG(secs);
+            return int(secs);
         }
     }
     return 0;
@@ -437,7 +919,7 @@ void
 BikeSession::Private::start()
 {
     // Query user information
-    startObjectQuery(new BikeUserQuery(&iNetworkAccessManager), LoginCheck,
+    startObjectQuery(new BikeUserQuery(&iConnection), LoginCheck,
         SLOT(onUserQueryFinished(QJsonObject)),
         SLOT(onLoginHttpError(int)),
         SLOT(onLoginNetworkError()));
@@ -448,23 +930,131 @@ BikeSession::Private::setDataDir(
     QString aDataDir)
 {
     if (iDataDir != aDataDir) {
+        // Whatever was going on, belonged to the previous account
+        BikeTrace::Span span("setDataDir");
+
+        iRequest.reset();
+        releaseSnapshotCheck();
+        saveCookies();
+        stashAccount();
         iDataDir = aDataDir;
         HDEBUG(iDataDir);
         queueSignal(SignalDataDirChanged);
         setErrorText(QString());
-        setFirstName(QString());
-        setLastName(QString());
-        saveCookies();
-        iNetworkAccessManager.setCookieJar(loadCookies());
-        setLogin(loadTextFile(LOGIN_FILE));
-        if (iDataDir.isEmpty()) {
-            setState(None);
-        } else {
-            start();
+        iLog->setFile(iDataDir.isEmpty() ? QString() :
+            QDir(iDataDir).filePath(LOG_FILE));
+        logSwitch();
+        if (!restoreAccount()) {
+            iConnection.setCookieJar(loadCookies());
+            setLogin(loadTextFile(LOGIN_FILE));
+            loadCache();
+            if (iDataDir.isEmpty()) {
+                setState(None);
+            } else {
+                start();
+            }
         }
     }
 }
 
+void
+BikeSession::Private::stashAccount()
+{
+    // Only the fully loaded state is worth keeping
+    CookieJar* jar = qobject_cast<CookieJar*>(iConnection.cookieJar());
+
+    if (jar && iState == Ready && !iDataDir.isEmpty()) {
+        Account account;
+
+        account.iDataDir = iDataDir;
+        account.iLogin = iLogin;
+        account.iCookies = jar->allCookies();
+        account.iUserInfo = iUserInfo;
+        account.iServiceInfo = iServiceInfo;
+        account.iIndex = iSharedHistory->index();
+        account.iLastUpdate = iLastUpdate;
+        account.iRidesStamp = iRidesStamp;
+        account.iSnapshotStamp = iSnapshotStamp;
+
+        // No need to keep the rides in memory if they have been saved
+        if (!iRidesStamp || !account.iIndex.iValid) {
+            account.iHistory = iSharedHistory->rides();
+        }
+        iPool.prepend(account);
+        while (iPool.count() > POOL_SIZE) {
+            HDEBUG("Dropping" << iPool.last().iDataDir);
+            iPool.removeLast();
+        }
+        HDEBUG("Stashed" << iDataDir << "(" << iPool.count() << ")");
+    }
+}
+
+void
+BikeSession::Private::forgetRemovedAccounts()
+{
+    // BikeUser::addUser() may recreate the directory of a removed account
+    // for a different user, the stashed state must be gone by then
+    for (int i = iPool.count() - 1; i >= 0; i--) {
+        if (!QDir(iPool.at(i).iDataDir).exists()) {
+            HDEBUG("Forgetting" << iPool.at(i).iDataDir);
+            iPool.removeAt(i);
+        }
+    }
+}
+
+bool
+BikeSession::Private::restoreAccount()
+{
+    for (int i = 0; i < iPool.count(); i++) {
+        if (iPool.at(i).iDataDir == iDataDir) {
+            const Account account(iPool.takeAt(i));
+
+            // The account may have been removed in the meantime
+            if (!QDir(iDataDir).exists()) {
+                HDEBUG(iDataDir << "is gone");
+                return false;
+            }
+
+            CookieJar* jar = new CookieJar(&iConnection);
+
+            jar->setAllCookies(account.iCookies);
+            iConnection.setCookieJar(jar);
+            setLogin(account.iLogin);
+            iUserInfo = account.iUserInfo;
+            iServiceInfo = account.iServiceInfo;
+            applyUserInfo(iUserInfo);
+            applyServiceInfo(iServiceInfo);
+            iRidesStamp = account.iRidesStamp;
+            iSnapshotStamp = account.iSnapshotStamp;
+            if (account.iRidesStamp && account.iIndex.iValid) {
+                applyHistory(QDir(iDataDir).filePath(RIDES_FILE),
+                    account.iIndex);
+            } else {
+                applyHistory(account.iHistory, account.iIndex);
+            }
+            if (iLastUpdate != account.iLastUpdate) {
+                iLastUpdate = account.iLastUpdate;
+                queueSignal(SignalLastUpdateChanged);
+            }
+
+            // Don't bother the server if the data are fresh enough
+            const qint64 age = iLastUpdate.secsTo(QDateTime::currentDateTime());
+
+            if (age >= 0 && age < REVALIDATION_INTERVAL) {
+                HDEBUG("Restored" << iDataDir << age << "sec old");
+                setCached(false);
+                setState(Ready);
+            } else {
+                HDEBUG("Revalidating" << iDataDir << age << "sec old");
+                setCached(true);
+                start();
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
 void
 BikeSession::Private::signIn(
     QString aLogin,
@@ -474,7 +1064,7 @@ BikeSession::Private::signIn(
     saveTextFile(LOGIN_FILE, aLogin);
     setLogin(aLogin);
 
-    BikeLogin* login = new BikeLogin(&iNetworkAccessManager, aLogin, aPassword);
+    BikeLogin* login = new BikeLogin(&iConnection, aLogin, aPassword);
 
     connect(login, SIGNAL(failure(QString)), SLOT(onLoginFailure(QString)));
     connect(login, SIGNAL(success(QJsonObject)), SLOT(onLoginSuccess(QJsonObject)));
@@ -488,18 +1078,18 @@ BikeSession::Private::logOut()
 {
     HDEBUG("Logging out");
 
-    BikeLogout* logout = new BikeLogout(&iNetworkAccessManager);
+    BikeLogout* logout = new BikeLogout(&iConnection);
 
     connect(logout, SIGNAL(finished()), SLOT(onLogoutDone()));
     iRequest.reset(logout);
-    setState(LoggingOut);
     setHttpStatus(0);
+    setState(LoggingOut);
 }
 
 void
 BikeSession::Private::saveCookies() const
 {
-    saveCookies(qobject_cast<CookieJar*>(iNetworkAccessManager.cookieJar()));
+    saveCookies(qobject_cast<CookieJar*>(iConnection.cookieJar()));
 }
 
 void
@@ -528,7 +1118,8 @@ BikeSession::Private::saveCookies(
 QNetworkCookieJar*
 BikeSession::Private::loadCookies()
 {
-    CookieJar* jar = new CookieJar(&iNetworkAccessManager);
+    BikeTrace::Span span("loadCookies");
+    CookieJar* jar = new CookieJar(&iConnection);
 
     if (!iDataDir.isEmpty()) {
         QDir dir(iDataDir);
@@ -610,12 +1201,12 @@ BikeSession::Private::startRequest(
     connect(aRequest, SIGNAL(httpError(int)), aHttpErrorSlot);
     connect(aRequest, SIGNAL(networkError()), aNetworkErrorSlot);
     iRequest.reset(aRequest);
-    setState(aState);
     setHttpStatus(0);
+    setState(aState);
 }
 
 void
-BikeSession::Private::userInfoReceived(
+BikeSession::Private::applyUserInfo(
     const QJsonObject& aUserInfo)
 {
     const QJsonObject user(aUserInfo.value("user").toObject());
@@ -633,10 +1224,33 @@ BikeSession::Private::userInfoReceived(
 
     setFirstName(firstNames);
     setLastName(lastName);
+}
+
+void
+BikeSession::Private::applyServiceInfo(
+    const QJsonObject& aServiceInfo)
+{
+    const bool passWasActive = passActive();
+
+    setIdent(aServiceInfo.value(QStringLiteral("ident_type")).toString(),
+        aServiceInfo.value(QStringLiteral("ident_data")).toString());
+    setPassBeginDate(aServiceInfo.value(QStringLiteral("beg_date")).toString());
+    setPassEndDate(aServiceInfo.value(QStringLiteral("end_date")).toString());
+    if (passWasActive != passActive()) {
+        queueSignal(SignalPassActiveChanged);
+    }
+}
+
+void
+BikeSession::Private::userInfoReceived(
+    const QJsonObject& aUserInfo)
+{
+    iUserInfo = aUserInfo;
+    applyUserInfo(aUserInfo);
     updated();
 
     // Query service info
-    startObjectQuery(new BikeServiceQuery(&iNetworkAccessManager),
+    startObjectQuery(new BikeServiceQuery(&iConnection),
         UserInfoQuery, SLOT(onServiceQueryFinished(QJsonObject)));
 }
 
@@ -644,7 +1258,7 @@ void
 BikeSession::Private::refreshHistory()
 {
     // Query the history
-    BikeHistoryQuery* query = new BikeHistoryQuery(&iNetworkAccessManager);
+    BikeHistoryQuery* query = new BikeHistoryQuery(&iConnection);
 
     connect(query, SIGNAL(finished(QJsonArray)),
         SLOT(onHistoryQueryFinished(QJsonArray)));
@@ -654,20 +1268,63 @@ BikeSession::Private::refreshHistory()
 }
 
 void
-BikeSession::Private::onHistoryQueryFinished(
-    const QJsonArray& aHistory)
+BikeSession::Private::publishHistory(
+    const QJsonArray& aHistory,
+    const BikeHistory::Index& aIndex)
 {
-    const bool wasInProgress = rideInProgress();
-    QList<int> years;
+    // BikeHistory only bumps the version if the contents has changed
+    const int version = iSharedHistory->version();
 
-    HDEBUG("Loaded" << aHistory.size() << "trips");
-    iRequest.reset();
-    iHistory = aHistory;
-    queueSignal(SignalHistoryChanged);
+    iSharedHistory->setRides(aHistory, aIndex);
+    if (iSharedHistory->version() != version) {
+        queueSignal(SignalHistoryChanged);
+    }
+}
+
+void
+BikeSession::Private::setYears(
+    const QList<int>& aYears)
+{
+    if (iYears != aYears) {
+        if (last(iYears) != last(aYears)) {
+            queueSignal(SignalLastYearChanged);
+        }
+        iYears = aYears;
+        queueSignal(SignalYearsChanged);
+    }
+}
+
+void
+BikeSession::Private::updateRideInProgress(
+    bool aWasInProgress)
+{
+    iSummary->setRideDuration(rideDuration());
+    if (rideInProgress() != aWasInProgress) {
+        queueSignal(SignalRideInProgressChanged);
+        queueSignal(SignalRideDurationChanged);
+        if (aWasInProgress) {
+            delete iRideDurationTimer;
+            iRideDurationTimer = Q_NULLPTR;
+        } else if (!iRideDurationTimer) {
+            iRideDurationTimer = new QTimer(this);
+            iRideDurationTimer->setInterval(1000);
+            iRideDurationTimer->start();
+            connect(iRideDurationTimer, SIGNAL(timeout()),
+                SLOT(onRideDurationTimer()));
+        }
+    }
+}
+
+void
+BikeSession::Private::applyHistory(
+    const QJsonArray& aHistory,
+    const BikeHistory::Index& aIndex)
+{
+    const bool wasInProgress = rideInProgress();
+    QJsonArray history(aHistory);
 
 #if 0
     // Simulation of a ride in progress
-    QJsonArray history(aHistory);
     if (!history.isEmpty()) {
         HDEBUG("Simulating ride in progress");
         QJsonObject entry(history.first().toObject());
@@ -678,10 +1335,8 @@ BikeSession::Private::onHistoryQueryFinished(
         entry.insert("returnStation", "");
         history.replace(0, entry);
     }
-    iHistory = history;
 #elif 0
     // Simulation of history change
-    QJsonArray history(aHistory);
     if (!history.isEmpty()) {
         static int count = 1;
         HDEBUG("Adding" << count << "trip(s)");
@@ -690,52 +1345,70 @@ BikeSession::Private::onHistoryQueryFinished(
         }
         count++;
     }
-    iHistory = history;
 #endif
 
-    // Update the years
-    const uint n = aHistory.size();
-    for (uint i = 0; i < n; i++) {
-        const QJsonObject entry(aHistory.at(i).toObject());
-        const QString isoDate(entry.value(QStringLiteral("departureDate")).toString());
-        const QDate date(QDateTime::fromString(isoDate, Qt::ISODate).date());
+    publishHistory(history, aIndex);
 
-        if (date.isValid()) {
-            const int year = date.year();
+    // The ride in progress (if any) comes first
+    const QJsonObject first(history.isEmpty() ? QJsonObject() :
+        history.first().toObject());
+    const QDateTime departureDate(BikeHistoryModel::rideInProgress(first) ?
+        QDateTime::fromString(first.value(QStringLiteral("departureDate")).
+        toString(), Qt::ISODate) : QDateTime());
 
-            if (!years.contains(year)) {
-                years.insert(0, year);
-            }
-        }
-    }
-    qSort(years);
-    if (iYears != years) {
-        if (last(iYears) != last(years)) {
-            queueSignal(SignalLastYearChanged);
-        }
-        iYears = years;
-        queueSignal(SignalYearsChanged);
-    }
+    iRideStart = departureDate.isValid() ?
+        (departureDate.toMSecsSinceEpoch() / 1000) : 0;
 
-    if (rideInProgress() != wasInProgress) {
-        queueSignal(SignalRideInProgressChanged);
-        queueSignal(SignalRideDurationChanged);
-        if (wasInProgress) {
-            delete iRideDurationTimer;
-            iRideDurationTimer = Q_NULLPTR;
-        } else if (!iRideDurationTimer) {
-            iRideDurationTimer = new QTimer(this);
-            iRideDurationTimer->setInterval(1000);
-            iRideDurationTimer->start();
-            parentObject()->connect(iRideDurationTimer, SIGNAL(timeout()),
-                SIGNAL(rideDurationChanged()));
-        }
-    }
+    // Update the years and the summary
+    setYears(Fillari::years(history));
+    iSummary->update(history);
+    updateRideInProgress(wasInProgress);
+}
+
+void
+BikeSession::Private::applyHistory(
+    const QString& aRidesFile,
+    const BikeHistory::Index& aIndex)
+{
+    // Same as above but off the index, the rides remain in the file
+    const bool wasInProgress = rideInProgress();
+    const BikeRideStore::Ride* current = aIndex.iStore.inProgress();
+
+    iSharedHistory->setRides(aRidesFile, aIndex);
+    queueSignal(SignalHistoryChanged);
+    iRideStart = current ? current->iDepartureTime : 0;
+    setYears(Fillari::years(aIndex.iStore));
+    iSummary->update(aIndex.iStore);
+    updateRideInProgress(wasInProgress);
+}
+
+void
+BikeSession::Private::onHistoryQueryFinished(
+    const QJsonArray& aHistory)
+{
+    const int version = iSharedHistory->version();
+
+    HDEBUG("Loaded" << aHistory.size() << "trips");
+    iRequest.reset();
+    applyHistory(aHistory);
     updated();
+    if (iSharedHistory->version() != version || !iRidesStamp) {
+        saveRides();
+    }
+    saveCache();
+    setCached(false);
     setState(Ready);
     emitQueuedSignals();
 }
 
+void
+BikeSession::Private::onRideDurationTimer()
+{
+    iSummary->setRideDuration(rideDuration());
+    queueSignal(SignalRideDurationChanged);
+    emitQueuedSignals();
+}
+
 void
 BikeSession::Private::onServiceQueryFinished(
     const QJsonObject& aServiceInfo)
@@ -776,14 +1449,8 @@ BikeSession::Private::onServiceQueryFinished(
     //   "balance": 0,
     //   "balance_minimum": -100
     // }
-    const bool passWasActive = passActive();
-    setIdent(aServiceInfo.value(QStringLiteral("ident_type")).toString(),
-        aServiceInfo.value(QStringLiteral("ident_data")).toString());
-    setPassBeginDate(aServiceInfo.value(QStringLiteral("beg_date")).toString());
-    setPassEndDate(aServiceInfo.value(QStringLiteral("end_date")).toString());
-    if (passWasActive != passActive()) {
-        queueSignal(SignalPassActiveChanged);
-    }
+    iServiceInfo = aServiceInfo;
+    applyServiceInfo(aServiceInfo);
     refreshHistory();
     updated();
     emitQueuedSignals();
@@ -803,6 +1470,7 @@ BikeSession::Private::onUserQueryFinished(
         iRequest.reset();
         setFirstName(QString());
         setLastName(QString());
+        setCached(false);
         setState(Unauthorized);
     }
     emitQueuedSignals();
@@ -855,7 +1523,7 @@ BikeSession::Private::onLogoutDone()
     const bool rideWasInProgress = rideInProgress();
 
     iRequest.reset();
-    iNetworkAccessManager.setCookieJar(new CookieJar(&iNetworkAccessManager));
+    iConnection.setCookieJar(new CookieJar(&iConnection));
 
     if (!iDataDir.isEmpty()) {
         QDir dir(iDataDir);
@@ -863,12 +1531,22 @@ BikeSession::Private::onLogoutDone()
         if (dir.remove(COOKIES_FILE)) {
             HDEBUG("Removed" << qPrintable(dir.filePath(COOKIES_FILE)));
         }
+        if (dir.remove(CACHE_FILE)) {
+            HDEBUG("Removed" << qPrintable(dir.filePath(CACHE_FILE)));
+        }
+        if (dir.remove(RIDES_FILE)) {
+            HDEBUG("Removed" << qPrintable(dir.filePath(RIDES_FILE)));
+        }
+        if (dir.remove(SNAPSHOT_FILE)) {
+            HDEBUG("Removed" << qPrintable(dir.filePath(SNAPSHOT_FILE)));
+        }
     }
 
-    if (!iHistory.isEmpty()) {
-        iHistory = QJsonArray();
-        queueSignal(SignalHistoryChanged);
-    }
+    iUserInfo = QJsonObject();
+    iServiceInfo = QJsonObject();
+    setCached(false);
+    iRideStart = iRidesStamp = iSnapshotStamp = 0;
+    publishHistory(QJsonArray());
 
     if (!iYears.isEmpty()) {
         iYears.clear();
@@ -883,6 +1561,9 @@ BikeSession::Private::onLogoutDone()
         iRideDurationTimer = Q_NULLPTR;
     }
 
+    iSummary->update(QJsonArray());
+    iSummary->setRideDuration(0);
+
     setHttpStatus(BikeRequest::OK);
     setErrorText(QString());
     setFirstName(QString());
@@ -1022,10 +1703,10 @@ BikeSession::passActive() const
     return iPrivate->passActive();
 }
 
-QJsonArray
+BikeHistory*
 BikeSession::history() const
 {
-    return iPrivate->iHistory;
+    return iPrivate->iSharedHistory;
 }
 
 bool
@@ -1058,6 +1739,24 @@ BikeSession::thisYear() const
     return iPrivate->iThisYear;
 }
 
+BikeSessionSummary*
+BikeSession::summary() const
+{
+    return iPrivate->iSummary;
+}
+
+BikeSessionLog*
+BikeSession::log() const
+{
+    return iPrivate->iLog;
+}
+
+bool
+BikeSession::cached() const
+{
+    return iPrivate->iCached;
+}
+
 void
 BikeSession::restart()
 {
@@ -1088,4 +1787,10 @@ BikeSession::refresh()
     iPrivate->emitQueuedSignals();
 }
 
+void
+BikeSession::forgetRemovedAccounts()
+{
+    iPrivate->forgetRemovedAccounts();
+}
+
 #include "BikeSession.moc"
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2025 Slava Monich <slava@monich.com>
+ * Copyright (C) 2025-2026 Slava Monich <slava@monich.com>
  *
  * You may use this file under the terms of the BSD license as follows:
  *
@@ -39,8 +39,11 @@
 #ifndef BIKE_SESSION_H
 #define BIKE_SESSION_H
 
+#include "BikeHistory.h"
+#include "BikeSessionLog.h"
+#include "BikeSessionSummary.h"
+
 #include <QtCore/QDateTime>
-#include <QtCore/QJsonArray>
 #include <QtCore/QList>
 #include <QtCore/QObject>
 #include <QtCore/QString>
@@ -64,13 +67,17 @@ class BikeSession:
     Q_PROPERTY(QDate passBeginDate READ passBeginDate NOTIFY passBeginDateChanged)
     Q_PROPERTY(QDate passEndDate READ passEndDate NOTIFY passEndDateChanged)
     Q_PROPERTY(bool passActive READ passActive NOTIFY passActiveChanged)
-    Q_PROPERTY(QJsonArray history READ history NOTIFY historyChanged)
+    Q_PROPERTY(BikeHistory* history READ history CONSTANT)
     Q_PROPERTY(bool rideInProgress READ rideInProgress NOTIFY rideInProgressChanged)
     Q_PROPERTY(int rideDuration READ rideDuration NOTIFY rideDurationChanged)
     Q_PROPERTY(QList<int> years READ years NOTIFY yearsChanged)
     Q_PROPERTY(int lastYear READ lastYear NOTIFY lastYearChanged)
     Q_PROPERTY(int thisYear READ thisYear NOTIFY thisYearChanged)
+    Q_PROPERTY(BikeSessionSummary* summary READ summary CONSTANT)
+    Q_PROPERTY(BikeSessionLog* log READ log CONSTANT)
+    Q_PROPERTY(bool cached READ cached NOTIFY cachedChanged)
     Q_ENUMS(State)
+    Q_ENUMS(Change)
 
 public:
     enum State {
@@ -87,6 +94,32 @@ public:
         Ready
     };
 
+    // Bits of the changed() signal parameter
+    enum Change {
+        DataDirChange = 0x000001,
+        LoginChange = 0x000002,
+        ErrorTextChange = 0x000004,
+        HttpErrorChange = 0x000008,
+        SessionStateChange = 0x000010,
+        LastUpdateChange = 0x000020,
+        LastNetworkErrorChange = 0x000040,
+        FirstNamesChange = 0x000080,
+        LastNameChange = 0x000100,
+        FullNameChange = 0x000200,
+        HslCardChange = 0x000400,
+        Nfcid1Change = 0x000800,
+        PassBeginDateChange = 0x001000,
+        PassEndDateChange = 0x002000,
+        PassActiveChange = 0x004000,
+        HistoryChange = 0x008000,
+        RideInProgressChange = 0x010000,
+        RideDurationChange = 0x020000,
+        YearsChange = 0x040000,
+        LastYearChange = 0x080000,
+        ThisYearChange = 0x100000,
+        CachedChange = 0x200000
+    };
+
     explicit BikeSession(QObject* aParent = Q_NULLPTR);
 
     QString dataDir() const;
@@ -106,18 +139,25 @@ public:
     QDate passBeginDate() const;
     QDate passEndDate() const;
     bool passActive() const;
-    QJsonArray history() const;
+    BikeHistory* history() const;
     bool rideInProgress() const;
     int rideDuration() const;
     QList<int> years() const;
     int lastYear() const;
     int thisYear() const;
+    BikeSessionSummary* summary() const;
+    BikeSessionLog* log() const;
+    bool cached() const; // Showing the cached data, not revalidated yet
 
     Q_INVOKABLE void signIn(QString, QString);
     Q_INVOKABLE void logOut();
     Q_INVOKABLE void restart();
     Q_INVOKABLE void refresh();
 
+    // To be called when accounts get removed. The ids (and therefore
+    // directories) of the removed accounts may be reused.
+    Q_INVOKABLE void forgetRemovedAccounts();
+
 Q_SIGNALS:
     void dataDirChanged();
     void loginChanged();
@@ -134,12 +174,18 @@ Q_SIGNALS:
     void passBeginDateChanged();
     void passEndDateChanged();
     void passActiveChanged();
-    void historyChanged();
+    void historyChanged(); // Contents of the history object
     void rideInProgressChanged();
     void rideDurationChanged();
     void yearsChanged();
     void lastYearChanged();
     void thisYearChanged();
+    void cachedChanged();
+
+    // Combined Change bits, emitted once per event loop iteration.
+    // Anything that depends on more than one property should use this
+    // one rather than the individual signals.
+    void changed(int changes);
 
 private:
     class CookieJar;
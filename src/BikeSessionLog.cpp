@@ -0,0 +1,478 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeSessionLog.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QList>
+#include <QtCore/QVector>
+
+#include <limits.h>
+
+#include "HarbourDebug.h"
+#include "HarbourParentSignalQueueObject.h"
+
+// s(SignalName,signalName)
+#define QUEUED_SIGNALS(s) \
+    s(Count,count) \
+    s(ErrorRates,errorRates)
+
+// ==========================================================================
+// BikeSessionLog::Private
+// ==========================================================================
+
+enum BikeSessionLogSignal {
+    #define SIGNAL_ENUM_(Name,name) Signal##Name##Changed,
+    QUEUED_SIGNALS(SIGNAL_ENUM_)
+    #undef  SIGNAL_ENUM_
+    BikeSessionLogSignalCount
+};
+
+typedef HarbourParentSignalQueueObject<BikeSessionLog,
+    BikeSessionLogSignal, BikeSessionLogSignalCount>
+    BikeSessionLogPrivateBase;
+
+class BikeSessionLog::Private :
+    public BikeSessionLogPrivateBase
+{
+    Q_OBJECT
+    static const SignalEmitter gSignalEmitters[];
+
+public:
+    static const QString EVENTS;
+    static const QString RESULTS;
+    static const QString LOGIN;
+    static const QString HISTORY;
+    static const QString TIME;
+    static const QString FROM;
+    static const QString TO;
+    static const QString HTTP;
+    static const QString DURATION;
+    static const QString STATE;
+    static const QString REQUESTS;
+    static const QString ERRORS;
+    static const QString RATE;
+
+    enum {
+        MaxEvents = 200
+    };
+
+    enum Role {
+        RoleTime = Qt::UserRole,
+        RolePrevious,
+        RoleState,
+        RoleHttpStatus,
+        RoleDuration
+    };
+
+    struct Event {
+        QDateTime iTime;
+        QString iFrom;
+        QString iTo;
+        int iHttpStatus;
+        int iDuration; // Time spent in the previous state, milliseconds
+    };
+
+    struct Result {
+        QString iState;
+        int iRequests;
+        int iErrors;
+    };
+
+    Private(BikeSessionLog*);
+    ~Private();
+
+    void load();
+    void scheduleSave();
+    void clearResults();
+
+public Q_SLOTS:
+    void onSave();
+
+public:
+    BikeLatencyHistogram* iLoginLatency;
+    BikeLatencyHistogram* iHistoryLatency;
+    QList<Event> iEvents;
+    QVector<Result> iResults;
+    QString iFile;
+    bool iSaveScheduled;
+};
+
+/* static */
+const BikeSessionLog::Private::SignalEmitter
+BikeSessionLog::Private::gSignalEmitters [] = {
+    #define SIGNAL_EMITTER_(Name,name) &BikeSessionLog::name##Changed,
+    QUEUED_SIGNALS(SIGNAL_EMITTER_)
+    #undef SIGNAL_EMITTER_
+};
+
+const QString BikeSessionLog::Private::EVENTS("events");
+const QString BikeSessionLog::Private::RESULTS("results");
+const QString BikeSessionLog::Private::LOGIN("login");
+const QString BikeSessionLog::Private::HISTORY("history");
+const QString BikeSessionLog::Private::TIME("time");
+const QString BikeSessionLog::Private::FROM("from");
+const QString BikeSessionLog::Private::TO("to");
+const QString BikeSessionLog::Private::HTTP("http");
+const QString BikeSessionLog::Private::DURATION("duration");
+const QString BikeSessionLog::Private::STATE("state");
+const QString BikeSessionLog::Private::REQUESTS("requests");
+const QString BikeSessionLog::Private::ERRORS("errors");
+const QString BikeSessionLog::Private::RATE("rate");
+
+BikeSessionLog::Private::Private(
+    BikeSessionLog* aParent) :
+    BikeSessionLogPrivateBase(aParent, gSignalEmitters),
+    iLoginLatency(new BikeLatencyHistogram(aParent)),
+    iHistoryLatency(new BikeLatencyHistogram(aParent)),
+    iSaveScheduled(false)
+{}
+
+BikeSessionLog::Private::~Private()
+{
+    // Flush the pending changes
+    if (iSaveScheduled) {
+        onSave();
+    }
+}
+
+void
+BikeSessionLog::Private::scheduleSave()
+{
+    // Several transitions often happen within the same event loop
+    // iteration, write the file once.
+    if (!iSaveScheduled && !iFile.isEmpty()) {
+        iSaveScheduled = true;
+        QMetaObject::invokeMethod(this, "onSave", Qt::QueuedConnection);
+    }
+}
+
+void
+BikeSessionLog::Private::onSave()
+{
+    iSaveScheduled = false;
+    if (!iFile.isEmpty()) {
+        QFile file(iFile);
+
+        if (file.open(QIODevice::WriteOnly)) {
+            QJsonArray events, results;
+            QJsonObject json;
+
+            for (int i = 0; i < iEvents.count(); i++) {
+                const Event& event = iEvents.at(i);
+                QJsonObject obj;
+
+                obj.insert(TIME, event.iTime.toString(Qt::ISODate));
+                obj.insert(FROM, event.iFrom);
+                obj.insert(TO, event.iTo);
+                obj.insert(HTTP, event.iHttpStatus);
+                obj.insert(DURATION, event.iDuration);
+                events.append(obj);
+            }
+
+            for (int i = 0; i < iResults.count(); i++) {
+                const Result& result = iResults.at(i);
+                QJsonObject obj;
+
+                obj.insert(STATE, result.iState);
+                obj.insert(REQUESTS, result.iRequests);
+                obj.insert(ERRORS, result.iErrors);
+                results.append(obj);
+            }
+
+            json.insert(EVENTS, events);
+            json.insert(RESULTS, results);
+            json.insert(LOGIN, iLoginLatency->toJson());
+            json.insert(HISTORY, iHistoryLatency->toJson());
+            file.write(QJsonDocument(json).toJson(QJsonDocument::Compact));
+            HDEBUG("Saved" << qPrintable(iFile));
+        } else {
+            HWARN("Failed to write" << qPrintable(iFile));
+        }
+    }
+}
+
+void
+BikeSessionLog::Private::load()
+{
+    BikeSessionLog* model = parentObject();
+    const int prevCount = iEvents.count();
+    QJsonObject json;
+
+    if (!iFile.isEmpty()) {
+        QFile file(iFile);
+
+        if (file.open(QIODevice::ReadOnly)) {
+            json = QJsonDocument::fromJson(file.readAll()).object();
+            HDEBUG("Loaded" << qPrintable(iFile));
+        }
+    }
+
+    const QJsonArray events(json.value(EVENTS).toArray());
+    const QJsonArray results(json.value(RESULTS).toArray());
+    const int n = qMin(events.count(), (int)MaxEvents);
+
+    model->beginResetModel();
+    iEvents.clear();
+    for (int i = 0; i < n; i++) {
+        const QJsonObject obj(events.at(i).toObject());
+        Event event;
+
+        event.iTime = QDateTime::fromString(obj.value(TIME).toString(),
+            Qt::ISODate);
+        event.iFrom = obj.value(FROM).toString();
+        event.iTo = obj.value(TO).toString();
+        event.iHttpStatus = obj.value(HTTP).toInt();
+        event.iDuration = obj.value(DURATION).toInt();
+        iEvents.append(event);
+    }
+    model->endResetModel();
+    if (iEvents.count() != prevCount) {
+        queueSignal(SignalCountChanged);
+    }
+
+    iResults.resize(0);
+    for (int i = 0; i < results.count(); i++) {
+        const QJsonObject obj(results.at(i).toObject());
+        Result result;
+
+        result.iState = obj.value(STATE).toString();
+        result.iRequests = obj.value(REQUESTS).toInt();
+        result.iErrors = obj.value(ERRORS).toInt();
+        iResults.append(result);
+    }
+    queueSignal(SignalErrorRatesChanged);
+
+    iLoginLatency->fromJson(json.value(LOGIN).toObject());
+    iHistoryLatency->fromJson(json.value(HISTORY).toObject());
+}
+
+// ==========================================================================
+// BikeSessionLog
+// ==========================================================================
+
+BikeSessionLog::BikeSessionLog(
+    QObject* aParent) :
+    QAbstractListModel(aParent),
+    iPrivate(new Private(this))
+{}
+
+int
+BikeSessionLog::count() const
+{
+    return iPrivate->iEvents.count();
+}
+
+BikeLatencyHistogram*
+BikeSessionLog::loginLatency() const
+{
+    return iPrivate->iLoginLatency;
+}
+
+BikeLatencyHistogram*
+BikeSessionLog::historyLatency() const
+{
+    return iPrivate->iHistoryLatency;
+}
+
+QVariantList
+BikeSessionLog::errorRates() const
+{
+    QVariantList list;
+
+    for (int i = 0; i < iPrivate->iResults.count(); i++) {
+        const Private::Result& result = iPrivate->iResults.at(i);
+        QVariantMap map;
+
+        map.insert(Private::STATE, result.iState);
+        map.insert(Private::REQUESTS, result.iRequests);
+        map.insert(Private::ERRORS, result.iErrors);
+        map.insert(Private::RATE, result.iRequests ?
+            (qreal(result.iErrors) / result.iRequests) : qreal(0));
+        list.append(map);
+    }
+    return list;
+}
+
+void
+BikeSessionLog::setFile(
+    const QString& aFile)
+{
+    if (iPrivate->iFile != aFile) {
+        HDEBUG(aFile);
+        if (iPrivate->iSaveScheduled) {
+            iPrivate->onSave();
+        }
+        iPrivate->iFile = aFile;
+        iPrivate->load();
+        iPrivate->emitQueuedSignals();
+    }
+}
+
+void
+BikeSessionLog::addEvent(
+    const char* aFrom,
+    const char* aTo,
+    int aHttpStatus,
+    qint64 aDuration)
+{
+    Private::Event event;
+
+    event.iTime = QDateTime::currentDateTime();
+    event.iFrom = QString::fromLatin1(aFrom);
+    event.iTo = QString::fromLatin1(aTo);
+    event.iHttpStatus = aHttpStatus;
+    event.iDuration = (int) qMin(aDuration, qint64(INT_MAX));
+
+    beginInsertRows(QModelIndex(), 0, 0);
+    iPrivate->iEvents.prepend(event);
+    endInsertRows();
+
+    if (iPrivate->iEvents.count() > Private::MaxEvents) {
+        const int last = iPrivate->iEvents.count() - 1;
+
+        beginRemoveRows(QModelIndex(), last, last);
+        iPrivate->iEvents.removeLast();
+        endRemoveRows();
+    } else {
+        iPrivate->queueSignal(SignalCountChanged);
+    }
+
+    iPrivate->scheduleSave();
+    iPrivate->emitQueuedSignals();
+}
+
+void
+BikeSessionLog::addResult(
+    const char* aState,
+    bool aError)
+{
+    const QString state(QString::fromLatin1(aState));
+    QVector<Private::Result>& results = iPrivate->iResults;
+    int i = 0;
+
+    while (i < results.count() && results.at(i).iState != state) {
+        i++;
+    }
+
+    if (i == results.count()) {
+        Private::Result result;
+
+        result.iState = state;
+        result.iRequests = 0;
+        result.iErrors = 0;
+        results.append(result);
+    }
+
+    Private::Result& result = results[i];
+
+    result.iRequests++;
+    if (aError) {
+        result.iErrors++;
+    }
+
+    iPrivate->queueSignal(SignalErrorRatesChanged);
+    iPrivate->scheduleSave();
+    iPrivate->emitQueuedSignals();
+}
+
+void
+BikeSessionLog::clear()
+{
+    HDEBUG("Clearing the log");
+    if (!iPrivate->iEvents.isEmpty()) {
+        beginResetModel();
+        iPrivate->iEvents.clear();
+        endResetModel();
+        iPrivate->queueSignal(SignalCountChanged);
+    }
+    if (!iPrivate->iResults.isEmpty()) {
+        iPrivate->iResults.resize(0);
+        iPrivate->queueSignal(SignalErrorRatesChanged);
+    }
+    iPrivate->iLoginLatency->clear();
+    iPrivate->iHistoryLatency->clear();
+    iPrivate->scheduleSave();
+    iPrivate->emitQueuedSignals();
+}
+
+QHash<int,QByteArray>
+BikeSessionLog::roleNames() const
+{
+    QHash<int,QByteArray> roles;
+
+    roles.insert(Private::RoleTime, "time");
+    roles.insert(Private::RolePrevious, "previous");
+    roles.insert(Private::RoleState, "state");
+    roles.insert(Private::RoleHttpStatus, "httpStatus");
+    roles.insert(Private::RoleDuration, "duration");
+    return roles;
+}
+
+int
+BikeSessionLog::rowCount(
+    const QModelIndex&) const
+{
+    return iPrivate->iEvents.count();
+}
+
+QVariant
+BikeSessionLog::data(
+    const QModelIndex& aIndex,
+    int aRole) const
+{
+    const int row = aIndex.row();
+
+    if (row >= 0 && row < iPrivate->iEvents.count()) {
+        const Private::Event& event = iPrivate->iEvents.at(row);
+
+        switch ((Private::Role)aRole) {
+        case Private::RoleTime: return event.iTime;
+        case Private::RolePrevious: return event.iFrom;
+        case Private::RoleState: return event.iTo;
+        case Private::RoleHttpStatus: return event.iHttpStatus;
+        case Private::RoleDuration: return event.iDuration;
+        }
+    }
+    return QVariant();
+}
+
+#include "BikeSessionLog.moc"
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_SESSION_LOG_H
+#define BIKE_SESSION_LOG_H
+
+#include "BikeLatencyHistogram.h"
+
+#include <QtCore/QVariantList>
+
+// Bounded log of session state transitions (newest first), owned and
+// fed by BikeSession. Also accumulates LoginCheck => Ready and history
+// query latencies and the number of requests and errors per state. The
+// whole thing is stored in a file (if one is set) and survives restarts.
+
+class BikeSessionLog :
+    public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(BikeLatencyHistogram* loginLatency READ loginLatency CONSTANT)
+    Q_PROPERTY(BikeLatencyHistogram* historyLatency READ historyLatency CONSTANT)
+    Q_PROPERTY(QVariantList errorRates READ errorRates NOTIFY errorRatesChanged)
+
+public:
+    BikeSessionLog(QObject* aParent = Q_NULLPTR);
+
+    int count() const;
+    BikeLatencyHistogram* loginLatency() const;
+    BikeLatencyHistogram* historyLatency() const;
+    QVariantList errorRates() const;
+
+    void setFile(const QString&);
+    void addEvent(const char*, const char*, int, qint64);
+    void addResult(const char*, bool);
+
+    Q_INVOKABLE void clear();
+
+    // QAbstractItemModel
+    QHash<int,QByteArray> roleNames() const Q_DECL_OVERRIDE;
+    int rowCount(const QModelIndex&) const Q_DECL_OVERRIDE;
+    QVariant data(const QModelIndex&, int) const Q_DECL_OVERRIDE;
+
+Q_SIGNALS:
+    void countChanged();
+    void errorRatesChanged();
+
+private:
+    class Private;
+    Private* iPrivate;
+};
+
+#endif // BIKE_SESSION_LOG_H
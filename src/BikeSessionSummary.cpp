@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeSessionSummary.h"
+#include "BikeHistoryModel.h"
+
+#include <QtCore/QDateTime>
+
+#include "HarbourDebug.h"
+#include "HarbourParentSignalQueueObject.h"
+
+// s(SignalName,signalName)
+#define QUEUED_SIGNALS(s) \
+    s(Rides,rides) \
+    s(Distance,distance) \
+    s(Duration,duration) \
+    s(LastRide,lastRide) \
+    s(RideInProgress,rideInProgress) \
+    s(RideDuration,rideDuration)
+
+// ==========================================================================
+// BikeSessionSummary::Private
+// ==========================================================================
+
+enum BikeSessionSummarySignal {
+    #define SIGNAL_ENUM_(Name,name) Signal##Name##Changed,
+    QUEUED_SIGNALS(SIGNAL_ENUM_)
+    #undef  SIGNAL_ENUM_
+    BikeSessionSummarySignalCount
+};
+
+typedef HarbourParentSignalQueueObject<BikeSessionSummary,
+    BikeSessionSummarySignal, BikeSessionSummarySignalCount>
+    BikeSessionSummaryPrivateBase;
+
+class BikeSessionSummary::Private :
+    public BikeSessionSummaryPrivateBase
+{
+    static const SignalEmitter gSignalEmitters[];
+
+public:
+    Private(BikeSessionSummary*, int);
+
+    template<typename T>
+    void set(T*, const T&, BikeSessionSummarySignal);
+
+public:
+    const int iYear;
+    int iRides;
+    int iDistance;
+    int iDuration;
+    QJsonObject iLastRide;
+    bool iRideInProgress;
+    int iRideDuration;
+};
+
+/* static */
+const BikeSessionSummary::Private::SignalEmitter
+BikeSessionSummary::Private::gSignalEmitters [] = {
+    #define SIGNAL_EMITTER_(Name,name) &BikeSessionSummary::name##Changed,
+    QUEUED_SIGNALS(SIGNAL_EMITTER_)
+    #undef SIGNAL_EMITTER_
+};
+
+BikeSessionSummary::Private::Private(
+    BikeSessionSummary* aParent,
+    int aYear) :
+    BikeSessionSummaryPrivateBase(aParent, gSignalEmitters),
+    iYear(aYear),
+    iRides(0),
+    iDistance(0),
+    iDuration(0),
+    iRideInProgress(false),
+    iRideDuration(0)
+{}
+
+template<typename T>
+inline
+void
+BikeSessionSummary::Private::set(
+    T* aField,
+    const T& aValue,
+    BikeSessionSummarySignal aSignal)
+{
+    if (*aField != aValue) {
+        *aField = aValue;
+        queueSignal(aSignal);
+    }
+}
+
+// ==========================================================================
+// BikeSessionSummary
+// ==========================================================================
+
+BikeSessionSummary::BikeSessionSummary(
+    int aYear,
+    QObject* aParent) :
+    QObject(aParent),
+    iPrivate(new Private(this, aYear))
+{}
+
+int
+BikeSessionSummary::year() const
+{
+    return iPrivate->iYear;
+}
+
+int
+BikeSessionSummary::rides() const
+{
+    return iPrivate->iRides;
+}
+
+int
+BikeSessionSummary::distance() const
+{
+    return iPrivate->iDistance;
+}
+
+int
+BikeSessionSummary::duration() const
+{
+    return iPrivate->iDuration;
+}
+
+QJsonObject
+BikeSessionSummary::lastRide() const
+{
+    return iPrivate->iLastRide;
+}
+
+bool
+BikeSessionSummary::rideInProgress() const
+{
+    return iPrivate->iRideInProgress;
+}
+
+int
+BikeSessionSummary::rideDuration() const
+{
+    return iPrivate->iRideDuration;
+}
+
+void
+BikeSessionSummary::update(
+    const QJsonArray& aHistory)
+{
+    const QString departureDateKey(QStringLiteral("departureDate"));
+    const QString distanceKey(QStringLiteral("distance"));
+    const QString durationKey(QStringLiteral("duration"));
+    const int n = aHistory.size();
+    const QJsonObject lastRide(n ? aHistory.first().toObject() : QJsonObject());
+    int rides = 0, distance = 0, duration = 0;
+
+    // The history is sorted, newest rides first. Only this year's
+    // rides need to be looked at.
+    for (int i = 0; i < n; i++) {
+        const QJsonObject entry(aHistory.at(i).toObject());
+        const QDate date(QDateTime::fromString(entry.value(departureDateKey).
+            toString(), Qt::ISODate).date());
+
+        if (date.isValid()) {
+            if (date.year() < iPrivate->iYear) {
+                break;
+            } else if (date.year() == iPrivate->iYear) {
+                rides++;
+                distance += entry.value(distanceKey).toInt();
+                duration += entry.value(durationKey).toInt();
+            }
+        }
+    }
+
+    HDEBUG(iPrivate->iYear << rides << "ride(s)" << distance << "m");
+    iPrivate->set(&iPrivate->iRides, rides, SignalRidesChanged);
+    iPrivate->set(&iPrivate->iDistance, distance, SignalDistanceChanged);
+    iPrivate->set(&iPrivate->iDuration, duration, SignalDurationChanged);
+    iPrivate->set(&iPrivate->iLastRide, lastRide, SignalLastRideChanged);
+    iPrivate->set(&iPrivate->iRideInProgress, !lastRide.isEmpty() &&
+        BikeHistoryModel::rideInProgress(lastRide), SignalRideInProgressChanged);
+    iPrivate->emitQueuedSignals();
+}
+
+void
+BikeSessionSummary::update(
+    const BikeRideStore& aStore)
+{
+    // Same thing off the index, without parsing any dates
+    const BikeRideStore::Ride* current = aStore.inProgress();
+    const BikeRideStore::Range range(aStore.yearRange(iPrivate->iYear));
+    const int n = aStore.count();
+    const QJsonObject lastRide(current ? aStore.toJson(*current) :
+        n ? aStore.toJson(aStore.at(n - 1)) : QJsonObject());
+    int distance = 0, duration = 0;
+
+    for (int i = range.iFirst; i < range.iEnd; i++) {
+        const BikeRideStore::Ride& ride = aStore.at(i);
+
+        distance += ride.iDistance;
+        duration += ride.iDuration;
+    }
+
+    // The JSON flavor counts the ride in progress too
+    int rides = range.iEnd - range.iFirst;
+
+    if (current && current->date().year() == iPrivate->iYear) {
+        rides++;
+        distance += current->iDistance;
+        duration += current->iDuration;
+    }
+
+    HDEBUG(iPrivate->iYear << rides << "ride(s)" << distance << "m");
+    iPrivate->set(&iPrivate->iRides, rides, SignalRidesChanged);
+    iPrivate->set(&iPrivate->iDistance, distance, SignalDistanceChanged);
+    iPrivate->set(&iPrivate->iDuration, duration, SignalDurationChanged);
+    iPrivate->set(&iPrivate->iLastRide, lastRide, SignalLastRideChanged);
+    iPrivate->set(&iPrivate->iRideInProgress, current != Q_NULLPTR,
+        SignalRideInProgressChanged);
+    iPrivate->emitQueuedSignals();
+}
+
+void
+BikeSessionSummary::setRideDuration(
+    int aDuration)
+{
+    iPrivate->set(&iPrivate->iRideDuration, aDuration,
+        SignalRideDurationChanged);
+    iPrivate->emitQueuedSignals();
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_SESSION_SUMMARY_H
+#define BIKE_SESSION_SUMMARY_H
+
+#include "BikeRideStore.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+
+// Small precomputed summary of the history, owned and updated by
+// BikeSession. Allows to show this year's totals and the ride in
+// progress (e.g. on the cover) without aggregating the entire history.
+
+class BikeSessionSummary :
+    public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int year READ year CONSTANT)
+    Q_PROPERTY(int rides READ rides NOTIFY ridesChanged)
+    Q_PROPERTY(int distance READ distance NOTIFY distanceChanged)
+    Q_PROPERTY(int duration READ duration NOTIFY durationChanged)
+    Q_PROPERTY(QJsonObject lastRide READ lastRide NOTIFY lastRideChanged)
+    Q_PROPERTY(bool rideInProgress READ rideInProgress NOTIFY rideInProgressChanged)
+    Q_PROPERTY(int rideDuration READ rideDuration NOTIFY rideDurationChanged)
+
+public:
+    BikeSessionSummary(int, QObject* aParent = Q_NULLPTR);
+
+    int year() const;
+    int rides() const;
+    int distance() const;       // meters
+    int duration() const;       // seconds
+    QJsonObject lastRide() const;
+    bool rideInProgress() const;
+    int rideDuration() const;   // seconds
+
+    void update(const QJsonArray&);
+    void update(const BikeRideStore&);
+    void setRideDuration(int);
+
+Q_SIGNALS:
+    void ridesChanged();
+    void distanceChanged();
+    void durationChanged();
+    void lastRideChanged();
+    void rideInProgressChanged();
+    void rideDurationChanged();
+
+private:
+    class Private;
+    Private* iPrivate;
+};
+
+#endif // BIKE_SESSION_SUMMARY_H
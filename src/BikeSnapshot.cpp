@@ -0,0 +1,569 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeSnapshot.h"
+#include "BikeTimeBuckets.h"
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include "HarbourDebug.h"
+
+#include <algorithm>
+
+// ==========================================================================
+// BikeSnapshot::Private
+// ==========================================================================
+
+class BikeSnapshot::Private :
+    public QSharedData
+{
+public:
+    static const char MAGIC[4];
+    static const quint16 VERSION = 4;
+    static const quint16 BYTE_ORDER = 0x0102;
+
+    struct Header {
+        char iMagic[4];
+        quint16 iVersion;
+        quint16 iByteOrder;
+        quint32 iSize;              // Bytes, including the header
+        quint32 iChecksum;          // Of the header and the tables
+        qint64 iStamp;              // Whatever the writer has provided
+        quint32 iRides;             // Completed rides
+        quint32 iCurrent;           // 1 if there is a ride in progress
+        quint32 iStrings;
+        quint32 iStringData;        // UTF-16 units
+        qint32 iFirstYear;
+        quint32 iYears;
+        qint64 iFirstDay;           // Julian day of the first day sum
+        quint32 iDays;              // Number of day sums
+        quint32 iDataChecksum;      // Of the rides and the string data
+    };
+
+    Private(const QString&);
+
+    static quint32 checksum(quint32, const uchar*, qint64);
+    static quint32 checksum(const Header*, const uchar*, qint64);
+    static qint64 size(const Header*);
+    static qint64 ridesSize(const Header*);
+    static qint64 tablesSize(const Header*);
+    static qint64 stringDataSize(const Header*);
+    static BikeRideStore::Range range(const quint32*, int, int, int);
+
+    bool check(const Header*, qint64);
+    QString rawString(int) const;
+
+public:
+    QFile iFile;
+    QAtomicInt iCorrupted;
+    const Header* iHeader;
+    const BikeRideStore::Ride* iRides;
+    const BikeTimeBuckets::Totals* iDaySums;
+    const quint32* iYearIndex;
+    const quint32* iMonthIndex;
+    const quint32* iStringIndex;
+    const quint32* iStringOrder;
+    const QChar* iStringData;
+};
+
+const char BikeSnapshot::Private::MAGIC[4] = { 'F', 'L', 'R', 'S' };
+
+BikeSnapshot::Private::Private(
+    const QString& aPath) :
+    iFile(aPath),
+    iCorrupted(0),
+    iHeader(Q_NULLPTR),
+    iRides(Q_NULLPTR),
+    iDaySums(Q_NULLPTR),
+    iYearIndex(Q_NULLPTR),
+    iMonthIndex(Q_NULLPTR),
+    iStringIndex(Q_NULLPTR),
+    iStringOrder(Q_NULLPTR),
+    iStringData(Q_NULLPTR)
+{
+    // Records are used in place, their layout is part of the file format
+    Q_STATIC_ASSERT(sizeof(Header) == 64);
+    Q_STATIC_ASSERT(sizeof(BikeRideStore::Ride) == 40);
+    Q_STATIC_ASSERT(sizeof(BikeTimeBuckets::Totals) == 24);
+
+    if (iFile.open(QIODevice::ReadOnly)) {
+        const qint64 fileSize = iFile.size();
+        const uchar* data = (fileSize >= qint64(sizeof(Header))) ?
+            iFile.map(0, fileSize) : Q_NULLPTR;
+        const Header* header = (const Header*)data;
+
+        if (header && check(header, fileSize)) {
+            const uchar* ptr = data + sizeof(Header);
+
+            iRides = (const BikeRideStore::Ride*)ptr;
+            ptr += ridesSize(header);
+            iDaySums = (const BikeTimeBuckets::Totals*)ptr;
+            ptr += header->iDays * sizeof(BikeTimeBuckets::Totals);
+            iYearIndex = (const quint32*)ptr;
+            ptr += (header->iYears + 1) * sizeof(quint32);
+            iMonthIndex = (const quint32*)ptr;
+            ptr += (header->iYears * 12 + 1) * sizeof(quint32);
+            iStringIndex = (const quint32*)ptr;
+            ptr += (header->iStrings + 1) * sizeof(quint32);
+            iStringOrder = (const quint32*)ptr;
+            ptr += header->iStrings * sizeof(quint32);
+            iStringData = (const QChar*)ptr;
+            iHeader = header;
+            HDEBUG("Mapped" << qPrintable(aPath) << header->iRides <<
+                "ride(s)," << header->iStrings << "string(s)");
+        } else {
+            HWARN("Discarding" << qPrintable(aPath));
+            iFile.remove();
+        }
+    }
+}
+
+// static
+quint32
+BikeSnapshot::Private::checksum(
+    quint32 aHash,
+    const uchar* aData,
+    qint64 aSize)
+{
+    // FNV-1a
+    for (qint64 i = 0; i < aSize; i++) {
+        aHash ^= aData[i];
+        aHash *= 16777619u;
+    }
+    return aHash;
+}
+
+// static
+quint32
+BikeSnapshot::Private::checksum(
+    const Header* aHeader,
+    const uchar* aTables,
+    qint64 aTablesSize)
+{
+    // Ride records and string data have a separate checksum, checking
+    // it requires touching every page of the file (see verify)
+    Header header(*aHeader);
+
+    header.iChecksum = 0;
+    return checksum(checksum(2166136261u, (const uchar*)&header,
+        sizeof(header)), aTables, aTablesSize);
+}
+
+// static
+qint64
+BikeSnapshot::Private::ridesSize(
+    const Header* aHeader)
+{
+    return qint64(aHeader->iRides + qint64(aHeader->iCurrent)) *
+        sizeof(BikeRideStore::Ride);
+}
+
+// static
+qint64
+BikeSnapshot::Private::tablesSize(
+    const Header* aHeader)
+{
+    // Day sums, year index, month index, string offsets and string order
+    return qint64(aHeader->iDays) * sizeof(BikeTimeBuckets::Totals) +
+        (qint64(aHeader->iYears) * 13 + 2) * sizeof(quint32) +
+        (qint64(aHeader->iStrings) * 2 + 1) * sizeof(quint32);
+}
+
+// static
+qint64
+BikeSnapshot::Private::stringDataSize(
+    const Header* aHeader)
+{
+    return qint64(aHeader->iStringData) * sizeof(QChar);
+}
+
+// static
+qint64
+BikeSnapshot::Private::size(
+    const Header* aHeader)
+{
+    return qint64(sizeof(Header)) + ridesSize(aHeader) +
+        tablesSize(aHeader) + stringDataSize(aHeader);
+}
+
+// static
+BikeRideStore::Range
+BikeSnapshot::Private::range(
+    const quint32* aIndex,
+    int aSlot,
+    int aSlotCount,
+    int aRideCount)
+{
+    BikeRideStore::Range range;
+
+    if (aSlot < 0) {
+        range.iFirst = range.iEnd = 0;
+    } else if (aSlot >= aSlotCount) {
+        range.iFirst = range.iEnd = aRideCount;
+    } else {
+        range.iFirst = aIndex[aSlot];
+        range.iEnd = aIndex[aSlot + 1];
+    }
+    return range;
+}
+
+bool
+BikeSnapshot::Private::check(
+    const Header* aHeader,
+    qint64 aFileSize)
+{
+    if (memcmp(aHeader->iMagic, MAGIC, sizeof(MAGIC))) {
+        HWARN("Bad magic");
+    } else if (aHeader->iVersion != VERSION ||
+        aHeader->iByteOrder != BYTE_ORDER) {
+        HWARN("Unsupported version" << aHeader->iVersion);
+    } else if (aHeader->iSize != aFileSize || size(aHeader) != aFileSize ||
+        aHeader->iCurrent > 1) {
+        HWARN("Bad size" << aFileSize);
+    } else if (aHeader->iChecksum != checksum(aHeader,
+        (const uchar*)(aHeader + 1) + ridesSize(aHeader),
+        tablesSize(aHeader))) {
+        HWARN("Checksum mismatch");
+    } else {
+        return true;
+    }
+    return false;
+}
+
+QString
+BikeSnapshot::Private::rawString(
+    int aIndex) const
+{
+    // Only valid while the file is mapped
+    const quint32 start = iStringIndex[aIndex];
+    const quint32 end = iStringIndex[aIndex + 1];
+
+    return (start <= end && end <= iHeader->iStringData) ?
+        QString::fromRawData(iStringData + start, end - start) : QString();
+}
+
+// ==========================================================================
+// BikeSnapshot
+// ==========================================================================
+
+BikeSnapshot::BikeSnapshot()
+{}
+
+BikeSnapshot::BikeSnapshot(
+    const QString& aPath) :
+    iPrivate(new Private(aPath))
+{
+    if (!iPrivate->iHeader) {
+        iPrivate.reset();
+    }
+}
+
+BikeSnapshot::BikeSnapshot(
+    const BikeSnapshot& aSnapshot) :
+    iPrivate(aSnapshot.iPrivate)
+{}
+
+BikeSnapshot::~BikeSnapshot()
+{}
+
+BikeSnapshot&
+BikeSnapshot::operator=(
+    const BikeSnapshot& aSnapshot)
+{
+    iPrivate = aSnapshot.iPrivate;
+    return *this;
+}
+
+bool
+BikeSnapshot::isValid() const
+{
+    return iPrivate;
+}
+
+qint64
+BikeSnapshot::stamp() const
+{
+    return iPrivate ? iPrivate->iHeader->iStamp : 0;
+}
+
+int
+BikeSnapshot::count() const
+{
+    return iPrivate ? int(iPrivate->iHeader->iRides) : 0;
+}
+
+const BikeRideStore::Ride&
+BikeSnapshot::at(
+    int aIndex) const
+{
+    return iPrivate->iRides[aIndex];
+}
+
+const BikeRideStore::Ride*
+BikeSnapshot::inProgress() const
+{
+    return (iPrivate && iPrivate->iHeader->iCurrent) ?
+        (iPrivate->iRides + iPrivate->iHeader->iRides) : Q_NULLPTR;
+}
+
+QString
+BikeSnapshot::string(
+    int aIndex) const
+{
+    if (iPrivate && aIndex >= 0 && aIndex < stringCount()) {
+        // Deep copy, the string may outlive the mapping
+        const QString raw(iPrivate->rawString(aIndex));
+
+        return QString(raw.constData(), raw.length());
+    }
+    return QString();
+}
+
+int
+BikeSnapshot::findString(
+    const QString& aString) const
+{
+    // Binary search in the sorted order, without copying anything
+    if (iPrivate) {
+        const quint32* order = iPrivate->iStringOrder;
+        const int n = stringCount();
+        int low = 0;
+        int high = n;
+
+        while (low < high) {
+            const int mid = (low + high) / 2;
+
+            if (order[mid] >= quint32(n)) {
+                break;
+            } else if (iPrivate->rawString(order[mid]) < aString) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if (low < n && order[low] < quint32(n) &&
+            iPrivate->rawString(order[low]) == aString) {
+            return int(order[low]);
+        }
+    }
+    return -1;
+}
+
+int
+BikeSnapshot::stringCount() const
+{
+    return iPrivate ? int(iPrivate->iHeader->iStrings) : 0;
+}
+
+BikeTimeBuckets
+BikeSnapshot::buckets() const
+{
+    // A copy, the day sums are small compared to the rides
+    BikeTimeBuckets buckets;
+
+    if (iPrivate) {
+        const int n = int(iPrivate->iHeader->iDays);
+        QVector<BikeTimeBuckets::Totals> sums(n);
+
+        memcpy(sums.data(), iPrivate->iDaySums,
+            n * sizeof(BikeTimeBuckets::Totals));
+        buckets.setPrefixSums(iPrivate->iHeader->iFirstDay, sums);
+    }
+    return buckets;
+}
+
+bool
+BikeSnapshot::verify() const
+{
+    // Reads the entire file, meant to be called on a worker thread
+    if (iPrivate) {
+        const Private::Header* header = iPrivate->iHeader;
+        const quint32 hash = Private::checksum(Private::checksum(2166136261u,
+            (const uchar*)iPrivate->iRides, Private::ridesSize(header)),
+            (const uchar*)iPrivate->iStringData,
+            Private::stringDataSize(header));
+
+        if (hash == header->iDataChecksum) {
+            return true;
+        }
+        HWARN("Data checksum mismatch" << qPrintable(iPrivate->iFile.
+            fileName()));
+        iPrivate->iCorrupted.storeRelease(1);
+    }
+    return false;
+}
+
+bool
+BikeSnapshot::isCorrupted() const
+{
+    return iPrivate && iPrivate->iCorrupted.loadAcquire();
+}
+
+BikeRideStore::Range
+BikeSnapshot::yearRange(
+    int aYear) const
+{
+    const Private::Header* header = iPrivate ? iPrivate->iHeader : Q_NULLPTR;
+
+    return Private::range(header ? iPrivate->iYearIndex : Q_NULLPTR,
+        header ? (aYear - header->iFirstYear) : 0,
+        header ? header->iYears : 0, count());
+}
+
+BikeRideStore::Range
+BikeSnapshot::monthRange(
+    int aYear,
+    int aMonth) const
+{
+    const Private::Header* header = iPrivate ? iPrivate->iHeader : Q_NULLPTR;
+
+    return Private::range(header ? iPrivate->iMonthIndex : Q_NULLPTR,
+        header ? ((aYear - header->iFirstYear) * 12 + aMonth - 1) : 0,
+        header ? header->iYears * 12 : 0, count());
+}
+
+// static
+bool
+BikeSnapshot::write(
+    const QString& aPath,
+    const BikeRideStore& aStore,
+    const BikeTimeBuckets& aBuckets,
+    qint64 aStamp)
+{
+    const int n = aStore.count();
+    const int strings = aStore.stringCount();
+    const BikeRideStore::Ride* current = aStore.inProgress();
+    const int firstYear = n ? aStore.at(0).date().year() : 0;
+    const int lastYear = n ? aStore.at(n - 1).date().year() : 0;
+    const int years = (n && lastYear >= firstYear) ?
+        (lastYear - firstYear + 1) : 0;
+    const QVector<BikeTimeBuckets::Totals>& sums(aBuckets.prefixSums());
+    QVector<quint32> index;
+    QVector<quint32> order;
+    QStringList stringList;
+    QString stringData;
+    QByteArray rides;
+    QByteArray tables;
+    Private::Header header;
+
+    // Year index, month index, string offsets and string order
+    index.reserve(years * 13 + strings * 2 + 3);
+    for (int y = 0; y < years; y++) {
+        index.append(aStore.yearRange(firstYear + y).iFirst);
+    }
+    index.append(n);
+    for (int y = 0; y < years; y++) {
+        for (int m = 1; m <= 12; m++) {
+            index.append(aStore.monthRange(firstYear + y, m).iFirst);
+        }
+    }
+    index.append(n);
+    stringList.reserve(strings);
+    order.reserve(strings);
+    for (int i = 0; i < strings; i++) {
+        stringList.append(aStore.string(i));
+        order.append(i);
+        index.append(stringData.length());
+        stringData.append(stringList.last());
+    }
+    index.append(stringData.length());
+    std::sort(order.begin(), order.end(),
+        [&stringList] (quint32 a, quint32 b) {
+            return stringList.at(a) < stringList.at(b);
+        });
+    index += order;
+
+    rides.reserve((n + 1) * sizeof(BikeRideStore::Ride));
+    for (int i = 0; i < n; i++) {
+        rides.append((const char*)&aStore.at(i),
+            sizeof(BikeRideStore::Ride));
+    }
+    if (current) {
+        rides.append((const char*)current, sizeof(BikeRideStore::Ride));
+    }
+    tables.reserve(sums.count() * sizeof(BikeTimeBuckets::Totals) +
+        index.count() * sizeof(quint32));
+    tables.append((const char*)sums.constData(),
+        sums.count() * sizeof(BikeTimeBuckets::Totals));
+    tables.append((const char*)index.constData(),
+        index.count() * sizeof(quint32));
+
+    const qint64 stringBytes = stringData.length() * sizeof(QChar);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.iMagic, Private::MAGIC, sizeof(header.iMagic));
+    header.iVersion = Private::VERSION;
+    header.iByteOrder = Private::BYTE_ORDER;
+    header.iSize = sizeof(header) + rides.size() + tables.size() +
+        stringBytes;
+    header.iStamp = aStamp;
+    header.iRides = n;
+    header.iCurrent = current ? 1 : 0;
+    header.iStrings = strings;
+    header.iStringData = stringData.length();
+    header.iFirstYear = firstYear;
+    header.iYears = years;
+    header.iFirstDay = aBuckets.firstDay();
+    header.iDays = sums.count();
+    header.iDataChecksum = Private::checksum(Private::checksum(2166136261u,
+        (const uchar*)rides.constData(), rides.size()),
+        (const uchar*)stringData.constData(), stringBytes);
+    header.iChecksum = Private::checksum(&header,
+        (const uchar*)tables.constData(), tables.size());
+
+    QSaveFile file(aPath);
+
+    if (file.open(QIODevice::WriteOnly) &&
+        file.write((const char*)&header, sizeof(header)) == sizeof(header) &&
+        file.write(rides) == rides.size() &&
+        file.write(tables) == tables.size() &&
+        file.write((const char*)stringData.constData(), stringBytes) ==
+            stringBytes &&
+        file.commit()) {
+        HDEBUG("Wrote" << qPrintable(aPath) << header.iSize << "bytes");
+        return true;
+    } else {
+        HWARN("Failed to write" << qPrintable(aPath));
+        return false;
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_SNAPSHOT_H
+#define BIKE_SNAPSHOT_H
+
+#include "BikeRideStore.h"
+
+#include <QtCore/QExplicitlySharedDataPointer>
+#include <QtCore/QString>
+
+// Read-only memory mapped image of BikeRideStore. The file consists of
+// a fixed size header followed by these sections:
+//
+//   Ride records     BikeRideStore::Ride[rides + current]
+//   Day sums         BikeTimeBuckets::Totals[days], prefix sums
+//   Year index       quint32[years + 1], first ride of each year
+//   Month index      quint32[years * 12 + 1], first ride of each month
+//   String offsets   quint32[strings + 1], in UTF-16 units
+//   String order     quint32[strings], string ids sorted by value
+//   String data      UTF-16
+//
+// Records are in the store order (oldest first) and have the same layout
+// as BikeRideStore::Ride, so they are used in place. The ride in progress
+// (if any) follows the completed rides. Year and month indices start with
+// January of the year of the oldest ride, the last entry of each index is
+// the total number of completed rides.
+//
+// Everything is in the native byte order. Files written with a different
+// format version, byte order or failing the checksum are deleted. That
+// checksum only covers the header and the tables (everything except the
+// rides and the string data), so that opening the file doesn't touch
+// the pages holding the rides. The rest is checked by verify(), which
+// reads the whole thing and is meant to be called on a worker thread.
+
+class BikeTimeBuckets;
+
+class BikeSnapshot
+{
+public:
+    BikeSnapshot();
+    BikeSnapshot(const QString&);
+    BikeSnapshot(const BikeSnapshot&);
+    ~BikeSnapshot();
+
+    BikeSnapshot& operator=(const BikeSnapshot&);
+
+    bool isValid() const;
+    bool verify() const;
+    bool isCorrupted() const;
+    qint64 stamp() const;
+    int count() const;
+    const BikeRideStore::Ride& at(int) const;
+    const BikeRideStore::Ride* inProgress() const;
+    QString string(int) const;
+    int stringCount() const;
+    int findString(const QString&) const;
+    BikeRideStore::Range yearRange(int) const;
+    BikeRideStore::Range monthRange(int, int) const;
+    BikeTimeBuckets buckets() const;
+
+    static bool write(const QString&, const BikeRideStore&,
+        const BikeTimeBuckets&, qint64);
+
+private:
+    class Private;
+    QExplicitlySharedDataPointer<Private> iPrivate;
+};
+
+#endif // BIKE_SNAPSHOT_H
@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeTimeBuckets.h"
+#include "BikeRideStore.h"
+
+#include "HarbourDebug.h"
+
+// Julian day number of 1970-01-01
+#define UNIX_EPOCH_JULIAN_DAY Q_INT64_C(2440588)
+#define SECONDS_PER_DAY (24*60*60)
+
+// ==========================================================================
+// BikeTimeBuckets::Totals
+// ==========================================================================
+
+BikeTimeBuckets::Totals::Totals() :
+    iRides(0),
+    iDistance(0),
+    iDuration(0)
+{}
+
+BikeTimeBuckets::Totals&
+BikeTimeBuckets::Totals::operator+=(
+    const Totals& aTotals)
+{
+    iRides += aTotals.iRides;
+    iDistance += aTotals.iDistance;
+    iDuration += aTotals.iDuration;
+    return *this;
+}
+
+BikeTimeBuckets::Totals
+BikeTimeBuckets::Totals::operator-(
+    const Totals& aTotals) const
+{
+    Totals diff;
+
+    diff.iRides = iRides - aTotals.iRides;
+    diff.iDistance = iDistance - aTotals.iDistance;
+    diff.iDuration = iDuration - aTotals.iDuration;
+    return diff;
+}
+
+// ==========================================================================
+// BikeTimeBuckets
+// ==========================================================================
+
+BikeTimeBuckets::BikeTimeBuckets() :
+    iFirstDay(0)
+{}
+
+void
+BikeTimeBuckets::clear()
+{
+    iFirstDay = 0;
+    iPrefix.clear();
+}
+
+void
+BikeTimeBuckets::build(
+    const BikeRideStore& aStore)
+{
+    const int n = aStore.count();
+    const BikeRideStore::Ride* current = aStore.inProgress();
+    QVector<Totals> days;
+
+    // Rides are sorted by departure time, so in most cases the vector
+    // just keeps on growing at the end.
+    clear();
+    for (int i = 0; i <= n; i++) {
+        const BikeRideStore::Ride* ride = (i < n) ? &aStore.at(i) : current;
+
+        if (ride && ride->iDepartureTime > 0) {
+            // Dates are UTC, like everywhere else
+            const qint64 day = ride->iDepartureTime / SECONDS_PER_DAY +
+                UNIX_EPOCH_JULIAN_DAY;
+
+            if (days.isEmpty()) {
+                iFirstDay = day;
+                days.resize(1);
+            } else if (day < iFirstDay) {
+                days.insert(0, int(iFirstDay - day), Totals());
+                iFirstDay = day;
+            } else if (day >= iFirstDay + days.count()) {
+                days.resize(int(day - iFirstDay + 1));
+            }
+
+            Totals* totals = days.data() + (day - iFirstDay);
+
+            totals->iRides++;
+            totals->iDistance += ride->iDistance;
+            totals->iDuration += ride->iDuration;
+        }
+    }
+
+    if (!days.isEmpty()) {
+        const int count = days.count();
+
+        iPrefix.resize(count + 1);
+        for (int i = 0; i < count; i++) {
+            Totals sum(iPrefix.at(i));
+
+            sum += days.at(i);
+            iPrefix[i + 1] = sum;
+        }
+        HDEBUG(count << "day(s) starting" << firstDate());
+    }
+}
+
+bool
+BikeTimeBuckets::isEmpty() const
+{
+    return iPrefix.isEmpty();
+}
+
+QDate
+BikeTimeBuckets::firstDate() const
+{
+    return isEmpty() ? QDate() : QDate::fromJulianDay(iFirstDay);
+}
+
+QDate
+BikeTimeBuckets::lastDate() const
+{
+    return isEmpty() ? QDate() :
+        QDate::fromJulianDay(iFirstDay + iPrefix.count() - 2);
+}
+
+qint64
+BikeTimeBuckets::firstDay() const
+{
+    return iFirstDay;
+}
+
+const QVector<BikeTimeBuckets::Totals>&
+BikeTimeBuckets::prefixSums() const
+{
+    return iPrefix;
+}
+
+void
+BikeTimeBuckets::setPrefixSums(
+    qint64 aFirstDay,
+    const QVector<Totals>& aPrefix)
+{
+    // Either empty or at least one day and the leading zero
+    if (aPrefix.count() > 1) {
+        iFirstDay = aFirstDay;
+        iPrefix = aPrefix;
+    } else {
+        clear();
+    }
+}
+
+BikeTimeBuckets::Totals
+BikeTimeBuckets::total(
+    const QDate& aFrom,
+    const QDate& aTo) const
+{
+    // Both ends are inclusive
+    if (!isEmpty() && aFrom.isValid() && aTo.isValid()) {
+        const qint64 n = iPrefix.count() - 1;
+        const qint64 from = qMax(aFrom.toJulianDay() - iFirstDay, Q_INT64_C(0));
+        const qint64 to = qMin(aTo.toJulianDay() - iFirstDay + 1, n);
+
+        if (from < to) {
+            return iPrefix.at(int(to)) - iPrefix.at(int(from));
+        }
+    }
+    return Totals();
+}
+
+BikeTimeBuckets::Totals
+BikeTimeBuckets::bucket(
+    const QDate& aDate,
+    Resolution aResolution) const
+{
+    return total(bucketStart(aDate, aResolution),
+        bucketEnd(aDate, aResolution));
+}
+
+// static
+QDate
+BikeTimeBuckets::bucketStart(
+    const QDate& aDate,
+    Resolution aResolution)
+{
+    if (aDate.isValid()) {
+        switch (aResolution) {
+        case Day:
+            return aDate;
+        case Week:
+            return aDate.addDays(1 - aDate.dayOfWeek());
+        case Month:
+            return QDate(aDate.year(), aDate.month(), 1);
+        case Season:
+            return QDate(aDate.year(), SeasonFirstMonth, 1);
+        }
+    }
+    return QDate();
+}
+
+// static
+QDate
+BikeTimeBuckets::bucketEnd(
+    const QDate& aDate,
+    Resolution aResolution)
+{
+    if (aDate.isValid()) {
+        switch (aResolution) {
+        case Day:
+            return aDate;
+        case Week:
+            return aDate.addDays(7 - aDate.dayOfWeek());
+        case Month:
+            return QDate(aDate.year(), aDate.month(), aDate.daysInMonth());
+        case Season:
+            return QDate(aDate.year(), SeasonLastMonth, 1).addMonths(1).
+                addDays(-1);
+        }
+    }
+    return QDate();
+}
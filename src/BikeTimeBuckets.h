@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_TIME_BUCKETS_H
+#define BIKE_TIME_BUCKETS_H
+
+#include <QtCore/QDate>
+#include <QtCore/QVector>
+
+class BikeRideStore;
+
+// Per-day totals with prefix sums. Totals for any date range (and
+// therefore for any day, week, month or season) are O(1) once the
+// buckets have been built.
+
+class BikeTimeBuckets
+{
+public:
+    enum Resolution {
+        Day,
+        Week,       // ISO week, Monday to Sunday
+        Month,
+        Season      // April to October
+    };
+
+    enum {
+        SeasonFirstMonth = 4,
+        SeasonLastMonth = 10
+    };
+
+    struct Totals {
+        Totals();
+        Totals& operator+=(const Totals&);
+        Totals operator-(const Totals&) const;
+
+        qint64 iRides;
+        qint64 iDistance;   // meters
+        qint64 iDuration;   // seconds
+    };
+
+    BikeTimeBuckets();
+
+    void clear();
+    void build(const BikeRideStore&);
+
+    bool isEmpty() const;
+    QDate firstDate() const;
+    QDate lastDate() const;
+
+    Totals total(const QDate&, const QDate&) const;
+    Totals bucket(const QDate&, Resolution) const;
+
+    // Raw prefix sums, for saving and restoring them (see BikeSnapshot)
+    qint64 firstDay() const;
+    const QVector<Totals>& prefixSums() const;
+    void setPrefixSums(qint64, const QVector<Totals>&);
+
+    static QDate bucketStart(const QDate&, Resolution);
+    static QDate bucketEnd(const QDate&, Resolution);
+
+private:
+    qint64 iFirstDay;               // Julian day of the first bucket
+    QVector<Totals> iPrefix;        // iPrefix[i] = sum of days [0, i)
+};
+
+#endif // BIKE_TIME_BUCKETS_H
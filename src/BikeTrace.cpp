@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeTrace.h"
+
+#include <QtCore/QAtomicPointer>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+
+#include "HarbourDebug.h"
+
+// ==========================================================================
+// BikeTraceBuffer
+// ==========================================================================
+
+namespace {
+
+struct BikeTraceEvent {
+    const char* iName;
+    const char* iArg;
+    qint64 iTimestamp;  // ns since BikeTrace::init()
+    qint64 iDuration;   // ns, negative for instant events
+    quintptr iThread;
+};
+
+class BikeTraceBuffer {
+public:
+    enum { Capacity = 4096 };
+
+    BikeTraceBuffer() : iNext(0), iCount(0) {}
+
+    void append(const BikeTraceEvent&);
+    const BikeTraceEvent& at(int) const;
+
+public:
+    QMutex iMutex;
+    QElapsedTimer iTimer;
+    QByteArray iFile;
+    quintptr iMainThread;
+    int iNext;
+    int iCount;
+    BikeTraceEvent iEvents[Capacity];
+};
+
+void
+BikeTraceBuffer::append(
+    const BikeTraceEvent& aEvent)
+{
+    // Overwrites the oldest event when full
+    iEvents[iNext] = aEvent;
+    iNext = (iNext + 1) % Capacity;
+    if (iCount < Capacity) {
+        iCount++;
+    }
+}
+
+inline
+const BikeTraceEvent&
+BikeTraceBuffer::at(
+    int aIndex) const
+{
+    // Zero is the oldest event
+    return iEvents[(iNext - iCount + aIndex + Capacity) % Capacity];
+}
+
+// Allocated once and never freed. Worker threads may still be recording
+// when the app is exiting, deleting the buffer in finish() would pull it
+// from under their feet.
+QAtomicPointer<BikeTraceBuffer> bikeTraceBuffer;
+
+} // namespace
+
+// ==========================================================================
+// BikeTrace
+// ==========================================================================
+
+bool BikeTrace::gEnabled = false;
+
+void
+BikeTrace::init()
+{
+    // Called once, at startup
+    const QByteArray file(qgetenv("FILLARI_TRACE"));
+
+    if (!file.isEmpty() && !bikeTraceBuffer.loadAcquire()) {
+        BikeTraceBuffer* buffer = new BikeTraceBuffer;
+
+        buffer->iFile = file;
+        buffer->iMainThread = quintptr(QThread::currentThreadId());
+        buffer->iTimer.start();
+        bikeTraceBuffer.storeRelease(buffer);
+        gEnabled = true;
+    }
+}
+
+void
+BikeTrace::finish()
+{
+    BikeTraceBuffer* buffer = bikeTraceBuffer.loadAcquire();
+
+    // Stop recording new events first. The events still being recorded
+    // by other threads are serialized with saving by the buffer's mutex.
+    if (buffer && gEnabled) {
+        gEnabled = false;
+        save(QString::fromLocal8Bit(buffer->iFile));
+    }
+}
+
+qint64
+BikeTrace::now()
+{
+    BikeTraceBuffer* buffer = bikeTraceBuffer.loadAcquire();
+
+    return buffer ? buffer->iTimer.nsecsElapsed() : 0;
+}
+
+void
+BikeTrace::record(
+    const char* aName,
+    const char* aArg,
+    qint64 aTimestamp,
+    qint64 aDuration)
+{
+    BikeTraceBuffer* buffer = bikeTraceBuffer.loadAcquire();
+
+    if (buffer) {
+        BikeTraceEvent event;
+
+        event.iName = aName;
+        event.iArg = aArg;
+        event.iTimestamp = aTimestamp;
+        event.iDuration = aDuration;
+        event.iThread = quintptr(QThread::currentThreadId());
+
+        QMutexLocker lock(&buffer->iMutex);
+        buffer->append(event);
+    }
+}
+
+QByteArray
+BikeTrace::toText()
+{
+    BikeTraceBuffer* buffer = bikeTraceBuffer.loadAcquire();
+    QByteArray text;
+
+    if (buffer) {
+        QMutexLocker lock(&buffer->iMutex);
+        const int n = buffer->iCount;
+
+        for (int i = 0; i < n; i++) {
+            const BikeTraceEvent& e = buffer->at(i);
+
+            // Milliseconds with microsecond precision
+            text.append(QByteArray::number(e.iTimestamp / 1000000.0, 'f', 3));
+            text.append(e.iThread == buffer->iMainThread ? " " : " * ");
+            text.append(e.iName);
+            if (e.iArg) {
+                text.append(" (").append(e.iArg).append(')');
+            }
+            if (e.iDuration >= 0) {
+                text.append(' ');
+                text.append(QByteArray::number(e.iDuration / 1000000.0, 'f', 3));
+                text.append(" ms");
+            }
+            text.append('\n');
+        }
+    }
+    return text;
+}
+
+QByteArray
+BikeTrace::toJson()
+{
+    BikeTraceBuffer* buffer = bikeTraceBuffer.loadAcquire();
+    QByteArray json("{\"traceEvents\":[");
+
+    if (buffer) {
+        QMutexLocker lock(&buffer->iMutex);
+        const int n = buffer->iCount;
+        const QByteArray pid(QByteArray::number(QCoreApplication::applicationPid()));
+
+        // Names and arguments are string literals, don't need escaping
+        for (int i = 0; i < n; i++) {
+            const BikeTraceEvent& e = buffer->at(i);
+
+            if (i) {
+                json.append(',');
+            }
+            json.append("\n{\"name\":\"").append(e.iName);
+            json.append("\",\"ph\":\"").append(e.iDuration < 0 ? "i\",\"s\":\"t" : "X");
+            json.append("\",\"ts\":").append(QByteArray::number(e.iTimestamp / 1000.0, 'f', 3));
+            if (e.iDuration >= 0) {
+                json.append(",\"dur\":").append(QByteArray::number(e.iDuration / 1000.0, 'f', 3));
+            }
+            json.append(",\"pid\":").append(pid);
+            json.append(",\"tid\":").append(QByteArray::number(qulonglong(e.iThread)));
+            if (e.iArg) {
+                json.append(",\"args\":{\"arg\":\"").append(e.iArg).append("\"}");
+            }
+            json.append('}');
+        }
+    }
+    json.append("\n]}\n");
+    return json;
+}
+
+bool
+BikeTrace::save(
+    const QString& aFileName)
+{
+    QFile file(aFileName);
+
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        const QByteArray data(aFileName.endsWith(QStringLiteral(".json")) ?
+            toJson() : toText());
+
+        if (file.write(data) == data.size()) {
+            HDEBUG("Wrote" << qPrintable(aFileName));
+            return true;
+        }
+    }
+    HWARN("Failed to write" << qPrintable(aFileName));
+    return false;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_TRACE_H
+#define BIKE_TRACE_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+// Lightweight timeline tracing, compiled into release builds. Disabled
+// unless FILLARI_TRACE environment variable is set, in which case the
+// events are collected into a fixed size ring buffer and written to the
+// file named by the environment variable when the app exits. Files with
+// .json extension are written in Chrome trace event format (to be opened
+// with chrome://tracing or https://ui.perfetto.dev), other files are
+// plain text.
+//
+// Names and arguments must be string literals (or otherwise outlive
+// the trace), only the pointers are stored.
+
+class BikeTrace
+{
+public:
+    class Span {
+    public:
+        Span(const char*, const char* aArg = Q_NULLPTR);
+        ~Span();
+
+    private:
+        const char* iName;
+        const char* iArg;
+        qint64 iStart;
+    };
+
+    static void init();
+    static void finish();
+    static bool enabled();
+    static void instant(const char*, const char* aArg = Q_NULLPTR);
+
+    static bool save(const QString&);
+    static QByteArray toText();
+    static QByteArray toJson();
+
+private:
+    static qint64 now();
+    static void record(const char*, const char*, qint64, qint64);
+
+private:
+    static bool gEnabled;
+};
+
+inline
+bool
+BikeTrace::enabled()
+{
+    return gEnabled;
+}
+
+inline
+void
+BikeTrace::instant(
+    const char* aName,
+    const char* aArg)
+{
+    if (Q_UNLIKELY(gEnabled)) {
+        record(aName, aArg, now(), -1);
+    }
+}
+
+inline
+BikeTrace::Span::Span(
+    const char* aName,
+    const char* aArg) :
+    iName(aName),
+    iArg(aArg),
+    iStart(Q_UNLIKELY(gEnabled) ? now() : -1)
+{}
+
+inline
+BikeTrace::Span::~Span()
+{
+    if (Q_UNLIKELY(iStart >= 0)) {
+        record(iName, iArg, iStart, now() - iStart);
+    }
+}
+
+#endif // BIKE_TRACE_H
@@ -0,0 +1,376 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "BikeTransport.h"
+
+#include "BikeRecording.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+
+#include "HarbourDebug.h"
+
+// ==========================================================================
+// BikeTransport::Live
+// ==========================================================================
+
+class BikeTransport::Live :
+    public BikeTransport
+{
+public:
+    QNetworkReply* get(QNetworkAccessManager*, const QNetworkRequest&)
+        Q_DECL_OVERRIDE;
+    QNetworkReply* post(QNetworkAccessManager*, const QNetworkRequest&,
+        const QByteArray&) Q_DECL_OVERRIDE;
+};
+
+QNetworkReply*
+BikeTransport::Live::get(
+    QNetworkAccessManager* aNetworkAccessManager,
+    const QNetworkRequest& aRequest)
+{
+    return aNetworkAccessManager->get(aRequest);
+}
+
+QNetworkReply*
+BikeTransport::Live::post(
+    QNetworkAccessManager* aNetworkAccessManager,
+    const QNetworkRequest& aRequest,
+    const QByteArray& aData)
+{
+    return aNetworkAccessManager->post(aRequest, aData);
+}
+
+// ==========================================================================
+// BikeTransport::Recorder
+// ==========================================================================
+
+class BikeTransport::Recorder :
+    public QObject,
+    public Live
+{
+    Q_OBJECT
+
+public:
+    Recorder(const QString&);
+
+    QNetworkReply* get(QNetworkAccessManager*, const QNetworkRequest&)
+        Q_DECL_OVERRIDE;
+    QNetworkReply* post(QNetworkAccessManager*, const QNetworkRequest&,
+        const QByteArray&) Q_DECL_OVERRIDE;
+
+private:
+    QNetworkReply* watch(QNetworkReply*);
+
+private Q_SLOTS:
+    void onReplyFinished();
+
+private:
+    const QString iDir;
+    BikeRecording iRecording;
+    QElapsedTimer iClock;
+    QHash<QNetworkReply*,qint64> iStartTimes;
+};
+
+BikeTransport::Recorder::Recorder(
+    const QString& aDir) :
+    iDir(aDir)
+{
+    // Keep adding to the existing recording
+    iRecording.load(aDir);
+    iClock.start();
+}
+
+QNetworkReply*
+BikeTransport::Recorder::get(
+    QNetworkAccessManager* aNetworkAccessManager,
+    const QNetworkRequest& aRequest)
+{
+    return watch(Live::get(aNetworkAccessManager, aRequest));
+}
+
+QNetworkReply*
+BikeTransport::Recorder::post(
+    QNetworkAccessManager* aNetworkAccessManager,
+    const QNetworkRequest& aRequest,
+    const QByteArray& aData)
+{
+    // The request body is not recorded, it may contain the password
+    return watch(Live::post(aNetworkAccessManager, aRequest, aData));
+}
+
+QNetworkReply*
+BikeTransport::Recorder::watch(
+    QNetworkReply* aReply)
+{
+    // Connecting first guarantees that we get to peek at the data
+    // before BikeRequest reads it
+    iStartTimes.insert(aReply, iClock.elapsed());
+    connect(aReply, SIGNAL(finished()), SLOT(onReplyFinished()));
+    return aReply;
+}
+
+void
+BikeTransport::Recorder::onReplyFinished()
+{
+    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
+    const int status = reply->attribute(QNetworkRequest::
+        HttpStatusCodeAttribute).toInt();
+    const qint64 start = iStartTimes.take(reply);
+
+    if (status) {
+        const QList<QNetworkReply::RawHeaderPair>& headers =
+            reply->rawHeaderPairs();
+        BikeRecording::Exchange exchange;
+
+        exchange.iMethod = (reply->operation() ==
+            QNetworkAccessManager::PostOperation) ? "POST" : "GET";
+        exchange.iPath = reply->url().toEncoded(QUrl::RemoveScheme |
+            QUrl::RemoveAuthority | QUrl::RemoveFragment);
+        exchange.iStatus = status;
+        exchange.iTime = (int)(iClock.elapsed() - start);
+        exchange.iBody = reply->peek(reply->bytesAvailable());
+
+        for (int i = 0; i < headers.count(); i++) {
+            const QNetworkReply::RawHeaderPair& header = headers.at(i);
+            const QByteArray name(header.first.toLower());
+
+            if (name == "set-cookie") {
+                // QNetworkReply joins multiple cookies with newlines
+                const QList<QByteArray> cookies(header.second.split('\n'));
+
+                for (int k = 0; k < cookies.count(); k++) {
+                    exchange.iHeaders.append(BikeRecording::Header(
+                        header.first, cookies.at(k)));
+                }
+            } else if (name != "content-length" &&
+                name != "content-encoding" &&
+                name != "transfer-encoding") {
+                // The body has already been decoded
+                exchange.iHeaders.append(header);
+            }
+        }
+        iRecording.append(iDir, exchange);
+    } else {
+        HDEBUG("Not recording" << reply->url().toString() << reply->error());
+    }
+}
+
+// ==========================================================================
+// BikeTransport::ReplayReply
+// ==========================================================================
+
+class BikeTransport::ReplayReply :
+    public QNetworkReply
+{
+    Q_OBJECT
+
+public:
+    ReplayReply(QNetworkAccessManager*, const QNetworkRequest&,
+        QNetworkAccessManager::Operation, const BikeRecording::Exchange*);
+
+    void abort() Q_DECL_OVERRIDE;
+    qint64 bytesAvailable() const Q_DECL_OVERRIDE;
+
+protected:
+    qint64 readData(char*, qint64) Q_DECL_OVERRIDE;
+
+private Q_SLOTS:
+    void onFinish();
+
+private:
+    QByteArray iData;
+    qint64 iOffset;
+};
+
+BikeTransport::ReplayReply::ReplayReply(
+    QNetworkAccessManager* aParent,
+    const QNetworkRequest& aRequest,
+    QNetworkAccessManager::Operation aOperation,
+    const BikeRecording::Exchange* aExchange) :
+    QNetworkReply(aParent),
+    iOffset(0)
+{
+    int status = 404;
+
+    setRequest(aRequest);
+    setUrl(aRequest.url());
+    setOperation(aOperation);
+    if (aExchange) {
+        status = aExchange->iStatus;
+        iData = aExchange->iBody;
+        for (int i = 0; i < aExchange->iHeaders.count(); i++) {
+            const BikeRecording::Header& header = aExchange->iHeaders.at(i);
+            const QByteArray name(header.first.toLower());
+
+            if (name != "content-length" &&
+                name != "content-encoding" &&
+                name != "transfer-encoding") {
+                QByteArray value(header.second);
+
+                // Merge repeated headers the way QNetworkReply does
+                if (hasRawHeader(header.first)) {
+                    value = rawHeader(header.first) +
+                        ((name == "set-cookie") ? "\n" : ", ") + value;
+                }
+                setRawHeader(header.first, value);
+            }
+        }
+    }
+    setAttribute(QNetworkRequest::HttpStatusCodeAttribute, status);
+    setHeader(QNetworkRequest::ContentLengthHeader, iData.size());
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    QMetaObject::invokeMethod(this, "onFinish", Qt::QueuedConnection);
+}
+
+void
+BikeTransport::ReplayReply::abort()
+{
+    iOffset = iData.size();
+}
+
+qint64
+BikeTransport::ReplayReply::bytesAvailable() const
+{
+    return (iData.size() - iOffset) + QNetworkReply::bytesAvailable();
+}
+
+qint64
+BikeTransport::ReplayReply::readData(
+    char* aBuffer,
+    qint64 aMaxSize)
+{
+    const qint64 n = qMin(aMaxSize, iData.size() - iOffset);
+
+    if (n > 0) {
+        memcpy(aBuffer, iData.constData() + iOffset, n);
+        iOffset += n;
+        return n;
+    }
+    return isFinished() ? -1 : 0;
+}
+
+void
+BikeTransport::ReplayReply::onFinish()
+{
+    setFinished(true);
+    if (iOffset < iData.size()) {
+        Q_EMIT readyRead();
+    }
+    Q_EMIT finished();
+}
+
+// ==========================================================================
+// BikeTransport::Replay
+// ==========================================================================
+
+class BikeTransport::Replay :
+    public BikeTransport
+{
+public:
+    Replay(const QString&);
+
+    QNetworkReply* get(QNetworkAccessManager*, const QNetworkRequest&)
+        Q_DECL_OVERRIDE;
+    QNetworkReply* post(QNetworkAccessManager*, const QNetworkRequest&,
+        const QByteArray&) Q_DECL_OVERRIDE;
+
+private:
+    BikeRecording iRecording;
+};
+
+BikeTransport::Replay::Replay(
+    const QString& aDir)
+{
+    iRecording.load(aDir);
+}
+
+QNetworkReply*
+BikeTransport::Replay::get(
+    QNetworkAccessManager* aNetworkAccessManager,
+    const QNetworkRequest& aRequest)
+{
+    return new ReplayReply(aNetworkAccessManager, aRequest,
+        QNetworkAccessManager::GetOperation,
+        iRecording.next("GET", aRequest.url().toEncoded()));
+}
+
+QNetworkReply*
+BikeTransport::Replay::post(
+    QNetworkAccessManager* aNetworkAccessManager,
+    const QNetworkRequest& aRequest,
+    const QByteArray&)
+{
+    return new ReplayReply(aNetworkAccessManager, aRequest,
+        QNetworkAccessManager::PostOperation,
+        iRecording.next("POST", aRequest.url().toEncoded()));
+}
+
+// ==========================================================================
+// BikeTransport
+// ==========================================================================
+
+BikeTransport::~BikeTransport()
+{}
+
+// static
+BikeTransport*
+BikeTransport::newLive()
+{
+    return new Live;
+}
+
+// static
+BikeTransport*
+BikeTransport::newRecorder(
+    const QString& aDir)
+{
+    return new Recorder(aDir);
+}
+
+// static
+BikeTransport*
+BikeTransport::newReplay(
+    const QString& aDir)
+{
+    return new Replay(aDir);
+}
+
+#include "BikeTransport.moc"
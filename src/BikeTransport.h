@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef BIKE_TRANSPORT_H
+#define BIKE_TRANSPORT_H
+
+#include <QtCore/QString>
+#include <QtNetwork/QNetworkRequest>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+// Sends the requests on behalf of BikeRequest. There are three kinds:
+//
+//   live:   sends them to the network
+//   record: same as live but also saves the responses to a directory
+//   replay: serves the responses saved by record from memory
+//
+// See BikeRecording.h for what's being saved. Replayed responses are
+// finished on the next pass of the event loop, without any delay. That
+// takes the network out of the picture, what's left is the cost of
+// parsing the responses and updating the models. The mock server can
+// replay the same recording with the recorded timing.
+//
+// Cookies are handled by BikeRequest with the cookie jar of the
+// BikeConnection (the shared network access manager has none), in
+// replay mode too.
+
+class BikeTransport
+{
+public:
+    virtual ~BikeTransport();
+
+    virtual QNetworkReply* get(QNetworkAccessManager*,
+        const QNetworkRequest&) = 0;
+    virtual QNetworkReply* post(QNetworkAccessManager*,
+        const QNetworkRequest&, const QByteArray&) = 0;
+
+    static BikeTransport* newLive();
+    static BikeTransport* newRecorder(const QString&);
+    static BikeTransport* newReplay(const QString&);
+
+private:
+    class Live;
+    class Recorder;
+    class Replay;
+    class ReplayReply;
+};
+
+#endif // BIKE_TRANSPORT_H
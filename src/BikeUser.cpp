@@ -39,9 +39,12 @@
 #include "BikeUser.h"
 
 #include "BikeApp.h"
+#include "BikeTrace.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QFile>
 #include <QtCore/QStandardPaths>
+#include <QtCore/QTextStream>
 
 #include "HarbourDebug.h"
 
@@ -52,6 +55,10 @@
 class BikeUser::Private
 {
 public:
+    static const QString LAST_USER_FILE;
+
+    static QDir rootDir();
+    static QString readLine(const QString&);
     bool setUserName(const QString&);
 
 public:
@@ -59,6 +66,33 @@ public:
     QString iDataDir;
 };
 
+const QString BikeUser::Private::LAST_USER_FILE("LastUser");
+
+// static
+QDir
+BikeUser::Private::rootDir()
+{
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::ConfigLocation).
+        append(QDir::separator()).append(BIKE_CONF_DIR));
+}
+
+// static
+QString
+BikeUser::Private::readLine(
+    const QString& aPath)
+{
+    QFile file(aPath);
+
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QTextStream in(&file);
+
+        if (!in.atEnd()) {
+            return in.readLine().trimmed();
+        }
+    }
+    return QString();
+}
+
 bool
 BikeUser::Private::setUserName(
     const QString& aUserName)
@@ -70,10 +104,16 @@ BikeUser::Private::setUserName(
             iDataDir.clear();
             return true;
         } else {
-            QDir dir(QStandardPaths::writableLocation(QStandardPaths::ConfigLocation).
-                append(QDir::separator()).append(BIKE_CONF_DIR).
-                append(QDir::separator()).append(aUserName));
+            const QDir root(rootDir());
+            QDir dir(root.filePath(aUserName));
+
             if (dir.mkpath(".")) {
+                QFile lastUser(root.filePath(LAST_USER_FILE));
+
+                // Start with the same account next time
+                if (lastUser.open(QIODevice::WriteOnly | QIODevice::Text)) {
+                    QTextStream(&lastUser) << aUserName;
+                }
                 iUserName = aUserName;
                 iDataDir = dir.absolutePath();
                 return true;
@@ -109,9 +149,16 @@ void
 BikeUser::setUserId(
     QString aUserName)
 {
+    BikeTrace::Span span("BikeUser::setUserId");
+    const bool newUser = !aUserName.isEmpty() &&
+        !Private::rootDir().exists(aUserName);
+
     if (iPrivate->setUserName(aUserName)) {
         Q_EMIT userIdChanged();
         Q_EMIT dataDirChanged();
+        if (newUser) {
+            Q_EMIT userIdsChanged();
+        }
     }
 }
 
@@ -120,3 +167,64 @@ BikeUser::dataDir() const
 {
     return iPrivate->iDataDir;
 }
+
+QString
+BikeUser::lastUserId() const
+{
+    const QString userId(Private::readLine(Private::rootDir().
+        filePath(Private::LAST_USER_FILE)));
+
+    return userId.isEmpty() ? QStringLiteral("0000") : userId;
+}
+
+QStringList
+BikeUser::userIds() const
+{
+    return Private::rootDir().entryList(QDir::Dirs | QDir::NoDotAndDotDot,
+        QDir::Name);
+}
+
+QString
+BikeUser::addUser()
+{
+    const QDir root(Private::rootDir());
+    QString userId;
+
+    // Pick the first unused number
+    for (int i = 0; userId.isEmpty() || root.exists(userId); i++) {
+        userId = QString(QStringLiteral("%1")).arg(i, 4, 10, QChar('0'));
+    }
+    if (root.mkpath(userId)) {
+        HDEBUG(userId);
+        Q_EMIT userIdsChanged();
+        return userId;
+    }
+    HWARN("Failed to create" << qPrintable(root.filePath(userId)));
+    return QString();
+}
+
+bool
+BikeUser::removeUser(
+    QString aUserName)
+{
+    // The current account can't be removed
+    if (!aUserName.isEmpty() && aUserName != iPrivate->iUserName) {
+        QDir dir(Private::rootDir().filePath(aUserName));
+
+        if (dir.exists() && dir.removeRecursively()) {
+            HDEBUG(aUserName);
+            Q_EMIT userIdsChanged();
+            return true;
+        }
+    }
+    return false;
+}
+
+QString
+BikeUser::login(
+    QString aUserName) const
+{
+    return aUserName.isEmpty() ? QString() :
+        Private::readLine(Private::rootDir().filePath(aUserName).
+            append(QDir::separator()).append(BIKE_LOGIN_FILE));
+}
@@ -41,6 +41,9 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
+
+// Each account has its own data directory, named after the user id.
 
 class BikeUser :
     public QObject
@@ -48,6 +51,8 @@ class BikeUser :
     Q_OBJECT
     Q_PROPERTY(QString userId READ userId WRITE setUserId NOTIFY userIdChanged)
     Q_PROPERTY(QString dataDir READ dataDir NOTIFY dataDirChanged)
+    Q_PROPERTY(QString lastUserId READ lastUserId CONSTANT)
+    Q_PROPERTY(QStringList userIds READ userIds NOTIFY userIdsChanged)
 
 public:
     explicit BikeUser(QObject* aParent = Q_NULLPTR);
@@ -57,10 +62,17 @@ public:
     void setUserId(QString);
 
     QString dataDir() const;
+    QString lastUserId() const;
+    QStringList userIds() const;
+
+    Q_INVOKABLE QString addUser();
+    Q_INVOKABLE bool removeUser(QString);
+    Q_INVOKABLE QString login(QString) const;
 
 Q_SIGNALS:
     void userIdChanged();
     void dataDirChanged();
+    void userIdsChanged();
 
 private:
     class Private;
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2025 Slava Monich <slava@monich.com>
+ * Copyright (C) 2025-2026 Slava Monich <slava@monich.com>
  *
  * You may use this file under the terms of the BSD license as follows:
  *
@@ -37,9 +37,235 @@
  */
 
 #include "Fillari.h"
+#include "BikeAxisModel.h"
+#include "BikeRideStore.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
 
 #include "HarbourDebug.h"
 
+#include <algorithm>
+
+// ==========================================================================
+// Fillari::Formatter
+//
+// Translated templates are looked up once and split around the
+// placeholders, so that formatting a value is a matter of copying
+// the pieces into a preallocated string.
+// ==========================================================================
+
+class Fillari::Formatter
+{
+public:
+    // Small formatted number (up to "-2147483648.9")
+    struct Number {
+        Number(int);
+        Number(int, int);
+
+        char iBuf[16];
+        int iLen;
+    };
+
+    class Template {
+    public:
+        Template(const QString&);
+
+        QString format(const Number&) const;
+        QString format(const Number&, const Number&) const;
+
+    private:
+        QString format(const Number* const*) const;
+
+    private:
+        QStringList iParts;     // One more than the placeholders
+        QVector<int> iArgs;     // Zero-based placeholder indices
+    };
+
+    Formatter();
+
+    static const Formatter* instance();
+    QString format(int, BikeHistoryStats::Mode) const;
+
+public:
+    const Template iMeters;
+    const Template iKilometers;
+    const Template iSeconds;
+    const Template iMinutes;
+    const Template iHoursMinutes;
+    const Template iHours;
+};
+
+Fillari::Formatter::Number::Number(
+    int aValue)
+{
+    char tmp[12];
+    uint n = (aValue < 0) ? (0u - uint(aValue)) : uint(aValue);
+    int i = 0;
+
+    do {
+        tmp[i++] = char('0' + (n % 10));
+        n /= 10;
+    } while (n);
+    iLen = 0;
+    if (aValue < 0) {
+        iBuf[iLen++] = '-';
+    }
+    while (i > 0) {
+        iBuf[iLen++] = tmp[--i];
+    }
+}
+
+Fillari::Formatter::Number::Number(
+    int aWhole,
+    int aTenths) :
+    Number(aWhole)
+{
+    iBuf[iLen++] = '.';
+    iBuf[iLen++] = char('0' + aTenths);
+}
+
+Fillari::Formatter::Template::Template(
+    const QString& aText)
+{
+    // Only %1 and %2 are expected, in any order
+    const int n = aText.length();
+    int start = 0;
+
+    for (int i = 0; i + 1 < n; i++) {
+        if (aText.at(i) == QChar('%')) {
+            const QChar c(aText.at(i + 1));
+
+            if (c == QChar('1') || c == QChar('2')) {
+                iParts.append(aText.mid(start, i - start));
+                iArgs.append(c.unicode() - '1');
+                start = i + 2;
+                i++;
+            }
+        }
+    }
+    iParts.append(aText.mid(start));
+}
+
+QString
+Fillari::Formatter::Template::format(
+    const Number* const* aArgs) const
+{
+    const int n = iArgs.count();
+    int len = iParts.last().length();
+
+    for (int i = 0; i < n; i++) {
+        len += iParts.at(i).length() + aArgs[iArgs.at(i)]->iLen;
+    }
+
+    // The only allocation
+    QString str(len, Qt::Uninitialized);
+    QChar* out = str.data();
+
+    for (int i = 0; i < n; i++) {
+        const QString& part = iParts.at(i);
+        const Number* arg = aArgs[iArgs.at(i)];
+
+        memcpy(out, part.constData(), part.length() * sizeof(QChar));
+        out += part.length();
+        for (int k = 0; k < arg->iLen; k++) {
+            *out++ = QLatin1Char(arg->iBuf[k]);
+        }
+    }
+
+    const QString& last = iParts.last();
+    memcpy(out, last.constData(), last.length() * sizeof(QChar));
+    return str;
+}
+
+QString
+Fillari::Formatter::Template::format(
+    const Number& aArg) const
+{
+    const Number* args[2] = { &aArg, &aArg };
+
+    return format(args);
+}
+
+QString
+Fillari::Formatter::Template::format(
+    const Number& aArg1,
+    const Number& aArg2) const
+{
+    const Number* args[2] = { &aArg1, &aArg2 };
+
+    return format(args);
+}
+
+Fillari::Formatter::Formatter() :
+    //: Distance, meters (shortened)
+    //% "%1 m"
+    iMeters(qtTrId("fillari-distance-m")),
+    //: Distance, kilometers (shortened)
+    //% "%1 km"
+    iKilometers(qtTrId("fillari-distance-km")),
+    //: Duration, seconds (shortened)
+    //% "%1 sec"
+    iSeconds(qtTrId("fillari-duration-sec")),
+    //: Duration, minutes (shortened)
+    //% "%1 min"
+    iMinutes(qtTrId("fillari-duration-min")),
+    //: Duration, hours + minutes (shortened)
+    //% "%1 h %2 min"
+    iHoursMinutes(qtTrId("fillari-duration-h_min")),
+    //: Duration, hours(shortened)
+    //% "%1 h"
+    iHours(qtTrId("fillari-duration-h"))
+{}
+
+// static
+const Fillari::Formatter*
+Fillari::Formatter::instance()
+{
+    // Translators are installed before anything gets formatted
+    static const Formatter formatter;
+
+    return &formatter;
+}
+
+QString
+Fillari::Formatter::format(
+    int aValue,
+    BikeHistoryStats::Mode aMode) const
+{
+    switch (aMode) {
+    case BikeHistoryStats::Rides:
+        return QString::number(aValue);
+    case BikeHistoryStats::Distance:
+        if (aValue < 1000) {
+            return iMeters.format(Number(aValue));
+        } else {
+            // Round to 100 meters
+            const int hm = (aValue + 50) / 100;
+
+            return (aValue % 1000) ?
+                iKilometers.format(Number(hm / 10, hm % 10)) :
+                iKilometers.format(Number(aValue / 1000));
+        }
+    case BikeHistoryStats::Duration:
+        return (aValue < 60) ?
+            iSeconds.format(Number(aValue)) :
+            (aValue < 3600) ?
+            iMinutes.format(Number(aValue / 60)) :
+            (aValue % 3600) ?
+            iHoursMinutes.format(Number(aValue / 3600),
+                Number((aValue % 3600) / 60)) :
+            iHours.format(Number(aValue / 3600));
+    }
+    return QString();
+}
+
+// ==========================================================================
+// Fillari
+// ==========================================================================
+
 Fillari::Fillari(
     QObject* aParent) :
     QObject(aParent)
@@ -60,37 +286,24 @@ Fillari::format(
     int aValue,
     BikeHistoryStats::Mode aMode)
 {
-    switch (aMode) {
-    case BikeHistoryStats::Rides:
-        return QString::number(aValue);
-    case BikeHistoryStats::Distance:
-        return (aValue < 1000) ?
-            //: Distance, meters (shortened)
-            //% "%1 m"
-            qtTrId("fillari-distance-m").arg(aValue) :
-            (aValue % 1000)?
-            //: Distance, kilometers (shortened)
-            //% "%1 km"
-            qtTrId("fillari-distance-km").arg(aValue/1000.f, 0, 'f', 1) :
-            qtTrId("fillari-distance-km").arg(aValue/1000);
-    case BikeHistoryStats::Duration:
-        return (aValue < 60) ?
-            //: Duration, seconds (shortened)
-            //% "%1 sec"
-            qtTrId("fillari-duration-sec").arg(aValue) :
-            (aValue < 3600) ?
-            //: Duration, minutes (shortened)
-            //% "%1 min"
-            qtTrId("fillari-duration-min").arg(aValue/60) :
-            (aValue % 3600) ?
-            //: Duration, hours + minutes (shortened)
-            //% "%1 h %2 min"
-            qtTrId("fillari-duration-h_min").arg(aValue/3600).arg((aValue % 3600)/60) :
-            //: Duration, hours(shortened)
-            //% "%1 h"
-            qtTrId("fillari-duration-h").arg(aValue/3600);
+    return Formatter::instance()->format(aValue, aMode);
+}
+
+// static
+QStringList
+Fillari::format(
+    const QVector<int>& aValues,
+    BikeHistoryStats::Mode aMode)
+{
+    const Formatter* formatter = Formatter::instance();
+    const int n = aValues.count();
+    QStringList list;
+
+    list.reserve(n);
+    for (int i = 0; i < n; i++) {
+        list.append(formatter->format(aValues.at(i), aMode));
     }
-    return QString();
+    return list;
 }
 
 // static
@@ -100,41 +313,62 @@ Fillari::step(
     int aMaxSteps,
     BikeHistoryStats::Mode aMode)
 {
+    return BikeAxisModel::step(aMaxValue, aMaxSteps, aMode);
+}
+
+// static
+QList<int>
+Fillari::years(
+    const QJsonArray& aHistory)
+{
+    QList<int> years;
+    const uint n = aHistory.size();
+
+    for (uint i = 0; i < n; i++) {
+        const QJsonObject entry(aHistory.at(i).toObject());
+        const QString isoDate(entry.value(QStringLiteral("departureDate")).toString());
+        const QDate date(QDateTime::fromString(isoDate, Qt::ISODate).date());
 
-    if (aMaxSteps) {
-        static const QVector<int> rideSteps{1, 5, 10, 50, 100};
-        static const QVector<int> distanceSteps{1, 10, 100, 500,
-            1000, 5000, 10000, 50000, 100000};
-        static const QVector<int> durationSteps{1, 5, 60, 5*60, 10*60, 60*60};
-        const QVector<int>* steps = Q_NULLPTR;
-        switch (aMode) {
-        case BikeHistoryStats::Rides:
-            steps = &rideSteps;
-            break;
-        case BikeHistoryStats::Distance:
-            steps = &distanceSteps;
-            break;
-        case BikeHistoryStats::Duration:
-            steps = &durationSteps;
-            break;
+        if (date.isValid()) {
+            const int year = date.year();
+
+            if (!years.contains(year)) {
+                years.insert(0, year);
+            }
         }
+    }
+    std::sort(years.begin(), years.end());
+    return years;
+}
 
-        if (steps) {
-            int i = steps->count() - 1;
+// static
+QList<int>
+Fillari::years(
+    const BikeRideStore& aStore)
+{
+    // Rides are sorted, only the years in between need to be checked
+    QList<int> years;
+    const int n = aStore.count();
+    const BikeRideStore::Ride* current = aStore.inProgress();
 
-            while (i > 0 && steps->at(i) * aMaxSteps > aMaxValue) i--;
+    if (n > 0) {
+        const int last = aStore.at(n - 1).date().year();
 
-            if (steps->at(i) <= aMaxValue) {
-                const int d = steps->at(i);
-                int s = d;
+        for (int year = aStore.at(0).date().year(); year <= last; year++) {
+            const BikeRideStore::Range range(aStore.yearRange(year));
 
-                while (aMaxValue / s >  aMaxSteps) s += d;
-                HDEBUG(aMaxValue << aMaxSteps << aMode << "=>" << s);
-                return s;
+            if (range.iEnd > range.iFirst) {
+                years.append(year);
             }
         }
     }
+    if (current) {
+        const int year = current->date().year();
 
-    return 0;
+        if (!years.contains(year)) {
+            years.append(year);
+            std::sort(years.begin(), years.end());
+        }
+    }
+    return years;
 }
-
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2025 Slava Monich <slava@monich.com>
+ * Copyright (C) 2025-2026 Slava Monich <slava@monich.com>
  *
  * You may use this file under the terms of the BSD license as follows:
  *
@@ -41,6 +41,7 @@
 
 #include "BikeHistoryStats.h"
 
+class BikeRideStore;
 class QQmlEngine;
 class QJSEngine;
 
@@ -57,6 +58,13 @@ public:
 
     Q_INVOKABLE static QString format(int, BikeHistoryStats::Mode);
     Q_INVOKABLE static int step(int, int, BikeHistoryStats::Mode);
+
+    static QStringList format(const QVector<int>&, BikeHistoryStats::Mode);
+    static QList<int> years(const QJsonArray&);
+    static QList<int> years(const BikeRideStore&);
+
+private:
+    class Formatter;
 };
 
 #endif // FILLARI_H
@@ -0,0 +1,568 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#include "HistogramItem.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QVector>
+#include <QtCore/qmath.h>
+
+#include <QtQuick/QQuickWindow>
+#include <QtQuick/QSGGeometryNode>
+#include <QtQuick/QSGVertexColorMaterial>
+
+#include "HarbourDebug.h"
+
+// ==========================================================================
+// HistogramItem::Node
+//
+// Lives on the render thread. The bars are triangles in a single vertex
+// buffer, each bar is a rectangle with a half-ellipse on top of it. The
+// sides and the cap are surrounded by a one pixel wide antialiasing
+// fringe, with alpha going down to zero on the outer edge (that's what
+// QSGDefaultRectangleNode does too).
+// ==========================================================================
+
+class HistogramItem::Node :
+    public QSGGeometryNode
+{
+public:
+    static const int CAP_SEGMENTS = 12;
+    static const int FRINGE_SEGMENTS = CAP_SEGMENTS + 2;
+    static const int VERTICES_PER_BAR = 6 + 3 * CAP_SEGMENTS +
+        6 * FRINGE_SEGMENTS;
+    static const int ANIMATION_DURATION = 250; // ms
+
+    Node();
+
+    void setColor(const QColor&);
+    void setLayout(const QSizeF&, qreal, qreal, qreal);
+    void setValues(const QVector<qreal>&);
+    void preprocess() Q_DECL_OVERRIDE;
+
+private:
+    void updateGeometry();
+
+public:
+    QQuickWindow* iWindow;
+
+private:
+    QSGGeometry iGeometry;
+    QSGVertexColorMaterial iMaterial;
+    QColor iColor;
+    QElapsedTimer iAnimationTimer;
+    QVector<qreal> iFrom;
+    QVector<qreal> iTo;
+    QVector<qreal> iCurrent;
+    QSizeF iSize;
+    qreal iDelegateWidth;
+    qreal iBarWidth;
+    qreal iSpacing;
+    bool iGeometryDirty;
+};
+
+HistogramItem::Node::Node() :
+    iWindow(Q_NULLPTR),
+    iGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0),
+    iDelegateWidth(0),
+    iBarWidth(0),
+    iSpacing(0),
+    iGeometryDirty(true)
+{
+    iGeometry.setDrawingMode(GL_TRIANGLES);
+    setGeometry(&iGeometry);
+    setMaterial(&iMaterial);
+    setFlag(UsePreprocess);
+}
+
+void
+HistogramItem::Node::setColor(
+    const QColor& aColor)
+{
+    // The color is stored in the vertices
+    if (iColor != aColor) {
+        iColor = aColor;
+        iGeometryDirty = true;
+    }
+}
+
+void
+HistogramItem::Node::setLayout(
+    const QSizeF& aSize,
+    qreal aDelegateWidth,
+    qreal aBarWidth,
+    qreal aSpacing)
+{
+    if (iSize != aSize ||
+        iDelegateWidth != aDelegateWidth ||
+        iBarWidth != aBarWidth ||
+        iSpacing != aSpacing) {
+        iSize = aSize;
+        iDelegateWidth = aDelegateWidth;
+        iBarWidth = aBarWidth;
+        iSpacing = aSpacing;
+        iGeometryDirty = true;
+    }
+}
+
+void
+HistogramItem::Node::setValues(
+    const QVector<qreal>& aValues)
+{
+    if (iCurrent.count() != aValues.count()) {
+        // Different set of bars, nothing to animate
+        iFrom = iTo = iCurrent = aValues;
+        iAnimationTimer.invalidate();
+        iGeometryDirty = true;
+    } else if (iTo != aValues) {
+        // Start from wherever we are now
+        iFrom = iCurrent;
+        iTo = aValues;
+        iAnimationTimer.start();
+    }
+}
+
+void
+HistogramItem::Node::preprocess()
+{
+    if (iAnimationTimer.isValid()) {
+        const qint64 ms = iAnimationTimer.elapsed();
+
+        if (ms < ANIMATION_DURATION) {
+            // Quadratic ease out
+            const qreal t = qreal(ms) / ANIMATION_DURATION;
+            const qreal k = t * (2 - t);
+            const int n = iCurrent.count();
+
+            for (int i = 0; i < n; i++) {
+                iCurrent[i] = iFrom.at(i) + (iTo.at(i) - iFrom.at(i)) * k;
+            }
+
+            // Request the next frame. This is fine to do from the render
+            // thread, the render loop takes care of that.
+            if (iWindow) {
+                iWindow->update();
+            }
+        } else {
+            iCurrent = iTo;
+            iAnimationTimer.invalidate();
+        }
+        iGeometryDirty = true;
+    }
+    if (iGeometryDirty) {
+        iGeometryDirty = false;
+        updateGeometry();
+    }
+}
+
+void
+HistogramItem::Node::updateGeometry()
+{
+    const int n = iCurrent.count();
+    const qreal h = iSize.height();
+    const qreal r = iBarWidth / 2;
+    int bars = 0;
+
+    // QSGVertexColorMaterial wants premultiplied colors
+    const int a = iColor.alpha();
+    const uchar cr = uchar(iColor.red() * a / 255);
+    const uchar cg = uchar(iColor.green() * a / 255);
+    const uchar cb = uchar(iColor.blue() * a / 255);
+    const uchar ca = uchar(a);
+
+    for (int i = 0; i < n && r > 0; i++) {
+        if (iCurrent.at(i) > 0) {
+            bars++;
+        }
+    }
+
+    iGeometry.allocate(bars * VERTICES_PER_BAR);
+    QSGGeometry::ColoredPoint2D* v = iGeometry.vertexDataAsColoredPoint2D();
+    for (int i = 0; i < n && r > 0; i++) {
+        const qreal barHeight = iCurrent.at(i) * h;
+
+        if (barHeight > 0) {
+            const qreal x1 = i * (iDelegateWidth + iSpacing) +
+                (iDelegateWidth - iBarWidth) / 2;
+            const qreal x2 = x1 + iBarWidth;
+            const qreal cx = x1 + r;
+            const qreal ry = qMin(r, barHeight);
+            const qreal y = h - barHeight + ry;
+
+            // The rectangle (may be empty if the bar is really short)
+            v[0].set(x1, y, cr, cg, cb, ca);
+            v[1].set(x2, y, cr, cg, cb, ca);
+            v[2].set(x1, h, cr, cg, cb, ca);
+            v[3].set(x2, y, cr, cg, cb, ca);
+            v[4].set(x2, h, cr, cg, cb, ca);
+            v[5].set(x1, h, cr, cg, cb, ca);
+            v += 6;
+
+            // The cap
+            for (int k = 0; k < CAP_SEGMENTS; k++) {
+                const qreal a1 = M_PI * k / CAP_SEGMENTS;
+                const qreal a2 = M_PI * (k + 1) / CAP_SEGMENTS;
+
+                v[0].set(cx, y, cr, cg, cb, ca);
+                v[1].set(cx - r * qCos(a1), y - ry * qSin(a1),
+                    cr, cg, cb, ca);
+                v[2].set(cx - r * qCos(a2), y - ry * qSin(a2),
+                    cr, cg, cb, ca);
+                v += 3;
+            }
+
+            // The fringe goes up the left side, over the cap and down
+            // the right side. Normals of the ellipse are computed
+            // analytically, the sides are tangent to the cap.
+            QPointF p[FRINGE_SEGMENTS + 1];
+            QPointF d[FRINGE_SEGMENTS + 1];
+
+            p[0] = QPointF(x1, h);
+            d[0] = QPointF(-0.5, 0);
+            for (int k = 0; k <= CAP_SEGMENTS; k++) {
+                const qreal ak = M_PI * k / CAP_SEGMENTS;
+                const qreal nx = -qCos(ak) / r;
+                const qreal ny = -qSin(ak) / ry;
+                const qreal len = qSqrt(nx * nx + ny * ny);
+
+                p[k + 1] = QPointF(cx - r * qCos(ak), y - ry * qSin(ak));
+                d[k + 1] = QPointF(nx, ny) * (0.5 / len);
+            }
+            p[FRINGE_SEGMENTS] = QPointF(x2, h);
+            d[FRINGE_SEGMENTS] = QPointF(0.5, 0);
+
+            for (int k = 0; k < FRINGE_SEGMENTS; k++) {
+                const QPointF in1(p[k] - d[k]);
+                const QPointF out1(p[k] + d[k]);
+                const QPointF in2(p[k + 1] - d[k + 1]);
+                const QPointF out2(p[k + 1] + d[k + 1]);
+
+                v[0].set(in1.x(), in1.y(), cr, cg, cb, ca);
+                v[1].set(out1.x(), out1.y(), 0, 0, 0, 0);
+                v[2].set(in2.x(), in2.y(), cr, cg, cb, ca);
+                v[3].set(out1.x(), out1.y(), 0, 0, 0, 0);
+                v[4].set(out2.x(), out2.y(), 0, 0, 0, 0);
+                v[5].set(in2.x(), in2.y(), cr, cg, cb, ca);
+                v += 6;
+            }
+        }
+    }
+    markDirty(DirtyGeometry);
+}
+
+// ==========================================================================
+// HistogramItem::Private
+// ==========================================================================
+
+class HistogramItem::Private :
+    public QObject
+{
+    Q_OBJECT
+
+public:
+    Private(HistogramItem*);
+
+    HistogramItem* parentItem();
+    void setModel(BikeHistoryStats*);
+    void updateDelegateWidth();
+
+public Q_SLOTS:
+    void updateValues();
+    void onModelDestroyed();
+
+public:
+    BikeHistoryStats* iModel;
+    int iValueRole;
+    QColor iColor;
+    qreal iBarWidth;
+    qreal iSpacing;
+    qreal iDelegateWidth;
+    QVector<qreal> iValues; // Relative to the max value
+};
+
+HistogramItem::Private::Private(
+    HistogramItem* aParent) :
+    QObject(aParent),
+    iModel(Q_NULLPTR),
+    iValueRole(-1),
+    iColor(Qt::white),
+    iBarWidth(0),
+    iSpacing(0),
+    iDelegateWidth(0)
+{}
+
+inline
+HistogramItem*
+HistogramItem::Private::parentItem()
+{
+    return qobject_cast<HistogramItem*>(parent());
+}
+
+void
+HistogramItem::Private::setModel(
+    BikeHistoryStats* aModel)
+{
+    if (iModel) {
+        iModel->disconnect(this);
+    }
+    iModel = aModel;
+    iValueRole = -1;
+    if (aModel) {
+        iValueRole = aModel->roleNames().key("value", -1);
+        connect(aModel, SIGNAL(modelReset()), SLOT(updateValues()));
+        connect(aModel, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)),
+            SLOT(updateValues()));
+        connect(aModel, SIGNAL(rowsInserted(QModelIndex,int,int)),
+            SLOT(updateValues()));
+        connect(aModel, SIGNAL(rowsRemoved(QModelIndex,int,int)),
+            SLOT(updateValues()));
+        connect(aModel, SIGNAL(maxValueChanged()), SLOT(updateValues()));
+        connect(aModel, SIGNAL(destroyed(QObject*)), SLOT(onModelDestroyed()));
+    }
+    updateValues();
+}
+
+void
+HistogramItem::Private::onModelDestroyed()
+{
+    iModel = Q_NULLPTR;
+    updateValues();
+}
+
+void
+HistogramItem::Private::updateValues()
+{
+    // Take the snapshot of the model on the main thread, the render
+    // thread is not supposed to touch the model
+    const int n = iModel ? iModel->rowCount(QModelIndex()) : 0;
+    const int maxValue = iModel ? iModel->maxValue() : 0;
+    QVector<qreal> values;
+
+    values.reserve(n);
+    for (int i = 0; i < n; i++) {
+        const int value = maxValue > 0 ?
+            iModel->data(iModel->index(i), iValueRole).toInt() : 0;
+
+        values.append(maxValue > 0 ? qBound(qreal(0),
+            qreal(value) / maxValue, qreal(1)) : 0);
+    }
+
+    if (iValues != values) {
+        HistogramItem* item = parentItem();
+        const bool countChanged = (iValues.count() != n);
+
+        iValues = values;
+        if (countChanged) {
+            HDEBUG(n << "bar(s)");
+            updateDelegateWidth();
+            Q_EMIT item->countChanged();
+        }
+        item->update();
+    }
+}
+
+void
+HistogramItem::Private::updateDelegateWidth()
+{
+    // Same as in a Row of the same width with n items
+    HistogramItem* item = parentItem();
+    const int n = iValues.count();
+    const qreal delegateWidth = n ?
+        qMax(qFloor((item->width() + iSpacing) / n - iSpacing), 0) : 0;
+
+    if (iDelegateWidth != delegateWidth) {
+        iDelegateWidth = delegateWidth;
+        Q_EMIT item->delegateWidthChanged();
+    }
+}
+
+// ==========================================================================
+// HistogramItem
+// ==========================================================================
+
+HistogramItem::HistogramItem(
+    QQuickItem* aParent) :
+    QQuickItem(aParent),
+    iPrivate(new Private(this))
+{
+    setFlag(ItemHasContents);
+}
+
+HistogramItem::~HistogramItem()
+{
+    delete iPrivate;
+}
+
+BikeHistoryStats*
+HistogramItem::model() const
+{
+    return iPrivate->iModel;
+}
+
+void
+HistogramItem::setModel(
+    BikeHistoryStats* aModel)
+{
+    if (iPrivate->iModel != aModel) {
+        iPrivate->setModel(aModel);
+        Q_EMIT modelChanged();
+    }
+}
+
+QColor
+HistogramItem::color() const
+{
+    return iPrivate->iColor;
+}
+
+void
+HistogramItem::setColor(
+    const QColor& aColor)
+{
+    const QColor rgb(aColor.toRgb());
+
+    if (iPrivate->iColor.toRgb() != rgb) {
+        iPrivate->iColor = rgb;
+        HDEBUG(rgb);
+        Q_EMIT colorChanged();
+        update();
+    }
+}
+
+qreal
+HistogramItem::barWidth() const
+{
+    return iPrivate->iBarWidth;
+}
+
+void
+HistogramItem::setBarWidth(
+    qreal aWidth)
+{
+    if (iPrivate->iBarWidth != aWidth) {
+        iPrivate->iBarWidth = aWidth;
+        HDEBUG(aWidth);
+        Q_EMIT barWidthChanged();
+        update();
+    }
+}
+
+qreal
+HistogramItem::spacing() const
+{
+    return iPrivate->iSpacing;
+}
+
+void
+HistogramItem::setSpacing(
+    qreal aSpacing)
+{
+    if (iPrivate->iSpacing != aSpacing) {
+        iPrivate->iSpacing = aSpacing;
+        HDEBUG(aSpacing);
+        iPrivate->updateDelegateWidth();
+        Q_EMIT spacingChanged();
+        update();
+    }
+}
+
+int
+HistogramItem::count() const
+{
+    return iPrivate->iValues.count();
+}
+
+qreal
+HistogramItem::delegateWidth() const
+{
+    return iPrivate->iDelegateWidth;
+}
+
+int
+HistogramItem::indexAt(
+    qreal aX) const
+{
+    const qreal step = iPrivate->iDelegateWidth + iPrivate->iSpacing;
+
+    if (step > 0 && aX >= 0) {
+        const int i = qFloor(aX / step);
+
+        if (i < iPrivate->iValues.count() &&
+            (aX - i * step) < iPrivate->iDelegateWidth) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void
+HistogramItem::geometryChanged(
+    const QRectF& aNewGeometry,
+    const QRectF& aOldGeometry)
+{
+    QQuickItem::geometryChanged(aNewGeometry, aOldGeometry);
+    if (aNewGeometry.size() != aOldGeometry.size()) {
+        iPrivate->updateDelegateWidth();
+        update();
+    }
+}
+
+QSGNode*
+HistogramItem::updatePaintNode(
+    QSGNode* aNode,
+    UpdatePaintNodeData*)
+{
+    Node* node = static_cast<Node*>(aNode);
+
+    if (iPrivate->iValues.isEmpty() || width() <= 0 || height() <= 0) {
+        delete node;
+        return Q_NULLPTR;
+    }
+
+    if (!node) {
+        node = new Node;
+    }
+    node->iWindow = window();
+    node->setColor(iPrivate->iColor);
+    node->setLayout(QSizeF(width(), height()), iPrivate->iDelegateWidth, iPrivate->iBarWidth,
+        iPrivate->iSpacing);
+    node->setValues(iPrivate->iValues);
+    return node;
+}
+
+#include "HistogramItem.moc"
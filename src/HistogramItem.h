@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Slava Monich <slava@monich.com>
+ *
+ * You may use this file under the terms of the BSD license as follows:
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer
+ *     in the documentation and/or other materials provided with the
+ *     distribution.
+ *
+ *  3. Neither the names of the copyright holders nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The views and conclusions contained in the software and documentation
+ * are those of the authors and should not be interpreted as representing
+ * any official policies, either expressed or implied.
+ */
+
+#ifndef HISTOGRAM_ITEM_H
+#define HISTOGRAM_ITEM_H
+
+#include "BikeHistoryStats.h"
+
+#include <QtQuick/QQuickItem>
+
+// All bars are drawn by a single scene graph node, height changes
+// are animated on the render thread.
+
+class HistogramItem :
+    public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(BikeHistoryStats* model READ model WRITE setModel NOTIFY modelChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(qreal barWidth READ barWidth WRITE setBarWidth NOTIFY barWidthChanged)
+    Q_PROPERTY(qreal spacing READ spacing WRITE setSpacing NOTIFY spacingChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(qreal delegateWidth READ delegateWidth NOTIFY delegateWidthChanged)
+
+public:
+    explicit HistogramItem(QQuickItem* aParent = Q_NULLPTR);
+    ~HistogramItem() Q_DECL_OVERRIDE;
+
+    BikeHistoryStats* model() const;
+    void setModel(BikeHistoryStats*);
+
+    QColor color() const;
+    void setColor(const QColor&);
+
+    qreal barWidth() const;
+    void setBarWidth(qreal);
+
+    qreal spacing() const;
+    void setSpacing(qreal);
+
+    int count() const;
+    qreal delegateWidth() const;
+
+    Q_INVOKABLE int indexAt(qreal) const;
+
+protected:
+    QSGNode* updatePaintNode(QSGNode*, UpdatePaintNodeData*) Q_DECL_OVERRIDE;
+    void geometryChanged(const QRectF&, const QRectF&) Q_DECL_OVERRIDE;
+
+Q_SIGNALS:
+    void modelChanged();
+    void colorChanged();
+    void barWidthChanged();
+    void spacingChanged();
+    void countChanged();
+    void delegateWidthChanged();
+
+private:
+    class Node;
+    class Private;
+    Private* iPrivate;
+};
+
+#endif // HISTOGRAM_ITEM_H
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2025 Slava Monich <slava@monich.com>
+ * Copyright (C) 2025-2026 Slava Monich <slava@monich.com>
  *
  * You may use this file under the terms of the BSD license as follows:
  *
@@ -38,13 +38,220 @@
 
 #include "ToolTipItem.h"
 
-#include <QtGui/QBrush>
-#include <QtGui/QPainter>
-#include <QtGui/QPainterPath>
-#include <QtGui/QPen>
+#include <QtCore/QVector>
+#include <QtCore/qmath.h>
+
+#include <QtQuick/QSGGeometryNode>
+#include <QtQuick/QSGVertexColorMaterial>
 
 #include "HarbourDebug.h"
 
+// ==========================================================================
+// ToolTipItem::Node
+//
+// The outline is tessellated only when the shape changes. Color changes
+// only touch the vertex colors. The edges of the border are antialiased
+// by one pixel wide fringes, with alpha going down to zero on the outer
+// side (that's what QSGDefaultRectangleNode does too).
+// ==========================================================================
+
+class ToolTipItem::Node :
+    public QSGNode
+{
+public:
+    Node();
+
+    void setShape(const QVector<QPointF>&, const QPointF&, qreal);
+    void setColors(const QColor&, const QColor&);
+
+private:
+    static QSGGeometryNode* newGeometryNode(GLenum);
+    static void setColor(QSGGeometryNode*, const QColor&, bool aFade = false);
+    static void setStrip(QSGGeometryNode*, const QVector<QPointF>&,
+        const QVector<QPointF>&, qreal, qreal);
+    void updateColors();
+
+public:
+    QSGGeometryNode* iFill;
+    QSGGeometryNode* iBorder;
+    QSGGeometryNode* iInnerFringe;
+    QSGGeometryNode* iOuterFringe;
+    QColor iBackgroundColor;
+    QColor iBorderColor;
+    bool iHaveBorder;
+};
+
+ToolTipItem::Node::Node() :
+    iFill(newGeometryNode(GL_TRIANGLES)),
+    iBorder(newGeometryNode(GL_TRIANGLE_STRIP)),
+    iInnerFringe(newGeometryNode(GL_TRIANGLE_STRIP)),
+    iOuterFringe(newGeometryNode(GL_TRIANGLE_STRIP)),
+    iHaveBorder(false)
+{
+    appendChildNode(iFill);
+    appendChildNode(iBorder);
+    appendChildNode(iInnerFringe);
+    appendChildNode(iOuterFringe);
+}
+
+// static
+QSGGeometryNode*
+ToolTipItem::Node::newGeometryNode(
+    GLenum aMode)
+{
+    QSGGeometryNode* node = new QSGGeometryNode;
+    QSGGeometry* geometry = new QSGGeometry(QSGGeometry::
+        defaultAttributes_ColoredPoint2D(), 0);
+
+    geometry->setDrawingMode(aMode);
+    node->setGeometry(geometry);
+    node->setMaterial(new QSGVertexColorMaterial);
+    node->setFlags(OwnsGeometry | OwnsMaterial);
+    return node;
+}
+
+// static
+void
+ToolTipItem::Node::setColor(
+    QSGGeometryNode* aNode,
+    const QColor& aColor,
+    bool aFade)
+{
+    // QSGVertexColorMaterial wants premultiplied colors. Fading strips
+    // have every other vertex fully transparent.
+    QSGGeometry* geometry = aNode->geometry();
+    const int a = aColor.alpha();
+    const uchar r = uchar(aColor.red() * a / 255);
+    const uchar g = uchar(aColor.green() * a / 255);
+    const uchar b = uchar(aColor.blue() * a / 255);
+    const int n = geometry->vertexCount();
+    QSGGeometry::ColoredPoint2D* v = geometry->vertexDataAsColoredPoint2D();
+
+    for (int i = 0; i < n; i++) {
+        const bool transparent = aFade && (i & 1);
+
+        v[i].r = transparent ? 0 : r;
+        v[i].g = transparent ? 0 : g;
+        v[i].b = transparent ? 0 : b;
+        v[i].a = transparent ? 0 : uchar(a);
+    }
+    aNode->markDirty(DirtyGeometry);
+}
+
+// static
+void
+ToolTipItem::Node::setStrip(
+    QSGGeometryNode* aNode,
+    const QVector<QPointF>& aOutline,
+    const QVector<QPointF>& aMiters,
+    qreal aFrom,
+    qreal aTo)
+{
+    // Closed triangle strip along the outline, between the two offsets
+    // (positive is outside)
+    const int n = aOutline.count();
+    QSGGeometry* geometry = aNode->geometry();
+    geometry->allocate((aFrom != aTo && n > 2) ? (2 * (n + 1)) : 0);
+    QSGGeometry::ColoredPoint2D* v = geometry->vertexDataAsColoredPoint2D();
+    for (int i = 0; i < geometry->vertexCount() / 2; i++) {
+        const QPointF& p = aOutline.at(i % n);
+        const QPointF& m = aMiters.at(i % n);
+
+        v[0].set(p.x() + m.x() * aFrom, p.y() + m.y() * aFrom, 0, 0, 0, 0);
+        v[1].set(p.x() + m.x() * aTo, p.y() + m.y() * aTo, 0, 0, 0, 0);
+        v += 2;
+    }
+}
+
+void
+ToolTipItem::Node::setShape(
+    const QVector<QPointF>& aOutline,
+    const QPointF& aCenter,
+    qreal aBorderWidth)
+{
+    const int n = aOutline.count();
+    QSGGeometry* fill = iFill->geometry();
+
+    // Fill is a triangle fan around the center (the shape is star-shaped
+    // relative to it), written as a list of triangles
+    fill->allocate(3 * n);
+    QSGGeometry::ColoredPoint2D* f = fill->vertexDataAsColoredPoint2D();
+    for (int i = 0; i < n; i++) {
+        const QPointF& p1 = aOutline.at(i);
+        const QPointF& p2 = aOutline.at((i + 1) % n);
+
+        f[0].set(aCenter.x(), aCenter.y(), 0, 0, 0, 0);
+        f[1].set(p1.x(), p1.y(), 0, 0, 0, 0);
+        f[2].set(p2.x(), p2.y(), 0, 0, 0, 0);
+        f += 3;
+    }
+
+    // Right hand normals point outside if the (signed) area is positive
+    qreal area = 0;
+    for (int i = 0; i < n; i++) {
+        const QPointF& p1 = aOutline.at(i);
+        const QPointF& p2 = aOutline.at((i + 1) % n);
+
+        area += p1.x() * p2.y() - p2.x() * p1.y();
+    }
+
+    // Miter vectors (offset by one unit) at the joints
+    const qreal outside = (area < 0) ? -1 : 1;
+    QVector<QPointF> miters;
+    miters.reserve(n);
+    for (int i = 0; i < n && n > 2; i++) {
+        const QPointF& p0 = aOutline.at((i + n - 1) % n);
+        const QPointF& p1 = aOutline.at(i);
+        const QPointF& p2 = aOutline.at((i + 1) % n);
+        const QPointF d1(p1 - p0);
+        const QPointF d2(p2 - p1);
+        const qreal l1 = qSqrt(QPointF::dotProduct(d1, d1));
+        const qreal l2 = qSqrt(QPointF::dotProduct(d2, d2));
+        const QPointF n1(d1.y() / l1, -d1.x() / l1);
+        const QPointF n2(d2.y() / l2, -d2.x() / l2);
+        const QPointF m(n1 + n2);
+
+        miters.append(m * (outside / QPointF::dotProduct(m, n1)));
+    }
+
+    // Border is centered on the outline. Without the border, the fill
+    // gets the fringe.
+    const qreal w2 = qMax(aBorderWidth, qreal(0)) / 2;
+
+    iHaveBorder = (w2 > 0);
+    setStrip(iBorder, aOutline, miters, w2, -w2);
+    setStrip(iOuterFringe, aOutline, miters, w2 - 0.5, w2 + 0.5);
+    if (iHaveBorder) {
+        setStrip(iInnerFringe, aOutline, miters, 0.5 - w2, -0.5 - w2);
+    } else {
+        iInnerFringe->geometry()->allocate(0);
+    }
+    updateColors();
+}
+
+void
+ToolTipItem::Node::updateColors()
+{
+    setColor(iFill, iBackgroundColor);
+    setColor(iBorder, iBorderColor);
+    setColor(iInnerFringe, iBorderColor, true);
+    setColor(iOuterFringe, iHaveBorder ? iBorderColor : iBackgroundColor,
+        true);
+}
+
+void
+ToolTipItem::Node::setColors(
+    const QColor& aBackgroundColor,
+    const QColor& aBorderColor)
+{
+    if (iBackgroundColor != aBackgroundColor ||
+        iBorderColor != aBorderColor) {
+        iBackgroundColor = aBackgroundColor;
+        iBorderColor = aBorderColor;
+        updateColors();
+    }
+}
+
 // ==========================================================================
 // ToolTipItem::Private
 // ==========================================================================
@@ -52,9 +259,12 @@
 class ToolTipItem::Private
 {
 public:
+    static const int ARC_SEGMENTS = 8; // per corner
+
     Private();
 
-    void paint(QPainter*, const QRectF&);
+    static void addArc(QVector<QPointF>*, const QPointF&, qreal, int);
+    QVector<QPointF> outline(const QRectF&) const;
 
 public:
     QColor iBackgroundColor;
@@ -62,6 +272,8 @@ public:
     qreal iBorderWidth;
     qreal iBottomMargin;
     qreal iRadius;
+    QSizeF iShapeSize;
+    bool iShapeChanged;
 };
 
 ToolTipItem::Private::Private() :
@@ -69,61 +281,67 @@ ToolTipItem::Private::Private() :
     iBorderColor(Qt::black),
     iBorderWidth(1),
     iBottomMargin(0),
-    iRadius(0)
+    iRadius(0),
+    iShapeChanged(true)
 {}
 
+// static
 void
-ToolTipItem::Private::paint(
-    QPainter* aPainter,
-    const QRectF& aRect)
+ToolTipItem::Private::addArc(
+    QVector<QPointF>* aPoints,
+    const QPointF& aCenter,
+    qreal aRadius,
+    int aStartAngle)
+{
+    // Quarter of a circle, counterclockwise (y axis points down)
+    if (aRadius > 0) {
+        for (int i = 0; i <= ARC_SEGMENTS; i++) {
+            const qreal a = qDegreesToRadians(aStartAngle + 90. * i / ARC_SEGMENTS);
+
+            aPoints->append(QPointF(aCenter.x() + aRadius * qCos(a),
+                aCenter.y() - aRadius * qSin(a)));
+        }
+    } else {
+        aPoints->append(aCenter);
+    }
+}
+
+QVector<QPointF>
+ToolTipItem::Private::outline(
+    const QRectF& aRect) const
 {
-    const qreal d = 2 * iRadius;
+    // Same shape as the one which used to be drawn by QPainter
+    const qreal r = iRadius;
     const qreal w2 = iBorderWidth/2;
-    const qreal dw2 = d + w2;
+    const qreal rw2 = r + w2;
     const qreal y1 = aRect.top();
     const qreal y2 = aRect.bottom() - iBottomMargin;
     const qreal x1 = aRect.left();
     const qreal x2 = aRect.right();
-    QPainterPath path;
-
-    // bottom right
-    path.moveTo(x2 - dw2, y2 - w2);
-    if (iRadius > 0) {
-        path.arcTo(QRectF(x2 - dw2, y2 - dw2, d, d), 270, 90);
-    }
+    QVector<QPointF> points;
 
-    // top right
-    path.lineTo(x2 - w2, y1 + dw2);
-    if (iRadius > 0) {
-        path.arcTo(QRectF(x2 - dw2, y1 + w2, d, d), 0, 90);
-    }
-
-    // top left
-    path.lineTo(x1 + dw2, y1 + w2);
-    if (iRadius > 0) {
-        path.arcTo(QRectF(x1 + w2, y1 + w2, d, d), 90, 90);
-    }
-
-    // bottom left
-    path.lineTo(x1 + w2, y2 - dw2);
-    if (iRadius > 0) {
-        path.arcTo(QRectF(x1 + w2, y2 - dw2, d, d), 180, 90);
-    }
+    points.reserve(4 * (ARC_SEGMENTS + 1) + 3);
+    addArc(&points, QPointF(x2 - rw2, y2 - rw2), r, 270);  // bottom right
+    addArc(&points, QPointF(x2 - rw2, y1 + rw2), r, 0);    // top right
+    addArc(&points, QPointF(x1 + rw2, y1 + rw2), r, 90);   // top left
+    addArc(&points, QPointF(x1 + rw2, y2 - rw2), r, 180);  // bottom left
 
     // bottom triangle
     if (iBottomMargin > 0) {
         const qreal x3 = (x1 + x2) / 2;
 
-        path.lineTo(x3 - iBottomMargin, y2 - w2);
-        path.lineTo(x3, aRect.bottom() - w2);
-        path.lineTo(x3 + iBottomMargin, y2 - w2);
+        points.append(QPointF(x3 - iBottomMargin, y2 - w2));
+        points.append(QPointF(x3, aRect.bottom() - w2));
+        points.append(QPointF(x3 + iBottomMargin, y2 - w2));
     }
-    path.lineTo(x2 - dw2, y2 - w2);
 
-    aPainter->setRenderHint(QPainter::Antialiasing);
-    aPainter->setBrush(QBrush(iBackgroundColor));
-    aPainter->setPen(QPen(iBorderColor, iBorderWidth));
-    aPainter->drawPath(path);
+    // Drop the duplicates, they would break the border normals
+    for (int i = points.count() - 1; i > 0 && points.count() > 1; i--) {
+        if (points.at(i) == points.at((i + 1) % points.count())) {
+            points.remove(i);
+        }
+    }
+    return points;
 }
 
 // ==========================================================================
@@ -132,9 +350,10 @@ ToolTipItem::Private::paint(
 
 ToolTipItem::ToolTipItem(
     QQuickItem* aParent) :
-    QQuickPaintedItem(aParent),
+    QQuickItem(aParent),
     iPrivate(new Private())
 {
+    setFlag(ItemHasContents);
 }
 
 ToolTipItem::~ToolTipItem()
@@ -192,6 +411,7 @@ ToolTipItem::setBorderWidth(
 {
     if (iPrivate->iBorderWidth != aWidth) {
         iPrivate->iBorderWidth = aWidth;
+        iPrivate->iShapeChanged = true;
         HDEBUG(aWidth);
         Q_EMIT borderWidthChanged();
         update();
@@ -210,6 +430,7 @@ ToolTipItem::setBottomMargin(
 {
     if (iPrivate->iBottomMargin != aMargin) {
         iPrivate->iBottomMargin = aMargin;
+        iPrivate->iShapeChanged = true;
         HDEBUG(aMargin);
         Q_EMIT bottomMarginChanged();
         update();
@@ -228,6 +449,7 @@ ToolTipItem::setRadius(
 {
     if (iPrivate->iRadius != aRadius) {
         iPrivate->iRadius = aRadius;
+        iPrivate->iShapeChanged = true;
         HDEBUG(aRadius);
         Q_EMIT radiusChanged();
         update();
@@ -235,11 +457,42 @@ ToolTipItem::setRadius(
 }
 
 void
-ToolTipItem::paint(
-    QPainter* aPainter)
+ToolTipItem::geometryChanged(
+    const QRectF& aNewGeometry,
+    const QRectF& aOldGeometry)
 {
-    HDEBUG(boundingRect());
-    aPainter->save();
-    iPrivate->paint(aPainter, boundingRect());
-    aPainter->restore();
+    QQuickItem::geometryChanged(aNewGeometry, aOldGeometry);
+    if (aNewGeometry.size() != aOldGeometry.size()) {
+        iPrivate->iShapeChanged = true;
+        update();
+    }
+}
+
+QSGNode*
+ToolTipItem::updatePaintNode(
+    QSGNode* aNode,
+    UpdatePaintNodeData*)
+{
+    Node* node = static_cast<Node*>(aNode);
+    const QRectF rect(boundingRect());
+
+    if (rect.isEmpty()) {
+        delete node;
+        return Q_NULLPTR;
+    }
+
+    if (!node) {
+        node = new Node;
+        iPrivate->iShapeChanged = true;
+    }
+
+    node->setColors(iPrivate->iBackgroundColor, iPrivate->iBorderColor);
+    if (iPrivate->iShapeChanged) {
+        iPrivate->iShapeChanged = false;
+        HDEBUG(rect);
+        node->setShape(iPrivate->outline(rect), QPointF(rect.center().x(),
+            (rect.top() + rect.bottom() - iPrivate->iBottomMargin) / 2),
+            iPrivate->iBorderWidth);
+    }
+    return node;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2025 Slava Monich <slava@monich.com>
+ * Copyright (C) 2025-2026 Slava Monich <slava@monich.com>
  *
  * You may use this file under the terms of the BSD license as follows:
  *
@@ -39,10 +39,10 @@
 #ifndef TOOLTIP_ITEM_H
 #define TOOLTIP_ITEM_H
 
-#include <QtQuick/QQuickPaintedItem>
+#include <QtQuick/QQuickItem>
 
 class ToolTipItem :
-    public QQuickPaintedItem
+    public QQuickItem
 {
     Q_OBJECT
     Q_PROPERTY(QColor backgroundColor READ backgroundColor WRITE setBackgroundColor NOTIFY backgroundColorChanged)
@@ -71,7 +71,8 @@ public:
     void setRadius(qreal);
 
 protected:
-    void paint(QPainter*) Q_DECL_OVERRIDE;
+    QSGNode* updatePaintNode(QSGNode*, UpdatePaintNodeData*) Q_DECL_OVERRIDE;
+    void geometryChanged(const QRectF&, const QRectF&) Q_DECL_OVERRIDE;
 
 Q_SIGNALS:
     void backgroundColorChanged();
@@ -81,6 +82,7 @@ Q_SIGNALS:
     void radiusChanged();
 
 private:
+    class Node;
     class Private;
     Private* iPrivate;
 };
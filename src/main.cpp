@@ -1,5 +1,5 @@
 /*
- * Copyright (C) 2025 Slava Monich <slava@monich.com>
+ * Copyright (C) 2025-2026 Slava Monich <slava@monich.com>
  *
  * You may use this file under the terms of the BSD license as follows:
  *
@@ -37,11 +37,19 @@
  */
 
 #include "BikeApp.h"
+#include "BikeAxisModel.h"
+#include "BikeExport.h"
 #include "BikeHistoryModel.h"
 #include "BikeHistoryStats.h"
+#include "BikeRecords.h"
+#include "BikeRouteStats.h"
 #include "BikeSession.h"
+#include "BikeSessionLog.h"
+#include "BikeSessionSummary.h"
+#include "BikeTrace.h"
 #include "BikeUser.h"
 #include "Fillari.h"
+#include "HistogramItem.h"
 #include "ToolTipItem.h"
 
 #include "NfcAdapter.h"
@@ -53,6 +61,7 @@
 #include <sailfishapp.h>
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QLocale>
 #include <QtCore/QScopedPointer>
 #include <QtCore/QTranslator>
@@ -67,6 +76,8 @@ registerTypes(
     int v1,
     int v2)
 {
+    BikeTrace::Span span("registerTypes");
+
     #define REGISTER_META_TYPE(Class) \
         qRegisterMetaType<Class>(#Class)
     #define REGISTER_TYPE(uri, v1, v2, Class) \
@@ -77,11 +88,19 @@ registerTypes(
     #define REGISTER_UNCREATABLE_TYPE(uri, v1, v2, Class) \
         qmlRegisterUncreatableType<Class>(uri, v1, v2, #Class, QString());
 
+    REGISTER_META_TYPE(BikeExport::Format);
     REGISTER_META_TYPE(BikeHistoryStats::Mode);
+    REGISTER_META_TYPE(BikeRecords::Record);
+    REGISTER_META_TYPE(BikeRouteStats::Type);
+    REGISTER_TYPE(uri, v1, v2, BikeAxisModel);
+    REGISTER_TYPE(uri, v1, v2, BikeExport);
     REGISTER_TYPE(uri, v1, v2, BikeHistoryModel);
     REGISTER_TYPE(uri, v1, v2, BikeHistoryStats);
+    REGISTER_TYPE(uri, v1, v2, BikeRecords);
+    REGISTER_TYPE(uri, v1, v2, BikeRouteStats);
     REGISTER_TYPE(uri, v1, v2, BikeSession);
     REGISTER_TYPE(uri, v1, v2, BikeUser);
+    REGISTER_TYPE(uri, v1, v2, HistogramItem);
     REGISTER_TYPE(uri, v1, v2, NfcMode);
     REGISTER_TYPE(uri, v1, v2, NfcParam);
     REGISTER_TYPE(uri, v1, v2, NfcTech);
@@ -89,30 +108,89 @@ registerTypes(
     REGISTER_SINGLETON_TYPE(uri, v1, v2, Fillari);
     REGISTER_SINGLETON_TYPE(uri, v1, v2, NfcAdapter);
     REGISTER_SINGLETON_TYPE(uri, v1, v2, NfcSystem);
+    REGISTER_UNCREATABLE_TYPE(uri, v1, v2, BikeHistory);
+    REGISTER_UNCREATABLE_TYPE(uri, v1, v2, BikeLatencyHistogram);
+    REGISTER_UNCREATABLE_TYPE(uri, v1, v2, BikeSessionLog);
+    REGISTER_UNCREATABLE_TYPE(uri, v1, v2, BikeSessionSummary);
+}
+
+// Set FILLARI_STARTUP_TRACE environment variable to see how long it
+// takes to show the first frame and to get the session to Ready state.
+// Those are also recorded by BikeTrace (if enabled).
+static
+void
+traceStartup(
+    QQuickView* aView,
+    const QElapsedTimer* aTimer)
+{
+    typedef QSharedPointer<QMetaObject::Connection> ConnectionPtr;
+    ConnectionPtr firstFrame(new QMetaObject::Connection);
+
+    qDebug("Startup: QML loaded in %lld ms", aTimer->elapsed());
+    *firstFrame = QObject::connect(aView, &QQuickWindow::frameSwapped,
+        [firstFrame, aTimer] () {
+            BikeTrace::instant("firstFrame");
+            qDebug("Startup: first frame in %lld ms", aTimer->elapsed());
+            QObject::disconnect(*firstFrame);
+        });
+
+    BikeSession* session = aView->rootObject() ?
+        aView->rootObject()->findChild<BikeSession*>() : Q_NULLPTR;
+    if (session) {
+        ConnectionPtr ready(new QMetaObject::Connection);
+
+        *ready = QObject::connect(session, &BikeSession::sessionStateChanged,
+            [ready, session, aTimer] () {
+                if (session->sessionState() == BikeSession::Ready) {
+                    BikeTrace::instant("ready");
+                    qDebug("Startup: Ready in %lld ms", aTimer->elapsed());
+                    QObject::disconnect(*ready);
+                }
+            });
+    }
 }
 
 int main(int argc, char *argv[])
 {
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+    BikeTrace::init();
+    BikeTrace::instant("main");
+
     QScopedPointer<QGuiApplication> app(SailfishApp::application(argc, argv));
 
     app->setApplicationName(BIKE_APP_NAME);
     registerTypes(BIKE_QML_IMPORT, 1, 0);
 
-    QLocale locale;
-    QTranslator* tr = new QTranslator(app.data());
-    const QString transDir(SailfishApp::pathTo("translations").toLocalFile());
-    const QString transFile(BIKE_APP_NAME);
-    if (tr->load(locale, transFile, "-", transDir) ||
-        tr->load(transFile, transDir)) {
-        app->installTranslator(tr);
-    } else {
-        HWARN("Failed to load translator for" << locale);
-        delete tr;
+    {
+        BikeTrace::Span span("loadTranslator");
+        QLocale locale;
+        QTranslator* tr = new QTranslator(app.data());
+        const QString transDir(SailfishApp::pathTo("translations").toLocalFile());
+        const QString transFile(BIKE_APP_NAME);
+        if (tr->load(locale, transFile, "-", transDir) ||
+            tr->load(transFile, transDir)) {
+            app->installTranslator(tr);
+        } else {
+            HWARN("Failed to load translator for" << locale);
+            delete tr;
+        }
     }
 
     QScopedPointer<QQuickView> view(SailfishApp::createView());
 
-    view->setSource(SailfishApp::pathTo("qml/main.qml"));
+    BikeTrace::instant("createView");
+    {
+        BikeTrace::Span span("loadQml");
+        view->setSource(QUrl(QStringLiteral("qrc:/qml/main.qml")));
+    }
+    if (qEnvironmentVariableIsSet("FILLARI_STARTUP_TRACE") ||
+        BikeTrace::enabled()) {
+        traceStartup(view.data(), &startupTimer);
+    }
     view->showFullScreen();
-    return app->exec();
+
+    const int ret = app->exec();
+    BikeTrace::finish();
+    return ret;
 }
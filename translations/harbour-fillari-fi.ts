@@ -3,6 +3,61 @@
 <TS version="2.1" language="fi">
 <context>
     <name></name>
+    <message id="fillari-accounts-menu-add">
+        <source>Add account</source>
+        <extracomment>Menu item</extracomment>
+        <translation>Lisää tili</translation>
+    </message>
+    <message id="fillari-accounts-header">
+        <source>Accounts</source>
+        <extracomment>Page header</extracomment>
+        <translation>Tilit</translation>
+    </message>
+    <message id="fillari-accounts-remorse-remove">
+        <source>Removing account</source>
+        <extracomment>Remorse popup text</extracomment>
+        <translation>Poistetaan tili</translation>
+    </message>
+    <message id="fillari-accounts-new">
+        <source>New account</source>
+        <extracomment>Account without a saved login</extracomment>
+        <translation>Uusi tili</translation>
+    </message>
+    <message id="fillari-accounts-menu-remove">
+        <source>Remove</source>
+        <extracomment>Context menu item</extracomment>
+        <translation>Poista</translation>
+    </message>
+    <message id="fillari-export-header">
+        <source>Export history</source>
+        <extracomment>Page header</extracomment>
+        <translation>Vie historia</translation>
+    </message>
+    <message id="fillari-export-button-csv">
+        <source>CSV</source>
+        <extracomment>Button label</extracomment>
+        <translation>CSV</translation>
+    </message>
+    <message id="fillari-export-button-jsonl">
+        <source>JSON Lines</source>
+        <extracomment>Button label</extracomment>
+        <translation>JSON Lines</translation>
+    </message>
+    <message id="fillari-export-button-cancel">
+        <source>Cancel</source>
+        <extracomment>Button label</extracomment>
+        <translation>Peruuta</translation>
+    </message>
+    <message id="fillari-export-info-failed">
+        <source>Export failed</source>
+        <extracomment>Info label</extracomment>
+        <translation>Vienti epäonnistui</translation>
+    </message>
+    <message id="fillari-export-info-saved">
+        <source>Saved %1</source>
+        <extracomment>Info label, %1 is the file name</extracomment>
+        <translation>Tallennettu %1</translation>
+    </message>
     <message id="fillari-login_error-message">
         <source>Sorry, cannot connect to the HSL service right now. Please try again later.</source>
         <extracomment>Full screen error message</extracomment>
@@ -18,6 +73,16 @@
         <extracomment>Menu item</extracomment>
         <translation>Kirjaudu ulos</translation>
     </message>
+    <message id="fillari-menu-accounts">
+        <source>Accounts</source>
+        <extracomment>Menu item</extracomment>
+        <translation>Tilit</translation>
+    </message>
+    <message id="fillari-menu-export">
+        <source>Export</source>
+        <extracomment>Menu item</extracomment>
+        <translation>Vie</translation>
+    </message>
     <message id="fillari-menu-pick_up">
         <source>Pick up</source>
         <extracomment>Menu item</extracomment>
@@ -48,6 +113,11 @@
         <extracomment>Button label</extracomment>
         <translation>Aika</translation>
     </message>
+    <message id="fillari-graph-per_week_header">
+        <source>Per week</source>
+        <extracomment>Graph header</extracomment>
+        <translation>Viikoittain</translation>
+    </message>
     <message id="fillari-graph-per_month_header">
         <source>Per month</source>
         <extracomment>Graph header</extracomment>
@@ -68,6 +138,41 @@
         <extracomment>Combo box label (season year)</extracomment>
         <translation>Ajokausi</translation>
     </message>
+    <message id="fillari-history-order-label">
+        <source>Sort by</source>
+        <extracomment>Combo box label</extracomment>
+        <translation>Järjestys</translation>
+    </message>
+    <message id="fillari-history-order-newest">
+        <source>Date</source>
+        <extracomment>Combo box value (sort order)</extracomment>
+        <translation>Päivämäärä</translation>
+    </message>
+    <message id="fillari-history-order-distance">
+        <source>Distance</source>
+        <extracomment>Combo box value (sort order)</extracomment>
+        <translation>Matka</translation>
+    </message>
+    <message id="fillari-history-order-duration">
+        <source>Duration</source>
+        <extracomment>Combo box value (sort order)</extracomment>
+        <translation>Kesto</translation>
+    </message>
+    <message id="fillari-history-order-speed">
+        <source>Speed</source>
+        <extracomment>Combo box value (sort order)</extracomment>
+        <translation>Nopeus</translation>
+    </message>
+    <message id="fillari-history-order-station">
+        <source>Station</source>
+        <extracomment>Combo box value (sort order)</extracomment>
+        <translation>Asema</translation>
+    </message>
+    <message id="fillari-history-search-placeholder">
+        <source>Station, bike, month or year</source>
+        <extracomment>Search field placeholder</extracomment>
+        <translation>Asema, pyörä, kuukausi tai vuosi</translation>
+    </message>
     <message id="fillari-login-info_label">
         <source>Log in</source>
         <extracomment>Login info label</extracomment>
@@ -168,5 +273,61 @@
         <extracomment>Label</extracomment>
         <translation>Käyttöoikeutesi on voimassa %1 asti</translation>
     </message>
+    <message id="fillari-main-section-records">
+        <source>Records</source>
+        <extracomment>Section header</extracomment>
+        <translation>Ennätykset</translation>
+    </message>
+    <message id="fillari-main-records-period">
+        <source>Period</source>
+        <extracomment>Combo box label (period of time for the records)</extracomment>
+        <translation>Ajanjakso</translation>
+    </message>
+    <message id="fillari-main-records-all_time">
+        <source>All time</source>
+        <extracomment>Combo box value (period of time for the records)</extracomment>
+        <translation>Kaikki ajat</translation>
+    </message>
+    <message id="fillari-records-longest_ride">
+        <source>Longest ride</source>
+        <extracomment>Record title</extracomment>
+        <translation>Pisin matka</translation>
+    </message>
+    <message id="fillari-records-fastest_ride">
+        <source>Fastest ride</source>
+        <extracomment>Record title</extracomment>
+        <translation>Nopein matka</translation>
+    </message>
+    <message id="fillari-records-longest_streak">
+        <source>Longest streak</source>
+        <extracomment>Record title (consecutive days with rides)</extracomment>
+        <translation>Pisin putki</translation>
+    </message>
+    <message id="fillari-records-busiest_day">
+        <source>Most rides in a day</source>
+        <extracomment>Record title</extracomment>
+        <translation>Eniten matkoja päivässä</translation>
+    </message>
+    <message id="fillari-records-value-speed">
+        <source>%1 km/h</source>
+        <extracomment>Average speed of the ride</extracomment>
+        <translation>%1 km/h</translation>
+    </message>
+    <message id="fillari-records-value-days" numerus="yes">
+        <source>%n day(s)</source>
+        <extracomment>Length of the streak</extracomment>
+        <translation>
+            <numerusform>%n päivä</numerusform>
+            <numerusform>%n päivää</numerusform>
+        </translation>
+    </message>
+    <message id="fillari-records-value-rides" numerus="yes">
+        <source>%n ride(s)</source>
+        <extracomment>Number of rides in a day</extracomment>
+        <translation>
+            <numerusform>%n matka</numerusform>
+            <numerusform>%n matkaa</numerusform>
+        </translation>
+    </message>
 </context>
 </TS>